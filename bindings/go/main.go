@@ -10,6 +10,9 @@ import (
 	"encoding/hex"
 	"errors"
 	"fmt"
+	"runtime"
+	"sync"
+	"sync/atomic"
 	"unsafe"
 
 	// So its functions are available during compilation.
@@ -37,11 +40,12 @@ type (
 )
 
 var (
-	loaded     = false
-	settings   = C.KZGSettings{}
-	ErrBadArgs = errors.New("bad arguments")
-	ErrError   = errors.New("unexpected error")
-	ErrMalloc  = errors.New("malloc failed")
+	defaultContext = Context{}
+	ErrBadArgs     = errors.New("bad arguments")
+	ErrError       = errors.New("unexpected error")
+	ErrMalloc      = errors.New("malloc failed")
+
+	errOpenTrustedSetup = errors.New("error reading trusted setup")
 )
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -139,6 +143,10 @@ func (c *Cell) UnmarshalText(input []byte) error {
 // Interface Functions
 ///////////////////////////////////////////////////////////////////////////////
 
+// The functions below use the package's default trusted setup, which is
+// loaded with LoadTrustedSetup or LoadTrustedSetupFile. They panic if it has
+// not been loaded. Use a Context to have more than one trusted setup loaded.
+
 /*
 LoadTrustedSetup is the binding for:
 
@@ -153,11 +161,150 @@ LoadTrustedSetup is the binding for:
 	    uint64_t precompute);
 */
 func LoadTrustedSetup(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes []byte, precompute uint) error {
-	if loaded {
+	if defaultContext.loaded {
 		panic("trusted setup is already loaded")
 	}
+	return defaultContext.loadTrustedSetup(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes, precompute)
+}
+
+/*
+LoadTrustedSetupFile is the binding for:
+
+	C_KZG_RET load_trusted_setup_file(
+	    KZGSettings *out,
+	    FILE *in,
+	    uint64_t precompute);
+*/
+func LoadTrustedSetupFile(trustedSetupFile string, precompute uint) error {
+	if defaultContext.loaded {
+		panic("trusted setup is already loaded")
+	}
+	err := defaultContext.loadTrustedSetupFile(trustedSetupFile, precompute)
+	if err == errOpenTrustedSetup {
+		panic(err.Error())
+	}
+	return err
+}
+
+/*
+FreeTrustedSetup is the binding for:
+
+	void free_trusted_setup(
+	    KZGSettings *s);
+*/
+func FreeTrustedSetup() {
+	defaultContext.Free()
+}
+
+// BlobToKZGCommitment is Context.BlobToKZGCommitment with the default trusted setup.
+func BlobToKZGCommitment(blob *Blob) (KZGCommitment, error) {
+	return defaultContext.BlobToKZGCommitment(blob)
+}
+
+// ComputeKZGProof is Context.ComputeKZGProof with the default trusted setup.
+func ComputeKZGProof(blob *Blob, zBytes Bytes32) (KZGProof, Bytes32, error) {
+	return defaultContext.ComputeKZGProof(blob, zBytes)
+}
+
+// ComputeBlobKZGProof is Context.ComputeBlobKZGProof with the default trusted setup.
+func ComputeBlobKZGProof(blob *Blob, commitmentBytes Bytes48) (KZGProof, error) {
+	return defaultContext.ComputeBlobKZGProof(blob, commitmentBytes)
+}
+
+// VerifyKZGProof is Context.VerifyKZGProof with the default trusted setup.
+func VerifyKZGProof(commitmentBytes Bytes48, zBytes, yBytes Bytes32, proofBytes Bytes48) (bool, error) {
+	return defaultContext.VerifyKZGProof(commitmentBytes, zBytes, yBytes, proofBytes)
+}
+
+// VerifyBlobKZGProof is Context.VerifyBlobKZGProof with the default trusted setup.
+func VerifyBlobKZGProof(blob *Blob, commitmentBytes, proofBytes Bytes48) (bool, error) {
+	return defaultContext.VerifyBlobKZGProof(blob, commitmentBytes, proofBytes)
+}
+
+// VerifyBlobKZGProofBatch is Context.VerifyBlobKZGProofBatch with the default trusted setup.
+func VerifyBlobKZGProofBatch(blobs []Blob, commitmentsBytes, proofsBytes []Bytes48) (bool, error) {
+	return defaultContext.VerifyBlobKZGProofBatch(blobs, commitmentsBytes, proofsBytes)
+}
+
+// VerifyBlobKZGProofBatchParallel is Context.VerifyBlobKZGProofBatchParallel with the default
+// trusted setup.
+func VerifyBlobKZGProofBatchParallel(blobs []Blob, commitmentsBytes, proofsBytes []Bytes48) (bool, error) {
+	return defaultContext.VerifyBlobKZGProofBatchParallel(blobs, commitmentsBytes, proofsBytes)
+}
+
+// ComputeCellsAndKZGProofs is Context.ComputeCellsAndKZGProofs with the default trusted setup.
+func ComputeCellsAndKZGProofs(blob *Blob) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
+	return defaultContext.ComputeCellsAndKZGProofs(blob)
+}
+
+// ComputeCellsAndKZGProofsInto is Context.ComputeCellsAndKZGProofsInto with the default trusted
+// setup.
+func ComputeCellsAndKZGProofsInto(blob *Blob, cells []Cell, proofs []KZGProof) error {
+	return defaultContext.ComputeCellsAndKZGProofsInto(blob, cells, proofs)
+}
+
+// ComputeCellsAndKZGProofsBatch is Context.ComputeCellsAndKZGProofsBatch with the default trusted
+// setup.
+func ComputeCellsAndKZGProofsBatch(blobs []Blob, cells []Cell, proofs []KZGProof) error {
+	return defaultContext.ComputeCellsAndKZGProofsBatch(blobs, cells, proofs)
+}
+
+// RecoverCellsAndKZGProofs is Context.RecoverCellsAndKZGProofs with the default trusted setup.
+func RecoverCellsAndKZGProofs(cellIndices []uint64, cells []Cell) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
+	return defaultContext.RecoverCellsAndKZGProofs(cellIndices, cells)
+}
+
+// RecoverCellsAndKZGProofsInto is Context.RecoverCellsAndKZGProofsInto with the default trusted
+// setup.
+func RecoverCellsAndKZGProofsInto(cellIndices []uint64, cells []Cell, recoveredCells []Cell, recoveredProofs []KZGProof) error {
+	return defaultContext.RecoverCellsAndKZGProofsInto(cellIndices, cells, recoveredCells, recoveredProofs)
+}
+
+// VerifyCellKZGProofBatch is Context.VerifyCellKZGProofBatch with the default trusted setup.
+func VerifyCellKZGProofBatch(commitmentsBytes []Bytes48, cellIndices []uint64, cells []Cell, proofsBytes []Bytes48) (bool, error) {
+	return defaultContext.VerifyCellKZGProofBatch(commitmentsBytes, cellIndices, cells, proofsBytes)
+}
+
+// VerifyCellKZGProofBatchParallel is Context.VerifyCellKZGProofBatchParallel with the default
+// trusted setup.
+func VerifyCellKZGProofBatchParallel(commitmentsBytes []Bytes48, cellIndices []uint64, cells []Cell, proofsBytes []Bytes48) (bool, error) {
+	return defaultContext.VerifyCellKZGProofBatchParallel(commitmentsBytes, cellIndices, cells, proofsBytes)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Context Functions
+///////////////////////////////////////////////////////////////////////////////
+
+// Context owns a trusted setup. Any number of contexts can be loaded at the
+// same time, for example with different precompute values. Once loaded, a
+// Context is safe for concurrent use until it is freed.
+type Context struct {
+	settings C.KZGSettings
+	loaded   bool
+}
+
+// NewContext loads a trusted setup into a new Context. See LoadTrustedSetup.
+func NewContext(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes []byte, precompute uint) (*Context, error) {
+	ctx := &Context{}
+	if err := ctx.loadTrustedSetup(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes, precompute); err != nil {
+		return nil, err
+	}
+	return ctx, nil
+}
+
+// NewContextFromFile loads a trusted setup file into a new Context. See
+// LoadTrustedSetupFile.
+func NewContextFromFile(trustedSetupFile string, precompute uint) (*Context, error) {
+	ctx := &Context{}
+	if err := ctx.loadTrustedSetupFile(trustedSetupFile, precompute); err != nil {
+		return nil, err
+	}
+	return ctx, nil
+}
+
+func (ctx *Context) loadTrustedSetup(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes []byte, precompute uint) error {
 	ret := C.load_trusted_setup(
-		&settings,
+		&ctx.settings,
 		*(**C.uint8_t)(unsafe.Pointer(&g1MonomialBytes)),
 		(C.uint64_t)(len(g1MonomialBytes)),
 		*(**C.uint8_t)(unsafe.Pointer(&g1LagrangeBytes)),
@@ -166,53 +313,37 @@ func LoadTrustedSetup(g1MonomialBytes, g1LagrangeBytes, g2MonomialBytes []byte,
 		(C.uint64_t)(len(g2MonomialBytes)),
 		(C.uint64_t)(precompute))
 	if ret == C.C_KZG_OK {
-		loaded = true
+		ctx.loaded = true
 		return nil
 	}
 	return makeErrorFromRet(ret)
 }
 
-/*
-LoadTrustedSetupFile is the binding for:
-
-	C_KZG_RET load_trusted_setup_file(
-	    KZGSettings *out,
-	    FILE *in,
-	    uint64_t precompute);
-*/
-func LoadTrustedSetupFile(trustedSetupFile string, precompute uint) error {
-	if loaded {
-		panic("trusted setup is already loaded")
-	}
+func (ctx *Context) loadTrustedSetupFile(trustedSetupFile string, precompute uint) error {
 	cTrustedSetupFile := C.CString(trustedSetupFile)
 	defer C.free(unsafe.Pointer(cTrustedSetupFile))
 	cMode := C.CString("r")
 	defer C.free(unsafe.Pointer(cMode))
 	fp := C.fopen(cTrustedSetupFile, cMode)
 	if fp == nil {
-		panic("error reading trusted setup")
+		return errOpenTrustedSetup
 	}
-	ret := C.load_trusted_setup_file(&settings, fp, (C.uint64_t)(precompute))
+	ret := C.load_trusted_setup_file(&ctx.settings, fp, (C.uint64_t)(precompute))
 	C.fclose(fp)
 	if ret == C.C_KZG_OK {
-		loaded = true
+		ctx.loaded = true
 		return nil
 	}
 	return makeErrorFromRet(ret)
 }
 
-/*
-FreeTrustedSetup is the binding for:
-
-	void free_trusted_setup(
-	    KZGSettings *s);
-*/
-func FreeTrustedSetup() {
-	if !loaded {
+// Free releases the trusted setup. The Context must not be used afterwards.
+func (ctx *Context) Free() {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
-	C.free_trusted_setup(&settings)
-	loaded = false
+	C.free_trusted_setup(&ctx.settings)
+	ctx.loaded = false
 }
 
 /*
@@ -223,8 +354,8 @@ BlobToKZGCommitment is the binding for:
 	    const Blob *blob,
 	    const KZGSettings *s);
 */
-func BlobToKZGCommitment(blob *Blob) (KZGCommitment, error) {
-	if !loaded {
+func (ctx *Context) BlobToKZGCommitment(blob *Blob) (KZGCommitment, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if blob == nil {
@@ -235,7 +366,7 @@ func BlobToKZGCommitment(blob *Blob) (KZGCommitment, error) {
 	ret := C.blob_to_kzg_commitment(
 		(*C.KZGCommitment)(unsafe.Pointer(&commitment)),
 		(*C.Blob)(unsafe.Pointer(blob)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return KZGCommitment{}, makeErrorFromRet(ret)
@@ -253,8 +384,8 @@ ComputeKZGProof is the binding for:
 	    const Bytes32 *z_bytes,
 	    const KZGSettings *s);
 */
-func ComputeKZGProof(blob *Blob, zBytes Bytes32) (KZGProof, Bytes32, error) {
-	if !loaded {
+func (ctx *Context) ComputeKZGProof(blob *Blob, zBytes Bytes32) (KZGProof, Bytes32, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if blob == nil {
@@ -267,7 +398,7 @@ func ComputeKZGProof(blob *Blob, zBytes Bytes32) (KZGProof, Bytes32, error) {
 		(*C.Bytes32)(unsafe.Pointer(&y)),
 		(*C.Blob)(unsafe.Pointer(blob)),
 		(*C.Bytes32)(unsafe.Pointer(&zBytes)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return KZGProof{}, Bytes32{}, makeErrorFromRet(ret)
@@ -284,8 +415,8 @@ ComputeBlobKZGProof is the binding for:
 	    const Bytes48 *commitment_bytes,
 	    const KZGSettings *s);
 */
-func ComputeBlobKZGProof(blob *Blob, commitmentBytes Bytes48) (KZGProof, error) {
-	if !loaded {
+func (ctx *Context) ComputeBlobKZGProof(blob *Blob, commitmentBytes Bytes48) (KZGProof, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if blob == nil {
@@ -296,7 +427,7 @@ func ComputeBlobKZGProof(blob *Blob, commitmentBytes Bytes48) (KZGProof, error)
 		(*C.KZGProof)(unsafe.Pointer(&proof)),
 		(*C.Blob)(unsafe.Pointer(blob)),
 		(*C.Bytes48)(unsafe.Pointer(&commitmentBytes)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return KZGProof{}, makeErrorFromRet(ret)
@@ -315,8 +446,8 @@ VerifyKZGProof is the binding for:
 	    const Bytes48 *proof_bytes,
 	    const KZGSettings *s);
 */
-func VerifyKZGProof(commitmentBytes Bytes48, zBytes, yBytes Bytes32, proofBytes Bytes48) (bool, error) {
-	if !loaded {
+func (ctx *Context) VerifyKZGProof(commitmentBytes Bytes48, zBytes, yBytes Bytes32, proofBytes Bytes48) (bool, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	var result C.bool
@@ -326,7 +457,7 @@ func VerifyKZGProof(commitmentBytes Bytes48, zBytes, yBytes Bytes32, proofBytes
 		(*C.Bytes32)(unsafe.Pointer(&zBytes)),
 		(*C.Bytes32)(unsafe.Pointer(&yBytes)),
 		(*C.Bytes48)(unsafe.Pointer(&proofBytes)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return false, makeErrorFromRet(ret)
@@ -344,8 +475,8 @@ VerifyBlobKZGProof is the binding for:
 	    const Bytes48 *proof_bytes,
 	    const KZGSettings *s);
 */
-func VerifyBlobKZGProof(blob *Blob, commitmentBytes, proofBytes Bytes48) (bool, error) {
-	if !loaded {
+func (ctx *Context) VerifyBlobKZGProof(blob *Blob, commitmentBytes, proofBytes Bytes48) (bool, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if blob == nil {
@@ -358,7 +489,7 @@ func VerifyBlobKZGProof(blob *Blob, commitmentBytes, proofBytes Bytes48) (bool,
 		(*C.Blob)(unsafe.Pointer(blob)),
 		(*C.Bytes48)(unsafe.Pointer(&commitmentBytes)),
 		(*C.Bytes48)(unsafe.Pointer(&proofBytes)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return false, makeErrorFromRet(ret)
@@ -376,8 +507,8 @@ VerifyBlobKZGProofBatch is the binding for:
 	    const Bytes48 *proofs_bytes,
 	    const KZGSettings *s);
 */
-func VerifyBlobKZGProofBatch(blobs []Blob, commitmentsBytes, proofsBytes []Bytes48) (bool, error) {
-	if !loaded {
+func (ctx *Context) VerifyBlobKZGProofBatch(blobs []Blob, commitmentsBytes, proofsBytes []Bytes48) (bool, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if len(blobs) != len(commitmentsBytes) || len(blobs) != len(proofsBytes) {
@@ -391,7 +522,7 @@ func VerifyBlobKZGProofBatch(blobs []Blob, commitmentsBytes, proofsBytes []Bytes
 		*(**C.Bytes48)(unsafe.Pointer(&commitmentsBytes)),
 		*(**C.Bytes48)(unsafe.Pointer(&proofsBytes)),
 		(C.uint64_t)(len(blobs)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return false, makeErrorFromRet(ret)
@@ -399,36 +530,62 @@ func VerifyBlobKZGProofBatch(blobs []Blob, commitmentsBytes, proofsBytes []Bytes
 	return bool(result), nil
 }
 
+// ComputeCellsAndKZGProofs is like ComputeCellsAndKZGProofsInto, but returns
+// the cells and proofs by value.
+func (ctx *Context) ComputeCellsAndKZGProofs(blob *Blob) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
+	cells := [CellsPerExtBlob]Cell{}
+	proofs := [CellsPerExtBlob]KZGProof{}
+	if err := ctx.ComputeCellsAndKZGProofsInto(blob, cells[:], proofs[:]); err != nil {
+		return [CellsPerExtBlob]Cell{}, [CellsPerExtBlob]KZGProof{}, err
+	}
+	return cells, proofs, nil
+}
+
 /*
-ComputeCellsAndKZGProofs is the binding for:
+ComputeCellsAndKZGProofsInto is the binding for:
 
 	C_KZG_RET compute_cells_and_kzg_proofs(
 	    Cell *cells,
 	    KZGProof *proofs,
 	    const Blob *blob,
 	    const KZGSettings *s);
+
+The cells and proofs are written in place, so both slices must have a length
+of CellsPerExtBlob.
 */
-func ComputeCellsAndKZGProofs(blob *Blob) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
-	if !loaded {
+func (ctx *Context) ComputeCellsAndKZGProofsInto(blob *Blob, cells []Cell, proofs []KZGProof) error {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
+	if blob == nil || len(cells) != CellsPerExtBlob || len(proofs) != CellsPerExtBlob {
+		return ErrBadArgs
+	}
 
-	cells := [CellsPerExtBlob]Cell{}
-	proofs := [CellsPerExtBlob]KZGProof{}
 	ret := C.compute_cells_and_kzg_proofs(
-		(*C.Cell)(unsafe.Pointer(&cells)),
-		(*C.KZGProof)(unsafe.Pointer(&proofs)),
+		*(**C.Cell)(unsafe.Pointer(&cells)),
+		*(**C.KZGProof)(unsafe.Pointer(&proofs)),
 		(*C.Blob)(unsafe.Pointer(blob)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
-		return [CellsPerExtBlob]Cell{}, [CellsPerExtBlob]KZGProof{}, makeErrorFromRet(ret)
+		return makeErrorFromRet(ret)
 	}
-	return cells, proofs, nil
+	return nil
+}
+
+// RecoverCellsAndKZGProofs is like RecoverCellsAndKZGProofsInto, but returns
+// the recovered cells and proofs by value.
+func (ctx *Context) RecoverCellsAndKZGProofs(cellIndices []uint64, cells []Cell) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
+	recoveredCells := [CellsPerExtBlob]Cell{}
+	recoveredProofs := [CellsPerExtBlob]KZGProof{}
+	if err := ctx.RecoverCellsAndKZGProofsInto(cellIndices, cells, recoveredCells[:], recoveredProofs[:]); err != nil {
+		return [CellsPerExtBlob]Cell{}, [CellsPerExtBlob]KZGProof{}, err
+	}
+	return recoveredCells, recoveredProofs, nil
 }
 
 /*
-RecoverCellsAndKZGProofs is the binding for:
+RecoverCellsAndKZGProofsInto is the binding for:
 
 	C_KZG_RET recover_cells_and_kzg_proofs(
 	    Cell *recovered_cells,
@@ -437,29 +594,33 @@ RecoverCellsAndKZGProofs is the binding for:
 	    const Cell *cells,
 	    uint64_t num_cells,
 	    const KZGSettings *s);
+
+The recovered cells and proofs are written in place, so both slices must have a
+length of CellsPerExtBlob.
 */
-func RecoverCellsAndKZGProofs(cellIndices []uint64, cells []Cell) ([CellsPerExtBlob]Cell, [CellsPerExtBlob]KZGProof, error) {
-	if !loaded {
+func (ctx *Context) RecoverCellsAndKZGProofsInto(cellIndices []uint64, cells []Cell, recoveredCells []Cell, recoveredProofs []KZGProof) error {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if len(cellIndices) != len(cells) {
-		return [CellsPerExtBlob]Cell{}, [CellsPerExtBlob]KZGProof{}, ErrBadArgs
+		return ErrBadArgs
+	}
+	if len(recoveredCells) != CellsPerExtBlob || len(recoveredProofs) != CellsPerExtBlob {
+		return ErrBadArgs
 	}
 
-	recoveredCells := [CellsPerExtBlob]Cell{}
-	recoveredProofs := [CellsPerExtBlob]KZGProof{}
 	ret := C.recover_cells_and_kzg_proofs(
-		(*C.Cell)(unsafe.Pointer(&recoveredCells)),
-		(*C.KZGProof)(unsafe.Pointer(&recoveredProofs)),
+		*(**C.Cell)(unsafe.Pointer(&recoveredCells)),
+		*(**C.KZGProof)(unsafe.Pointer(&recoveredProofs)),
 		*(**C.uint64_t)(unsafe.Pointer(&cellIndices)),
 		*(**C.Cell)(unsafe.Pointer(&cells)),
 		(C.uint64_t)(len(cells)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
-		return [CellsPerExtBlob]Cell{}, [CellsPerExtBlob]KZGProof{}, makeErrorFromRet(ret)
+		return makeErrorFromRet(ret)
 	}
-	return recoveredCells, recoveredProofs, nil
+	return nil
 }
 
 /*
@@ -474,8 +635,8 @@ VerifyCellKZGProofBatch is the binding for:
 	    uint64_t num_cells,
 	    const KZGSettings *s);
 */
-func VerifyCellKZGProofBatch(commitmentsBytes []Bytes48, cellIndices []uint64, cells []Cell, proofsBytes []Bytes48) (bool, error) {
-	if !loaded {
+func (ctx *Context) VerifyCellKZGProofBatch(commitmentsBytes []Bytes48, cellIndices []uint64, cells []Cell, proofsBytes []Bytes48) (bool, error) {
+	if !ctx.loaded {
 		panic("trusted setup isn't loaded")
 	}
 	if len(commitmentsBytes) != len(cells) || len(cellIndices) != len(cells) || len(proofsBytes) != len(cells) {
@@ -490,10 +651,126 @@ func VerifyCellKZGProofBatch(commitmentsBytes []Bytes48, cellIndices []uint64, c
 		*(**C.Cell)(unsafe.Pointer(&cells)),
 		*(**C.Bytes48)(unsafe.Pointer(&proofsBytes)),
 		(C.uint64_t)(len(cells)),
-		&settings)
+		&ctx.settings)
 
 	if ret != C.C_KZG_OK {
 		return false, makeErrorFromRet(ret)
 	}
 	return bool(result), nil
 }
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel Batch Functions
+///////////////////////////////////////////////////////////////////////////////
+
+// The functions below split a batch into contiguous shards and hand each shard
+// to the C batch function on its own goroutine, using up to GOMAXPROCS
+// goroutines. A verification is valid if every shard is valid. Each shard is
+// still a single batch check, so this trades some extra pairings for latency.
+
+// minCellsPerShard keeps cell shards large enough that their pairing check is
+// not the dominant cost.
+const minCellsPerShard = CellsPerExtBlob
+
+// shard calls fn concurrently on contiguous ranges of [0, n) with at least
+// minSize items each, and returns the first error.
+func shard(n, minSize int, fn func(start, end int) error) error {
+	shards := runtime.GOMAXPROCS(0)
+	if maxShards := (n + minSize - 1) / minSize; shards > maxShards {
+		shards = maxShards
+	}
+	if shards <= 1 {
+		return fn(0, n)
+	}
+
+	errs := make([]error, shards)
+	var wg sync.WaitGroup
+	for i := 0; i < shards; i++ {
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			errs[i] = fn(i*n/shards, (i+1)*n/shards)
+		}(i)
+	}
+	wg.Wait()
+	for _, err := range errs {
+		if err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// VerifyBlobKZGProofBatchParallel has the same result as
+// VerifyBlobKZGProofBatch, but spreads the batch over several goroutines.
+func (ctx *Context) VerifyBlobKZGProofBatchParallel(blobs []Blob, commitmentsBytes, proofsBytes []Bytes48) (bool, error) {
+	if !ctx.loaded {
+		panic("trusted setup isn't loaded")
+	}
+	if len(blobs) != len(commitmentsBytes) || len(blobs) != len(proofsBytes) {
+		return false, ErrBadArgs
+	}
+
+	var invalid atomic.Bool
+	err := shard(len(blobs), 1, func(start, end int) error {
+		ok, err := ctx.VerifyBlobKZGProofBatch(blobs[start:end], commitmentsBytes[start:end], proofsBytes[start:end])
+		if !ok {
+			invalid.Store(true)
+		}
+		return err
+	})
+	if err != nil {
+		return false, err
+	}
+	return !invalid.Load(), nil
+}
+
+// ComputeCellsAndKZGProofsBatch computes the cells and proofs of several blobs
+// on several goroutines. Those of blobs[i] are written in place to
+// cells[i*CellsPerExtBlob:] and proofs[i*CellsPerExtBlob:], so both slices must
+// have a length of len(blobs)*CellsPerExtBlob.
+func (ctx *Context) ComputeCellsAndKZGProofsBatch(blobs []Blob, cells []Cell, proofs []KZGProof) error {
+	if !ctx.loaded {
+		panic("trusted setup isn't loaded")
+	}
+	if len(cells) != len(blobs)*CellsPerExtBlob || len(proofs) != len(blobs)*CellsPerExtBlob {
+		return ErrBadArgs
+	}
+
+	return shard(len(blobs), 1, func(start, end int) error {
+		for i := start; i < end; i++ {
+			offset := i * CellsPerExtBlob
+			err := ctx.ComputeCellsAndKZGProofsInto(&blobs[i],
+				cells[offset:offset+CellsPerExtBlob], proofs[offset:offset+CellsPerExtBlob])
+			if err != nil {
+				return err
+			}
+		}
+		return nil
+	})
+}
+
+// VerifyCellKZGProofBatchParallel has the same result as
+// VerifyCellKZGProofBatch, but spreads the batch over several goroutines.
+func (ctx *Context) VerifyCellKZGProofBatchParallel(commitmentsBytes []Bytes48, cellIndices []uint64, cells []Cell, proofsBytes []Bytes48) (bool, error) {
+	if !ctx.loaded {
+		panic("trusted setup isn't loaded")
+	}
+	if len(commitmentsBytes) != len(cells) || len(cellIndices) != len(cells) || len(proofsBytes) != len(cells) {
+		return false, ErrBadArgs
+	}
+
+	var invalid atomic.Bool
+	err := shard(len(cells), minCellsPerShard, func(start, end int) error {
+		ok, err := ctx.VerifyCellKZGProofBatch(commitmentsBytes[start:end], cellIndices[start:end],
+			cells[start:end], proofsBytes[start:end])
+		if !ok {
+			invalid.Store(true)
+		}
+		return err
+	})
+	if err != nil {
+		return false, err
+	}
+	return !invalid.Load(), nil
+}
@@ -630,6 +630,120 @@ func TestPartialRecover(t *testing.T) {
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Context and Parallel Tests
+///////////////////////////////////////////////////////////////////////////////
+
+func TestContext(t *testing.T) {
+	ctx0, err := NewContextFromFile("../../src/trusted_setup.txt", 0)
+	require.NoError(t, err)
+	defer ctx0.Free()
+	ctx2, err := NewContextFromFile("../../src/trusted_setup.txt", 2)
+	require.NoError(t, err)
+	defer ctx2.Free()
+
+	_, err = NewContextFromFile("does_not_exist.txt", 0)
+	require.Error(t, err)
+
+	var blob Blob
+	fillBlobRandom(&blob, 11)
+	commitment, err := BlobToKZGCommitment(&blob)
+	require.NoError(t, err)
+	for _, ctx := range []*Context{ctx0, ctx2} {
+		ctxCommitment, err := ctx.BlobToKZGCommitment(&blob)
+		require.NoError(t, err)
+		require.Equal(t, commitment, ctxCommitment)
+	}
+
+	cells, proofs, err := ComputeCellsAndKZGProofs(&blob)
+	require.NoError(t, err)
+	ctxCells := make([]Cell, CellsPerExtBlob)
+	ctxProofs := make([]KZGProof, CellsPerExtBlob)
+	require.NoError(t, ctx2.ComputeCellsAndKZGProofsInto(&blob, ctxCells, ctxProofs))
+	require.EqualValues(t, cells[:], ctxCells)
+	require.EqualValues(t, proofs[:], ctxProofs)
+	require.ErrorIs(t, ctx2.ComputeCellsAndKZGProofsInto(&blob, ctxCells[1:], ctxProofs), ErrBadArgs)
+}
+
+func TestComputeCellsAndKZGProofsBatch(t *testing.T) {
+	const count = 5
+	blobs := make([]Blob, count)
+	for i := range blobs {
+		fillBlobRandom(&blobs[i], int64(i))
+	}
+	cells := make([]Cell, count*CellsPerExtBlob)
+	proofs := make([]KZGProof, count*CellsPerExtBlob)
+	require.NoError(t, ComputeCellsAndKZGProofsBatch(blobs, cells, proofs))
+	for i := range blobs {
+		blobCells, blobProofs, err := ComputeCellsAndKZGProofs(&blobs[i])
+		require.NoError(t, err)
+		require.EqualValues(t, blobCells[:], cells[i*CellsPerExtBlob:(i+1)*CellsPerExtBlob])
+		require.EqualValues(t, blobProofs[:], proofs[i*CellsPerExtBlob:(i+1)*CellsPerExtBlob])
+	}
+	require.ErrorIs(t, ComputeCellsAndKZGProofsBatch(blobs[1:], cells, proofs), ErrBadArgs)
+}
+
+func TestVerifyBlobKZGProofBatchParallel(t *testing.T) {
+	const count = 5
+	blobs := make([]Blob, count)
+	commitments := make([]Bytes48, count)
+	proofs := make([]Bytes48, count)
+	for i := range blobs {
+		fillBlobRandom(&blobs[i], int64(i))
+		commitment, err := BlobToKZGCommitment(&blobs[i])
+		require.NoError(t, err)
+		commitments[i] = Bytes48(commitment)
+		proof, err := ComputeBlobKZGProof(&blobs[i], commitments[i])
+		require.NoError(t, err)
+		proofs[i] = Bytes48(proof)
+	}
+
+	ok, err := VerifyBlobKZGProofBatchParallel(blobs, commitments, proofs)
+	require.NoError(t, err)
+	require.True(t, ok)
+
+	proofs[3], proofs[4] = proofs[4], proofs[3]
+	ok, err = VerifyBlobKZGProofBatchParallel(blobs, commitments, proofs)
+	require.NoError(t, err)
+	require.False(t, ok)
+
+	_, err = VerifyBlobKZGProofBatchParallel(blobs, commitments[1:], proofs)
+	require.ErrorIs(t, err, ErrBadArgs)
+}
+
+func TestVerifyCellKZGProofBatchParallel(t *testing.T) {
+	const count = 4
+	var commitments []Bytes48
+	var cellRows [][CellsPerExtBlob]Cell
+	var proofRows [][CellsPerExtBlob]Bytes48
+	for i := 0; i < count; i++ {
+		var blob Blob
+		fillBlobRandom(&blob, int64(i))
+		commitment, err := BlobToKZGCommitment(&blob)
+		require.NoError(t, err)
+		commitments = append(commitments, Bytes48(commitment))
+		cells, proofs, err := ComputeCellsAndKZGProofs(&blob)
+		require.NoError(t, err)
+		var proofsBytes [CellsPerExtBlob]Bytes48
+		for j, proof := range proofs {
+			proofsBytes[j] = Bytes48(proof)
+		}
+		cellRows = append(cellRows, cells)
+		proofRows = append(proofRows, proofsBytes)
+	}
+	cellCommitments, cellIndices, cells, cellProofs := getColumns(commitments, cellRows, proofRows, CellsPerExtBlob)
+
+	ok, err := VerifyCellKZGProofBatchParallel(cellCommitments, cellIndices, cells, cellProofs)
+	require.NoError(t, err)
+	require.True(t, ok)
+
+	last := len(cellProofs) - 1
+	cellProofs[last], cellProofs[last-1] = cellProofs[last-1], cellProofs[last]
+	ok, err = VerifyCellKZGProofBatchParallel(cellCommitments, cellIndices, cells, cellProofs)
+	require.NoError(t, err)
+	require.False(t, ok)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Benchmarks
 ///////////////////////////////////////////////////////////////////////////////
@@ -763,6 +877,15 @@ func Benchmark(b *testing.B) {
 		}
 	})
 
+	b.Run(fmt.Sprintf("ComputeCellsAndKZGProofsBatch(count=%v)", count), func(b *testing.B) {
+		cells := make([]Cell, count*CellsPerExtBlob)
+		proofs := make([]KZGProof, count*CellsPerExtBlob)
+		for n := 0; n < b.N; n++ {
+			err := ComputeCellsAndKZGProofsBatch(blobs[:count], cells, proofs)
+			require.NoError(b, err)
+		}
+	})
+
 	for i := 2; i <= 8; i *= 2 {
 		percentMissing := (1.0 / float64(i)) * 100
 		cellIndices, partialCells := getPartialCells(blobCells[0], i)
@@ -806,6 +929,16 @@ func Benchmark(b *testing.B) {
 		}
 	})
 
+	b.Run("VerifyCellKZGProofBatchParallel", func(b *testing.B) {
+		cellCommitments, cellIndices, cells, cellProofs := getColumns(commitments[:], blobCells[:], blobCellProofs[:], CellsPerExtBlob)
+		b.ResetTimer()
+		for n := 0; n < b.N; n++ {
+			ok, err := VerifyCellKZGProofBatchParallel(cellCommitments, cellIndices, cells, cellProofs)
+			require.NoError(b, err)
+			require.True(b, ok)
+		}
+	})
+
 	for i := 1; i <= length; i *= 2 {
 		b.Run(fmt.Sprintf("VerifyRows(count=%v)", i), func(b *testing.B) {
 			var cellCommitments []Bytes48
@@ -6,6 +6,17 @@
 
 static const char *TRUSTED_SETUP_NOT_LOADED = "Trusted Setup is not loaded.";
 
+/*
+ * Most byte[] functions access their arrays with GetPrimitiveArrayCritical, so
+ * most JVMs pass them without a copy. No other JNI function may be called while
+ * a critical array is held, so output arrays are allocated before and
+ * exceptions are thrown after. A critical array can also hold off the garbage
+ * collector, so the batch verification and cell functions, which run for much
+ * longer, copy their arrays instead. The ByteBuffer functions use direct
+ * buffers as they are and write their outputs into buffers supplied by the
+ * caller, but still copy their cell indices.
+ */
+
 KZGSettings *settings;
 
 void reset_trusted_setup(void) {
@@ -41,6 +52,41 @@ void throw_invalid_size_exception(JNIEnv *env, const char *prefix, size_t size,
   throw_c_kzg_exception(env, C_KZG_BADARGS, message);
 }
 
+/*
+ * Returns the address of the remaining bytes of a direct ByteBuffer, from its
+ * position to its limit. Throws and returns NULL if the buffer is not direct or
+ * if the number of remaining bytes is not expected_size. The name of the
+ * argument is used in the exception messages.
+ */
+uint8_t *get_direct_buffer(JNIEnv *env, jobject buffer, const char *name,
+                           size_t expected_size) {
+  char message[100];
+  uint8_t *address =
+      buffer == NULL ? NULL : (*env)->GetDirectBufferAddress(env, buffer);
+  if (address == NULL) {
+    snprintf(message, sizeof(message),
+             "Invalid %s buffer. Expected a direct ByteBuffer.", name);
+    throw_c_kzg_exception(env, C_KZG_BADARGS, message);
+    return NULL;
+  }
+
+  jclass buffer_class = (*env)->FindClass(env, "java/nio/Buffer");
+  jmethodID position_method =
+      (*env)->GetMethodID(env, buffer_class, "position", "()I");
+  jmethodID limit_method =
+      (*env)->GetMethodID(env, buffer_class, "limit", "()I");
+  size_t position = (size_t)(*env)->CallIntMethod(env, buffer, position_method);
+  size_t limit = (size_t)(*env)->CallIntMethod(env, buffer, limit_method);
+  (*env)->DeleteLocalRef(env, buffer_class);
+
+  if (limit - position != expected_size) {
+    snprintf(message, sizeof(message), "Invalid %s size.", name);
+    throw_invalid_size_exception(env, message, limit - position, expected_size);
+    return NULL;
+  }
+  return address + position;
+}
+
 KZGSettings *allocate_settings(JNIEnv *env) {
   KZGSettings *s = malloc(sizeof(KZGSettings));
   if (s == NULL) {
@@ -146,9 +192,8 @@ JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_freeTrustedSetup(
 }
 
 JNIEXPORT jbyteArray JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment(JNIEnv *env,
-                                                       jclass thisCls,
-                                                       jbyteArray blob) {
+Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment___3B(
+    JNIEnv *env, jclass thisCls, jbyteArray blob) {
   if (settings == NULL) {
     throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
     return NULL;
@@ -161,17 +206,16 @@ Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment(JNIEnv *env,
     return NULL;
   }
 
-  jbyte *blob_native = (*env)->GetByteArrayElements(env, blob, NULL);
   jbyteArray commitment = (*env)->NewByteArray(env, BYTES_PER_COMMITMENT);
+  jbyte *blob_native = (*env)->GetPrimitiveArrayCritical(env, blob, NULL);
   KZGCommitment *commitment_native =
-      (KZGCommitment *)(*env)->GetByteArrayElements(env, commitment, NULL);
+      (*env)->GetPrimitiveArrayCritical(env, commitment, NULL);
 
   C_KZG_RET ret = blob_to_kzg_commitment(commitment_native,
                                          (const Blob *)blob_native, settings);
 
-  (*env)->ReleaseByteArrayElements(env, blob, blob_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, commitment, (jbyte *)commitment_native,
-                                   0);
+  (*env)->ReleasePrimitiveArrayCritical(env, blob, blob_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, commitment, commitment_native, 0);
 
   if (ret != C_KZG_OK) {
     throw_c_kzg_exception(env, ret,
@@ -208,21 +252,18 @@ JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeKzgProof(
   jbyteArray y = (*env)->NewByteArray(env, BYTES_PER_FIELD_ELEMENT);
 
   /* The native variables */
-  KZGProof *proof_native =
-      (KZGProof *)(uint8_t *)(*env)->GetByteArrayElements(env, proof, NULL);
-  Bytes32 *y_native =
-      (Bytes32 *)(uint8_t *)(*env)->GetByteArrayElements(env, y, NULL);
-  Blob *blob_native = (Blob *)(*env)->GetByteArrayElements(env, blob, NULL);
-  Bytes32 *z_native =
-      (Bytes32 *)(*env)->GetByteArrayElements(env, z_bytes, NULL);
+  KZGProof *proof_native = (*env)->GetPrimitiveArrayCritical(env, proof, NULL);
+  Bytes32 *y_native = (*env)->GetPrimitiveArrayCritical(env, y, NULL);
+  Blob *blob_native = (*env)->GetPrimitiveArrayCritical(env, blob, NULL);
+  Bytes32 *z_native = (*env)->GetPrimitiveArrayCritical(env, z_bytes, NULL);
 
   C_KZG_RET ret = compute_kzg_proof(proof_native, y_native, blob_native,
                                     z_native, settings);
 
-  (*env)->ReleaseByteArrayElements(env, proof, (jbyte *)proof_native, 0);
-  (*env)->ReleaseByteArrayElements(env, y, (jbyte *)y_native, 0);
-  (*env)->ReleaseByteArrayElements(env, blob, (jbyte *)blob_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, z_bytes, (jbyte *)z_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, proof, proof_native, 0);
+  (*env)->ReleasePrimitiveArrayCritical(env, y, y_native, 0);
+  (*env)->ReleasePrimitiveArrayCritical(env, blob, blob_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, z_bytes, z_native, JNI_ABORT);
 
   if (ret != C_KZG_OK) {
     throw_c_kzg_exception(env, ret, "There was an error in computeKzgProof.");
@@ -254,7 +295,7 @@ JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeKzgProof(
 }
 
 JNIEXPORT jbyteArray JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof(
+Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof___3B_3B(
     JNIEnv *env, jclass thisCls, jbyteArray blob, jbyteArray commitment_bytes) {
   if (settings == NULL) {
     throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
@@ -276,21 +317,20 @@ Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof(
     return NULL;
   }
 
-  Blob *blob_native = (Blob *)(*env)->GetByteArrayElements(env, blob, NULL);
-  Bytes48 *commitment_native =
-      (Bytes48 *)(*env)->GetByteArrayElements(env, commitment_bytes, NULL);
-
   jbyteArray proof = (*env)->NewByteArray(env, BYTES_PER_PROOF);
-  KZGProof *proof_native =
-      (KZGProof *)(uint8_t *)(*env)->GetByteArrayElements(env, proof, NULL);
+
+  Blob *blob_native = (*env)->GetPrimitiveArrayCritical(env, blob, NULL);
+  Bytes48 *commitment_native =
+      (*env)->GetPrimitiveArrayCritical(env, commitment_bytes, NULL);
+  KZGProof *proof_native = (*env)->GetPrimitiveArrayCritical(env, proof, NULL);
 
   C_KZG_RET ret = compute_blob_kzg_proof(proof_native, blob_native,
                                          commitment_native, settings);
 
-  (*env)->ReleaseByteArrayElements(env, blob, (jbyte *)blob_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, commitment_bytes,
-                                   (jbyte *)commitment_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, proof, (jbyte *)proof_native, 0);
+  (*env)->ReleasePrimitiveArrayCritical(env, blob, blob_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, commitment_bytes,
+                                        commitment_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, proof, proof_native, 0);
 
   if (ret != C_KZG_OK) {
     throw_c_kzg_exception(env, ret,
@@ -339,24 +379,22 @@ JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyKzgProof(
   }
 
   Bytes48 *commitment_native =
-      (Bytes48 *)(*env)->GetByteArrayElements(env, commitment_bytes, NULL);
+      (*env)->GetPrimitiveArrayCritical(env, commitment_bytes, NULL);
   Bytes48 *proof_native =
-      (Bytes48 *)(*env)->GetByteArrayElements(env, proof_bytes, NULL);
-  Bytes32 *z_native =
-      (Bytes32 *)(*env)->GetByteArrayElements(env, z_bytes, NULL);
-  Bytes32 *y_native =
-      (Bytes32 *)(*env)->GetByteArrayElements(env, y_bytes, NULL);
+      (*env)->GetPrimitiveArrayCritical(env, proof_bytes, NULL);
+  Bytes32 *z_native = (*env)->GetPrimitiveArrayCritical(env, z_bytes, NULL);
+  Bytes32 *y_native = (*env)->GetPrimitiveArrayCritical(env, y_bytes, NULL);
 
   bool out;
   C_KZG_RET ret = verify_kzg_proof(&out, commitment_native, z_native, y_native,
                                    proof_native, settings);
 
-  (*env)->ReleaseByteArrayElements(env, commitment_bytes,
-                                   (jbyte *)commitment_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, z_bytes, (jbyte *)z_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, y_bytes, (jbyte *)y_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, proof_bytes, (jbyte *)proof_native,
-                                   JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, commitment_bytes,
+                                        commitment_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, z_bytes, z_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, y_bytes, y_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, proof_bytes, proof_native,
+                                        JNI_ABORT);
 
   if (ret != C_KZG_OK) {
     throw_c_kzg_exception(env, ret, "There was an error in verifyKzgProof.");
@@ -397,21 +435,21 @@ Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProof(
     return 0;
   }
 
-  Blob *blob_native = (Blob *)(*env)->GetByteArrayElements(env, blob, NULL);
+  Blob *blob_native = (*env)->GetPrimitiveArrayCritical(env, blob, NULL);
   Bytes48 *commitment_native =
-      (Bytes48 *)(*env)->GetByteArrayElements(env, commitment_bytes, NULL);
+      (*env)->GetPrimitiveArrayCritical(env, commitment_bytes, NULL);
   Bytes48 *proof_native =
-      (Bytes48 *)(*env)->GetByteArrayElements(env, proof_bytes, NULL);
+      (*env)->GetPrimitiveArrayCritical(env, proof_bytes, NULL);
 
   bool out;
   C_KZG_RET ret = verify_blob_kzg_proof(&out, blob_native, commitment_native,
                                         proof_native, settings);
 
-  (*env)->ReleaseByteArrayElements(env, blob, (jbyte *)blob_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, commitment_bytes,
-                                   (jbyte *)commitment_native, JNI_ABORT);
-  (*env)->ReleaseByteArrayElements(env, proof_bytes, (jbyte *)proof_native,
-                                   JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, blob, blob_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, commitment_bytes,
+                                        commitment_native, JNI_ABORT);
+  (*env)->ReleasePrimitiveArrayCritical(env, proof_bytes, proof_native,
+                                        JNI_ABORT);
 
   if (ret != C_KZG_OK) {
     throw_c_kzg_exception(env, ret,
@@ -423,7 +461,7 @@ Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProof(
 }
 
 JNIEXPORT jboolean JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch(
+Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch___3B_3B_3BJ(
     JNIEnv *env, jclass thisCls, jbyteArray blobs, jbyteArray commitments_bytes,
     jbyteArray proofs_bytes, jlong count) {
   if (settings == NULL) {
@@ -483,9 +521,8 @@ Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch(
 }
 
 JNIEXPORT jobject JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs(JNIEnv *env,
-                                                            jclass thisCls,
-                                                            jbyteArray blob) {
+Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs___3B(
+    JNIEnv *env, jclass thisCls, jbyteArray blob) {
   if (settings == NULL) {
     throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
     return NULL;
@@ -504,7 +541,7 @@ Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs(JNIEnv *env,
   jbyteArray proofs =
       (*env)->NewByteArray(env, CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
 
-  /* The native variables */
+  /* The native variables, copied as the computation is too long to pin them */
   Cell *cells_native = (Cell *)(*env)->GetByteArrayElements(env, cells, NULL);
   KZGProof *proofs_native =
       (KZGProof *)(*env)->GetByteArrayElements(env, proofs, NULL);
@@ -551,7 +588,7 @@ Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs(JNIEnv *env,
 }
 
 JNIEXPORT jbyteArray JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs(
+Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs___3J_3B(
     JNIEnv *env, jclass thisCls, jlongArray cell_indices, jbyteArray cells) {
   if (settings == NULL) {
     throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
@@ -568,10 +605,10 @@ Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs(
 
   jbyteArray recovered_cells =
       (*env)->NewByteArray(env, CELLS_PER_EXT_BLOB * BYTES_PER_CELL);
-  Cell *recovered_cells_native =
-      (Cell *)(*env)->GetByteArrayElements(env, recovered_cells, NULL);
   jbyteArray recovered_proofs =
       (*env)->NewByteArray(env, CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
+  Cell *recovered_cells_native =
+      (Cell *)(*env)->GetByteArrayElements(env, recovered_cells, NULL);
   KZGProof *recovered_proofs_native =
       (KZGProof *)(*env)->GetByteArrayElements(env, recovered_proofs, NULL);
   uint64_t *cell_indices_native =
@@ -625,7 +662,7 @@ Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs(
 }
 
 JNIEXPORT jboolean JNICALL
-Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch(
+Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch___3B_3J_3B_3B(
     JNIEnv *env, jclass thisCls, jbyteArray commitments_bytes,
     jlongArray cell_indices, jbyteArray cells, jbyteArray proofs_bytes) {
   if (settings == NULL) {
@@ -695,3 +732,225 @@ Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch(
 
   return (jboolean)out;
 }
+
+JNIEXPORT void JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2(
+    JNIEnv *env, jclass thisCls, jobject blob, jobject commitment) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return;
+  }
+
+  Blob *blob_native =
+      (Blob *)get_direct_buffer(env, blob, "blob", BYTES_PER_BLOB);
+  if (blob_native == NULL) {
+    return;
+  }
+  KZGCommitment *commitment_native = (KZGCommitment *)get_direct_buffer(
+      env, commitment, "commitment", BYTES_PER_COMMITMENT);
+  if (commitment_native == NULL) {
+    return;
+  }
+
+  C_KZG_RET ret =
+      blob_to_kzg_commitment(commitment_native, blob_native, settings);
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in blobToKzgCommitment.");
+  }
+}
+
+JNIEXPORT void JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2(
+    JNIEnv *env, jclass thisCls, jobject blob, jobject commitment_bytes,
+    jobject proof) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return;
+  }
+
+  Blob *blob_native =
+      (Blob *)get_direct_buffer(env, blob, "blob", BYTES_PER_BLOB);
+  if (blob_native == NULL) {
+    return;
+  }
+  Bytes48 *commitment_native = (Bytes48 *)get_direct_buffer(
+      env, commitment_bytes, "commitment", BYTES_PER_COMMITMENT);
+  if (commitment_native == NULL) {
+    return;
+  }
+  KZGProof *proof_native = (KZGProof *)get_direct_buffer(
+      env, proof, "proof", BYTES_PER_PROOF);
+  if (proof_native == NULL) {
+    return;
+  }
+
+  C_KZG_RET ret = compute_blob_kzg_proof(proof_native, blob_native,
+                                         commitment_native, settings);
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in computeBlobKzgProof.");
+  }
+}
+
+JNIEXPORT jboolean JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2J(
+    JNIEnv *env, jclass thisCls, jobject blobs, jobject commitments_bytes,
+    jobject proofs_bytes, jlong count) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return 0;
+  }
+
+  size_t count_native = (size_t)count;
+  Blob *blobs_native = (Blob *)get_direct_buffer(
+      env, blobs, "blobs", count_native * BYTES_PER_BLOB);
+  if (blobs_native == NULL) {
+    return 0;
+  }
+  Bytes48 *commitments_native = (Bytes48 *)get_direct_buffer(
+      env, commitments_bytes, "commitments",
+      count_native * BYTES_PER_COMMITMENT);
+  if (commitments_native == NULL) {
+    return 0;
+  }
+  Bytes48 *proofs_native = (Bytes48 *)get_direct_buffer(
+      env, proofs_bytes, "proofs", count_native * BYTES_PER_PROOF);
+  if (proofs_native == NULL) {
+    return 0;
+  }
+
+  bool out;
+  C_KZG_RET ret =
+      verify_blob_kzg_proof_batch(&out, blobs_native, commitments_native,
+                                  proofs_native, count_native, settings);
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in verifyBlobKzgProofBatch.");
+    return 0;
+  }
+
+  return (jboolean)out;
+}
+
+JNIEXPORT void JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2(
+    JNIEnv *env, jclass thisCls, jobject blob, jobject cells, jobject proofs) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return;
+  }
+
+  Blob *blob_native =
+      (Blob *)get_direct_buffer(env, blob, "blob", BYTES_PER_BLOB);
+  if (blob_native == NULL) {
+    return;
+  }
+  Cell *cells_native = (Cell *)get_direct_buffer(
+      env, cells, "cells", CELLS_PER_EXT_BLOB * BYTES_PER_CELL);
+  if (cells_native == NULL) {
+    return;
+  }
+  KZGProof *proofs_native = (KZGProof *)get_direct_buffer(
+      env, proofs, "proofs", CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
+  if (proofs_native == NULL) {
+    return;
+  }
+
+  C_KZG_RET ret = compute_cells_and_kzg_proofs(cells_native, proofs_native,
+                                               blob_native, settings);
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in computeCellsAndKzgProofs.");
+  }
+}
+
+JNIEXPORT void JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs___3JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2(
+    JNIEnv *env, jclass thisCls, jlongArray cell_indices, jobject cells,
+    jobject recovered_cells, jobject recovered_proofs) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return;
+  }
+
+  size_t count = (size_t)(*env)->GetArrayLength(env, cell_indices);
+  Cell *cells_native = (Cell *)get_direct_buffer(
+      env, cells, "cells", count * BYTES_PER_CELL);
+  if (cells_native == NULL) {
+    return;
+  }
+  Cell *recovered_cells_native = (Cell *)get_direct_buffer(
+      env, recovered_cells, "recovered cells",
+      CELLS_PER_EXT_BLOB * BYTES_PER_CELL);
+  if (recovered_cells_native == NULL) {
+    return;
+  }
+  KZGProof *recovered_proofs_native = (KZGProof *)get_direct_buffer(
+      env, recovered_proofs, "recovered proofs",
+      CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
+  if (recovered_proofs_native == NULL) {
+    return;
+  }
+
+  uint64_t *cell_indices_native =
+      (uint64_t *)(*env)->GetLongArrayElements(env, cell_indices, NULL);
+
+  C_KZG_RET ret = recover_cells_and_kzg_proofs(
+      recovered_cells_native, recovered_proofs_native, cell_indices_native,
+      cells_native, count, settings);
+
+  (*env)->ReleaseLongArrayElements(env, cell_indices,
+                                   (jlong *)cell_indices_native, JNI_ABORT);
+
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in recoverCellsAndKzgProofs.");
+  }
+}
+
+JNIEXPORT jboolean JNICALL
+Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch__Ljava_nio_ByteBuffer_2_3JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2(
+    JNIEnv *env, jclass thisCls, jobject commitments_bytes,
+    jlongArray cell_indices, jobject cells, jobject proofs_bytes) {
+  if (settings == NULL) {
+    throw_exception(env, TRUSTED_SETUP_NOT_LOADED);
+    return 0;
+  }
+
+  size_t count = (size_t)(*env)->GetArrayLength(env, cell_indices);
+  Bytes48 *commitments_native = (Bytes48 *)get_direct_buffer(
+      env, commitments_bytes, "commitments", count * BYTES_PER_COMMITMENT);
+  if (commitments_native == NULL) {
+    return 0;
+  }
+  Cell *cells_native = (Cell *)get_direct_buffer(
+      env, cells, "cells", count * BYTES_PER_CELL);
+  if (cells_native == NULL) {
+    return 0;
+  }
+  Bytes48 *proofs_native = (Bytes48 *)get_direct_buffer(
+      env, proofs_bytes, "proofs", count * BYTES_PER_PROOF);
+  if (proofs_native == NULL) {
+    return 0;
+  }
+
+  uint64_t *cell_indices_native =
+      (uint64_t *)(*env)->GetLongArrayElements(env, cell_indices, NULL);
+
+  bool out;
+  C_KZG_RET ret =
+      verify_cell_kzg_proof_batch(&out, commitments_native, cell_indices_native,
+                                  cells_native, proofs_native, count, settings);
+
+  (*env)->ReleaseLongArrayElements(env, cell_indices,
+                                   (jlong *)cell_indices_native, JNI_ABORT);
+
+  if (ret != C_KZG_OK) {
+    throw_c_kzg_exception(env, ret,
+                          "There was an error in verifyCellKzgProofBatch.");
+    return 0;
+  }
+
+  return (jboolean)out;
+}
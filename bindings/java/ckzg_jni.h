@@ -60,9 +60,17 @@ JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_freeTrustedSetup
  * Method:    blobToKzgCommitment
  * Signature: ([B)[B
  */
-JNIEXPORT jbyteArray JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment
+JNIEXPORT jbyteArray JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment___3B
   (JNIEnv *, jclass, jbyteArray);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    blobToKzgCommitment
+ * Signature: (Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_blobToKzgCommitment__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jobject, jobject);
+
 /*
  * Class:     ethereum_ckzg4844_CKZG4844JNI
  * Method:    computeKzgProof
@@ -76,9 +84,17 @@ JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeKzgProof
  * Method:    computeBlobKzgProof
  * Signature: ([B[B)[B
  */
-JNIEXPORT jbyteArray JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof
+JNIEXPORT jbyteArray JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof___3B_3B
   (JNIEnv *, jclass, jbyteArray, jbyteArray);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    computeBlobKzgProof
+ * Signature: (Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeBlobKzgProof__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jobject, jobject, jobject);
+
 /*
  * Class:     ethereum_ckzg4844_CKZG4844JNI
  * Method:    verifyKzgProof
@@ -100,33 +116,65 @@ JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProof
  * Method:    verifyBlobKzgProofBatch
  * Signature: ([B[B[BJ)Z
  */
-JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch
+JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch___3B_3B_3BJ
   (JNIEnv *, jclass, jbyteArray, jbyteArray, jbyteArray, jlong);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    verifyBlobKzgProofBatch
+ * Signature: (Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyBlobKzgProofBatch__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2J
+  (JNIEnv *, jclass, jobject, jobject, jobject, jlong);
+
 /*
  * Class:     ethereum_ckzg4844_CKZG4844JNI
  * Method:    computeCellsAndKzgProofs
  * Signature: ([B)Lethereum/ckzg4844/CellsAndProofs;
  */
-JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs
+JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs___3B
   (JNIEnv *, jclass, jbyteArray);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    computeCellsAndKzgProofs
+ * Signature: (Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_computeCellsAndKzgProofs__Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jobject, jobject, jobject);
+
 /*
  * Class:     ethereum_ckzg4844_CKZG4844JNI
  * Method:    recoverCellsAndKzgProofs
  * Signature: ([J[B)Lethereum/ckzg4844/CellsAndProofs;
  */
-JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs
+JNIEXPORT jobject JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs___3J_3B
   (JNIEnv *, jclass, jlongArray, jbyteArray);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    recoverCellsAndKzgProofs
+ * Signature: ([JLjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_recoverCellsAndKzgProofs___3JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jlongArray, jobject, jobject, jobject);
+
 /*
  * Class:     ethereum_ckzg4844_CKZG4844JNI
  * Method:    verifyCellKzgProofBatch
  * Signature: ([B[J[B[B)Z
  */
-JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch
+JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch___3B_3J_3B_3B
   (JNIEnv *, jclass, jbyteArray, jlongArray, jbyteArray, jbyteArray);
 
+/*
+ * Class:     ethereum_ckzg4844_CKZG4844JNI
+ * Method:    verifyCellKzgProofBatch
+ * Signature: (Ljava/nio/ByteBuffer;[JLjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_ethereum_ckzg4844_CKZG4844JNI_verifyCellKzgProofBatch__Ljava_nio_ByteBuffer_2_3JLjava_nio_ByteBuffer_2Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jclass, jobject, jlongArray, jobject, jobject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,7 @@ import java.io.IOException;
 import java.io.InputStream;
 import java.io.UncheckedIOException;
 import java.math.BigInteger;
+import java.nio.ByteBuffer;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardCopyOption;
@@ -155,6 +156,17 @@ public class CKZG4844JNI {
    */
   public static native byte[] blobToKzgCommitment(byte[] blob);
 
+  /**
+   * An alternative to {@link #blobToKzgCommitment(byte[])} which reads and writes direct buffers
+   * without copying them. Each buffer is used from its position to its limit, which must span
+   * exactly the expected number of bytes. Positions are not changed.
+   *
+   * @param blob a direct buffer with the blob bytes
+   * @param commitment a direct buffer to write the commitment to
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native void blobToKzgCommitment(ByteBuffer blob, ByteBuffer commitment);
+
   /**
    * Compute proof at point z for the polynomial represented by blob.
    *
@@ -175,6 +187,19 @@ public class CKZG4844JNI {
    */
   public static native byte[] computeBlobKzgProof(byte[] blob, byte[] commitmentBytes);
 
+  /**
+   * An alternative to {@link #computeBlobKzgProof(byte[],byte[])} which reads and writes direct
+   * buffers without copying them, in the same way as {@link
+   * #blobToKzgCommitment(ByteBuffer,ByteBuffer)}.
+   *
+   * @param blob a direct buffer with the blob bytes
+   * @param commitmentBytes a direct buffer with the commitment bytes
+   * @param proof a direct buffer to write the proof to
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native void computeBlobKzgProof(
+      ByteBuffer blob, ByteBuffer commitmentBytes, ByteBuffer proof);
+
   /**
    * Verify the proof by point evaluation for the given commitment
    *
@@ -204,6 +229,9 @@ public class CKZG4844JNI {
    * Given a list of blobs and blob KZG proofs, verify that they correspond to the provided
    * commitments.
    *
+   * <p>The arrays are copied, as the verification is too long to pin them. Use {@link
+   * #verifyBlobKzgProofBatch(ByteBuffer,ByteBuffer,ByteBuffer,long)} to avoid the copies.
+   *
    * @param blobs flattened blobs bytes
    * @param commitmentsBytes flattened commitments bytes
    * @param proofsBytes flattened proofs bytes
@@ -214,18 +242,52 @@ public class CKZG4844JNI {
   public static native boolean verifyBlobKzgProofBatch(
       byte[] blobs, byte[] commitmentsBytes, byte[] proofsBytes, long count);
 
+  /**
+   * An alternative to {@link #verifyBlobKzgProofBatch(byte[],byte[],byte[],long)} which reads
+   * direct buffers without copying them, in the same way as {@link
+   * #blobToKzgCommitment(ByteBuffer,ByteBuffer)}.
+   *
+   * @param blobs a direct buffer with the flattened blobs bytes
+   * @param commitmentsBytes a direct buffer with the flattened commitments bytes
+   * @param proofsBytes a direct buffer with the flattened proofs bytes
+   * @param count the number of blobs (should be same as the number of proofs and commitments)
+   * @return true if the proof is valid and false otherwise
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native boolean verifyBlobKzgProofBatch(
+      ByteBuffer blobs, ByteBuffer commitmentsBytes, ByteBuffer proofsBytes, long count);
+
   /**
    * Get the cells and proofs for a given blob.
    *
+   * <p>The arrays are copied, as the computation is too long to pin them. Use {@link
+   * #computeCellsAndKzgProofs(ByteBuffer,ByteBuffer,ByteBuffer)} to avoid the copies.
+   *
    * @param blob the blob to get cells/proofs for
    * @return a CellsAndProofs object
    * @throws CKZGException if there is a crypto error
    */
   public static native CellsAndProofs computeCellsAndKzgProofs(byte[] blob);
 
+  /**
+   * An alternative to {@link #computeCellsAndKzgProofs(byte[])} which reads and writes direct
+   * buffers without copying them, in the same way as {@link
+   * #blobToKzgCommitment(ByteBuffer,ByteBuffer)}.
+   *
+   * @param blob a direct buffer with the blob bytes
+   * @param cells a direct buffer to write the {@link #CELLS_PER_EXT_BLOB} cells to
+   * @param proofs a direct buffer to write the {@link #CELLS_PER_EXT_BLOB} proofs to
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native void computeCellsAndKzgProofs(
+      ByteBuffer blob, ByteBuffer cells, ByteBuffer proofs);
+
   /**
    * Given at least 50% of cells, reconstruct the missing cells/proofs.
    *
+   * <p>The arrays are copied, as the computation is too long to pin them. Use {@link
+   * #recoverCellsAndKzgProofs(long[],ByteBuffer,ByteBuffer,ByteBuffer)} to avoid the copies.
+   *
    * @param cellIndices the identifiers for the cells you have
    * @param cells the cells you have
    * @return all cells/proofs for that blob
@@ -233,9 +295,26 @@ public class CKZG4844JNI {
    */
   public static native CellsAndProofs recoverCellsAndKzgProofs(long[] cellIndices, byte[] cells);
 
+  /**
+   * An alternative to {@link #recoverCellsAndKzgProofs(long[],byte[])} which reads and writes
+   * direct buffers without copying them, in the same way as {@link
+   * #blobToKzgCommitment(ByteBuffer,ByteBuffer)}.
+   *
+   * @param cellIndices the identifiers for the cells you have
+   * @param cells a direct buffer with the cells you have
+   * @param recoveredCells a direct buffer to write all {@link #CELLS_PER_EXT_BLOB} cells to
+   * @param recoveredProofs a direct buffer to write all {@link #CELLS_PER_EXT_BLOB} proofs to
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native void recoverCellsAndKzgProofs(
+      long[] cellIndices, ByteBuffer cells, ByteBuffer recoveredCells, ByteBuffer recoveredProofs);
+
   /**
    * Verify that multiple cells' proofs are valid.
    *
+   * <p>The arrays are copied, as the verification is too long to pin them. Use {@link
+   * #verifyCellKzgProofBatch(ByteBuffer,long[],ByteBuffer,ByteBuffer)} to avoid the copies.
+   *
    * @param commitmentsBytes the commitments for each cell
    * @param cellIndices the column index for each cell
    * @param cells the cells to verify
@@ -245,4 +324,19 @@ public class CKZG4844JNI {
    */
   public static native boolean verifyCellKzgProofBatch(
       byte[] commitmentsBytes, long[] cellIndices, byte[] cells, byte[] proofsBytes);
+
+  /**
+   * An alternative to {@link #verifyCellKzgProofBatch(byte[],long[],byte[],byte[])} which reads
+   * direct buffers without copying them, in the same way as {@link
+   * #blobToKzgCommitment(ByteBuffer,ByteBuffer)}.
+   *
+   * @param commitmentsBytes a direct buffer with the commitments for each cell
+   * @param cellIndices the column index for each cell
+   * @param cells a direct buffer with the cells to verify
+   * @param proofsBytes a direct buffer with the proof for each cell
+   * @return true if the cells are valid with respect to the given commitments
+   * @throws CKZGException if there is a crypto error or a buffer is invalid
+   */
+  public static native boolean verifyCellKzgProofBatch(
+      ByteBuffer commitmentsBytes, long[] cellIndices, ByteBuffer cells, ByteBuffer proofsBytes);
 }
@@ -13,6 +13,7 @@ import static org.junit.jupiter.api.Assertions.assertThrows;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
 import ethereum.ckzg4844.test_formats.*;
+import java.nio.ByteBuffer;
 import java.util.stream.IntStream;
 import java.util.stream.LongStream;
 import java.util.stream.Stream;
@@ -264,6 +265,86 @@ public class CKZG4844JNITest {
     CKZG4844JNI.freeTrustedSetup();
   }
 
+  @Test
+  public void checkDirectByteBuffersMatchByteArrays() {
+    loadTrustedSetup();
+    final byte[] blob = TestUtils.createRandomBlob();
+    final byte[] commitment = CKZG4844JNI.blobToKzgCommitment(blob);
+    final byte[] proof = CKZG4844JNI.computeBlobKzgProof(blob, commitment);
+    final CellsAndProofs cellsAndProofs = CKZG4844JNI.computeCellsAndKzgProofs(blob);
+
+    final ByteBuffer blobBuffer = toDirectBuffer(blob);
+    final ByteBuffer commitmentBuffer = ByteBuffer.allocateDirect(BYTES_PER_COMMITMENT);
+    CKZG4844JNI.blobToKzgCommitment(blobBuffer, commitmentBuffer);
+    assertArrayEquals(commitment, toByteArray(commitmentBuffer));
+
+    final ByteBuffer proofBuffer = ByteBuffer.allocateDirect(BYTES_PER_PROOF);
+    CKZG4844JNI.computeBlobKzgProof(blobBuffer, commitmentBuffer, proofBuffer);
+    assertArrayEquals(proof, toByteArray(proofBuffer));
+    assertTrue(
+        CKZG4844JNI.verifyBlobKzgProofBatch(blobBuffer, commitmentBuffer, proofBuffer, 1));
+
+    final ByteBuffer cellsBuffer = ByteBuffer.allocateDirect(CELLS_PER_EXT_BLOB * BYTES_PER_CELL);
+    final ByteBuffer proofsBuffer = ByteBuffer.allocateDirect(CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
+    CKZG4844JNI.computeCellsAndKzgProofs(blobBuffer, cellsBuffer, proofsBuffer);
+    assertArrayEquals(cellsAndProofs.getCells(), toByteArray(cellsBuffer));
+    assertArrayEquals(cellsAndProofs.getProofs(), toByteArray(proofsBuffer));
+
+    final long[] cellIndices = LongStream.range(0, CELLS_PER_EXT_BLOB / 2).toArray();
+    final ByteBuffer partialCells =
+        cellsBuffer.duplicate().limit(cellIndices.length * BYTES_PER_CELL).slice();
+    final ByteBuffer recoveredCells =
+        ByteBuffer.allocateDirect(CELLS_PER_EXT_BLOB * BYTES_PER_CELL);
+    final ByteBuffer recoveredProofs =
+        ByteBuffer.allocateDirect(CELLS_PER_EXT_BLOB * BYTES_PER_PROOF);
+    CKZG4844JNI.recoverCellsAndKzgProofs(
+        cellIndices, partialCells, recoveredCells, recoveredProofs);
+    assertArrayEquals(cellsAndProofs.getCells(), toByteArray(recoveredCells));
+    assertArrayEquals(cellsAndProofs.getProofs(), toByteArray(recoveredProofs));
+
+    final ByteBuffer commitments =
+        ByteBuffer.allocateDirect(CELLS_PER_EXT_BLOB * BYTES_PER_COMMITMENT);
+    for (int i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+      commitments.put(commitment);
+    }
+    commitments.flip();
+    final long[] allCellIndices = LongStream.range(0, CELLS_PER_EXT_BLOB).toArray();
+    assertTrue(
+        CKZG4844JNI.verifyCellKzgProofBatch(
+            commitments, allCellIndices, cellsBuffer, proofsBuffer));
+
+    CKZG4844JNI.freeTrustedSetup();
+  }
+
+  @Test
+  public void passingInvalidByteBuffersThrowsAnException() {
+    loadTrustedSetup();
+
+    CKZGException exception =
+        assertThrows(
+            CKZGException.class,
+            () ->
+                CKZG4844JNI.blobToKzgCommitment(
+                    ByteBuffer.wrap(TestUtils.createRandomBlob()),
+                    ByteBuffer.allocateDirect(BYTES_PER_COMMITMENT)));
+    assertEquals(C_KZG_BADARGS, exception.getError());
+    assertEquals(
+        "Invalid blob buffer. Expected a direct ByteBuffer.", exception.getErrorMessage());
+
+    exception =
+        assertThrows(
+            CKZGException.class,
+            () ->
+                CKZG4844JNI.blobToKzgCommitment(
+                    toDirectBuffer(TestUtils.createRandomBlob()),
+                    ByteBuffer.allocateDirect(BYTES_PER_COMMITMENT + 1)));
+    assertEquals(C_KZG_BADARGS, exception.getError());
+    assertEquals(
+        "Invalid commitment size. Expected 48 bytes but got 49.", exception.getErrorMessage());
+
+    CKZG4844JNI.freeTrustedSetup();
+  }
+
   @Test
   public void checkComputeBlobKzgProof() {
     loadTrustedSetup();
@@ -455,6 +536,18 @@ public class CKZG4844JNITest {
             .contains("There was an error while loading the Trusted Setup."));
   }
 
+  private static ByteBuffer toDirectBuffer(final byte[] bytes) {
+    final ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+    buffer.put(bytes).flip();
+    return buffer;
+  }
+
+  private static byte[] toByteArray(final ByteBuffer buffer) {
+    final byte[] bytes = new byte[buffer.remaining()];
+    buffer.duplicate().get(bytes);
+    return bytes;
+  }
+
   private void assertExceptionIsTrustedSetupIsNotLoaded(final RuntimeException exception) {
     assertEquals("Trusted Setup is not loaded.", exception.getMessage());
   }
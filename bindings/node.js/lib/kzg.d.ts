@@ -176,3 +176,82 @@ export function verifyCellKzgProofBatch(
   cells: Cell[],
   proofsBytes: Bytes48[]
 ): boolean;
+
+/*
+ * Asynchronous variants of the heavy functions. These run on the libuv
+ * threadpool instead of blocking the event loop, and are settled with the same
+ * result as their synchronous counterparts. Library errors reject the promise
+ * with the same message, naming the Async function. Arguments are checked and
+ * copied before returning, so invalid arguments still throw synchronously.
+ */
+
+/**
+ * Convert a blob to a KZG commitment, off the main thread.
+ *
+ * @param {Blob} blob - The blob representing the polynomial to be committed to
+ *
+ * @return {Promise<KZGCommitment>} - The resulting commitment
+ */
+export function blobToKzgCommitmentAsync(blob: Blob): Promise<KZGCommitment>;
+
+/**
+ * Compute the KZG proof for a blob, off the main thread.
+ *
+ * @param {Blob}    blob - The blob (polynomial) to generate a proof for
+ * @param {Bytes48} commitmentBytes - Commitment to verify
+ *
+ * @return {Promise<KZGProof>} - The resulting proof
+ */
+export function computeBlobKzgProofAsync(blob: Blob, commitmentBytes: Bytes48): Promise<KZGProof>;
+
+/**
+ * Verify a batch of blob proofs, off the main thread.
+ *
+ * @param {Blob}    blobs - An array of serialized blobs to verify
+ * @param {Bytes48} commitmentsBytes - An array of serialized commitments to verify
+ * @param {Bytes48} proofsBytes - An array of serialized KZG proofs for verification
+ *
+ * @return {Promise<boolean>} - true/false depending on batch validity
+ */
+export function verifyBlobKzgProofBatchAsync(
+  blobs: Blob[],
+  commitmentsBytes: Bytes48[],
+  proofsBytes: Bytes48[]
+): Promise<boolean>;
+
+/**
+ * Get the cells and proofs for a given blob, off the main thread.
+ *
+ * @param {Blob}    blob - the blob to get cells/proofs for
+ *
+ * @return {Promise<[Cell[], KZGProof[]]>} - A tuple of cells and proofs
+ */
+export function computeCellsAndKzgProofsAsync(blob: Blob): Promise<[Cell[], KZGProof[]]>;
+
+/**
+ * Given at least 50% of cells, reconstruct the missing cells/proofs, off the
+ * main thread.
+ *
+ * @param[in] {number[]}  cellIndices - The identifiers for the cells you have
+ * @param[in] {Cell[]}    cells - The cells you have
+ *
+ * @return {Promise<[Cell[], KZGProof[]]>} - A tuple of cells and proofs
+ */
+export function recoverCellsAndKzgProofsAsync(cellIndices: number[], cells: Cell[]): Promise<[Cell[], KZGProof[]]>;
+
+/**
+ * Verify that multiple cells' proofs are valid, off the main thread.
+ *
+ * @param {Bytes48[]} commitmentsBytes - The commitments for each cell
+ * @param {number[]}  cellIndices - The column index for each cell
+ * @param {Cell[]}    cells - The cells to verify
+ * @param {Bytes48[]} proofsBytes - The proof for each cell
+ *
+ * @return {Promise<boolean>} - True if the cells are valid with respect to the given commitments
+ */
+export function verifyCellKzgProofBatchAsync(
+  commitmentsBytes: Bytes48[],
+  cellIndices: number[],
+  cells: Cell[],
+  proofsBytes: Bytes48[]
+): Promise<boolean>;
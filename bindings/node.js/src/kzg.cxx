@@ -5,6 +5,7 @@
 #include <sstream> // std::ostringstream
 #include <stdio.h>
 #include <string_view>
+#include <vector>
 
 /**
  * Convert C_KZG_RET to a string representation for error messages.
@@ -175,6 +176,46 @@ inline uint64_t get_cell_index(const Napi::Env &env, const Napi::Value &val) {
     return static_cast<uint64_t>(number);
 }
 
+/**
+ * Convert all of the cells and proofs of an extended blob to the
+ * `[Cell[], KZGProof[]]` tuple returned to javascript.
+ *
+ * @param[in] env    Passed from calling context
+ * @param[in] cells  CELLS_PER_EXT_BLOB cells
+ * @param[in] proofs CELLS_PER_EXT_BLOB proofs
+ *
+ * @return - The tuple, the data is copied
+ */
+Napi::Array cells_and_proofs_to_tuple(
+    const Napi::Env &env, const Cell *cells, const KZGProof *proofs
+) {
+    Napi::Array cellArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
+    Napi::Array proofArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
+    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        cellArray.Set(
+            i,
+            Napi::Buffer<uint8_t>::Copy(
+                env,
+                reinterpret_cast<const uint8_t *>(&cells[i]),
+                BYTES_PER_CELL
+            )
+        );
+        proofArray.Set(
+            i,
+            Napi::Buffer<uint8_t>::Copy(
+                env,
+                reinterpret_cast<const uint8_t *>(&proofs[i]),
+                BYTES_PER_PROOF
+            )
+        );
+    }
+
+    Napi::Array tuple = Napi::Array::New(env, 2);
+    tuple[(uint32_t)0] = cellArray;
+    tuple[(uint32_t)1] = proofArray;
+    return tuple;
+}
+
 Napi::Value LoadTrustedSetup(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
 
@@ -575,9 +616,6 @@ Napi::Value ComputeCellsAndKzgProofs(const Napi::CallbackInfo &info) {
     C_KZG_RET ret;
     Cell *cells = NULL;
     KZGProof *proofs = NULL;
-    Napi::Array tuple;
-    Napi::Array cellArray;
-    Napi::Array proofArray;
 
     cells = (Cell *)calloc(CELLS_PER_EXT_BLOB, BYTES_PER_CELL);
     if (cells == nullptr) {
@@ -603,27 +641,7 @@ Napi::Value ComputeCellsAndKzgProofs(const Napi::CallbackInfo &info) {
         goto out;
     }
 
-    cellArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
-    proofArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
-    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
-        cellArray.Set(
-            i,
-            Napi::Buffer<uint8_t>::Copy(
-                env, reinterpret_cast<uint8_t *>(&cells[i]), BYTES_PER_CELL
-            )
-        );
-        proofArray.Set(
-            i,
-            Napi::Buffer<uint8_t>::Copy(
-                env, reinterpret_cast<uint8_t *>(&proofs[i]), BYTES_PER_PROOF
-            )
-        );
-    }
-
-    tuple = Napi::Array::New(env, 2);
-    tuple[(uint32_t)0] = cellArray;
-    tuple[(uint32_t)1] = proofArray;
-    result = tuple;
+    result = cells_and_proofs_to_tuple(env, cells, proofs);
 
 out:
     free(cells);
@@ -648,9 +666,6 @@ Napi::Value RecoverCellsAndKzgProofs(const Napi::CallbackInfo &info) {
     Cell *cells = NULL;
     Cell *recovered_cells = NULL;
     KZGProof *recovered_proofs = NULL;
-    Napi::Array tuple;
-    Napi::Array cellArray;
-    Napi::Array proofArray;
     uint64_t num_cells;
 
     Napi::Env env = info.Env();
@@ -739,31 +754,9 @@ Napi::Value RecoverCellsAndKzgProofs(const Napi::CallbackInfo &info) {
         goto out;
     }
 
-    cellArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
-    proofArray = Napi::Array::New(env, CELLS_PER_EXT_BLOB);
-    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
-        cellArray.Set(
-            i,
-            Napi::Buffer<uint8_t>::Copy(
-                env,
-                reinterpret_cast<uint8_t *>(&recovered_cells[i]),
-                BYTES_PER_CELL
-            )
-        );
-        proofArray.Set(
-            i,
-            Napi::Buffer<uint8_t>::Copy(
-                env,
-                reinterpret_cast<uint8_t *>(&recovered_proofs[i]),
-                BYTES_PER_PROOF
-            )
-        );
-    }
-
-    tuple = Napi::Array::New(env, 2);
-    tuple[(uint32_t)0] = cellArray;
-    tuple[(uint32_t)1] = proofArray;
-    result = tuple;
+    result = cells_and_proofs_to_tuple(
+        env, recovered_cells, recovered_proofs
+    );
 
 out:
     free(cells);
@@ -901,6 +894,520 @@ out:
     return result;
 }
 
+/**
+ * Base class for the asynchronous variants of the heavy functions.
+ *
+ * The arguments are validated on the main thread, where javascript exceptions
+ * can be thrown synchronously. `Execute` then runs the library call on the
+ * libuv threadpool, so it must not touch any javascript values, and the
+ * returned promise is settled back on the main thread.
+ *
+ * The inputs are copied into the worker, so they can be modified as soon as
+ * the function returns.
+ */
+class KzgWorker : public Napi::AsyncWorker {
+  public:
+    KzgWorker(const Napi::Env &env, const char *name, KZGSettings *settings)
+        : Napi::AsyncWorker(env, name),
+          deferred(Napi::Promise::Deferred::New(env)),
+          kzg_settings(settings) {}
+
+    /**
+     * Queue the worker and get the promise for its result.
+     */
+    Napi::Promise Start() {
+        Napi::Promise promise = deferred.Promise();
+        Queue();
+        return promise;
+    }
+
+  protected:
+    void OnOK() override {
+        deferred.Resolve(Result(Env()));
+    }
+
+    void OnError(const Napi::Error &error) override {
+        deferred.Reject(error.Value());
+    }
+
+    /**
+     * Convert the output of `Execute` to javascript, on the main thread.
+     */
+    virtual Napi::Value Result(const Napi::Env &env) = 0;
+
+    /**
+     * Reject the promise with the same message format as the synchronous
+     * functions, naming the asynchronous function.
+     */
+    void Fail(std::string_view context, C_KZG_RET ret) {
+        std::ostringstream msg;
+        msg << "Error in " << context << ": " << from_c_kzg_ret(ret);
+        SetError(msg.str());
+    }
+
+    Napi::Promise::Deferred deferred;
+    KZGSettings *kzg_settings;
+};
+
+class BlobToKzgCommitmentWorker : public KzgWorker {
+  public:
+    BlobToKzgCommitmentWorker(
+        const Napi::Env &env, KZGSettings *settings, const Blob *blob
+    )
+        : KzgWorker(env, "blobToKzgCommitmentAsync", settings), blob(*blob) {}
+
+    Blob blob;
+    KZGCommitment commitment;
+
+  protected:
+    void Execute() override {
+        C_KZG_RET ret = blob_to_kzg_commitment(
+            &commitment, &blob, kzg_settings
+        );
+        if (ret != C_KZG_OK) Fail("blobToKzgCommitmentAsync", ret);
+    }
+
+    Napi::Value Result(const Napi::Env &env) override {
+        return Napi::Buffer<uint8_t>::Copy(
+            env, reinterpret_cast<uint8_t *>(&commitment), BYTES_PER_COMMITMENT
+        );
+    }
+};
+
+/**
+ * Convert a blob to a KZG commitment, off the main thread.
+ *
+ * @param[in] {Blob} blob - The blob representing the polynomial to be
+ *                          committed to
+ *
+ * @return {Promise<KZGCommitment>} - The resulting commitment
+ *
+ * @throws {TypeError} - For invalid arguments
+ */
+Napi::Value BlobToKzgCommitmentAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Blob *blob = get_blob(env, info[0]);
+    if (blob == nullptr) {
+        return env.Null();
+    }
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+
+    auto *worker = new BlobToKzgCommitmentWorker(env, kzg_settings, blob);
+    return worker->Start();
+}
+
+class ComputeBlobKzgProofWorker : public KzgWorker {
+  public:
+    ComputeBlobKzgProofWorker(
+        const Napi::Env &env,
+        KZGSettings *settings,
+        const Blob *blob,
+        const Bytes48 *commitment_bytes
+    )
+        : KzgWorker(env, "computeBlobKzgProofAsync", settings),
+          blob(*blob),
+          commitment_bytes(*commitment_bytes) {}
+
+    Blob blob;
+    Bytes48 commitment_bytes;
+    KZGProof proof;
+
+  protected:
+    void Execute() override {
+        C_KZG_RET ret = compute_blob_kzg_proof(
+            &proof, &blob, &commitment_bytes, kzg_settings
+        );
+        if (ret != C_KZG_OK) Fail("computeBlobKzgProofAsync", ret);
+    }
+
+    Napi::Value Result(const Napi::Env &env) override {
+        return Napi::Buffer<uint8_t>::Copy(
+            env, reinterpret_cast<uint8_t *>(&proof), BYTES_PER_PROOF
+        );
+    }
+};
+
+/**
+ * Given a blob, return the KZG proof that is used to verify it against the
+ * commitment, off the main thread.
+ *
+ * @param[in] {Blob}    blob - The blob (polynomial) to generate a proof for
+ * @param[in] {Bytes48} commitmentBytes - Commitment to verify
+ *
+ * @return {Promise<KZGProof>} - The resulting proof
+ *
+ * @throws {TypeError} - For invalid arguments
+ */
+Napi::Value ComputeBlobKzgProofAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Blob *blob = get_blob(env, info[0]);
+    if (blob == nullptr) {
+        return env.Null();
+    }
+    Bytes48 *commitment_bytes = get_bytes48(env, info[1], "commitmentBytes");
+    if (commitment_bytes == nullptr) {
+        return env.Null();
+    }
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+
+    auto *worker = new ComputeBlobKzgProofWorker(
+        env, kzg_settings, blob, commitment_bytes
+    );
+    return worker->Start();
+}
+
+class VerifyBlobKzgProofBatchWorker : public KzgWorker {
+  public:
+    VerifyBlobKzgProofBatchWorker(const Napi::Env &env, KZGSettings *settings)
+        : KzgWorker(env, "verifyBlobKzgProofBatchAsync", settings) {}
+
+    std::vector<Blob> blobs;
+    std::vector<Bytes48> commitments;
+    std::vector<Bytes48> proofs;
+    bool ok = false;
+
+  protected:
+    void Execute() override {
+        C_KZG_RET ret = verify_blob_kzg_proof_batch(
+            &ok,
+            blobs.data(),
+            commitments.data(),
+            proofs.data(),
+            blobs.size(),
+            kzg_settings
+        );
+        if (ret != C_KZG_OK) Fail("verifyBlobKzgProofBatchAsync", ret);
+    }
+
+    Napi::Value Result(const Napi::Env &env) override {
+        return Napi::Boolean::New(env, ok);
+    }
+};
+
+/**
+ * Given an array of blobs and their proofs, verify that they corresponds to
+ * their provided commitment, off the main thread.
+ *
+ * @remark blobs[0] relates to commitmentBytes[0] and proofBytes[0]
+ *
+ * @param[in] {Blob}    blobs - An array of serialized blobs to verify
+ * @param[in] {Bytes48} commitmentBytes - An array of serialized commitments to
+ *                                        verify
+ * @param[in] {Bytes48} proofBytes - An array of serialized KZG proofs for
+ *                                   verification
+ *
+ * @return {Promise<boolean>} - true/false depending on batch validity
+ *
+ * @throws {TypeError} - For invalid arguments
+ */
+Napi::Value VerifyBlobKzgProofBatchAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!(info[0].IsArray() && info[1].IsArray() && info[2].IsArray())) {
+        Napi::Error::New(
+            env, "Blobs, commitments, and proofs must all be arrays"
+        )
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Array blobs_param = info[0].As<Napi::Array>();
+    Napi::Array commitments_param = info[1].As<Napi::Array>();
+    Napi::Array proofs_param = info[2].As<Napi::Array>();
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+    uint32_t count = blobs_param.Length();
+    if (count != commitments_param.Length() || count != proofs_param.Length()) {
+        Napi::Error::New(
+            env, "Requires equal number of blobs/commitments/proofs"
+        )
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    auto *worker = new VerifyBlobKzgProofBatchWorker(env, kzg_settings);
+    worker->blobs.resize(count);
+    worker->commitments.resize(count);
+    worker->proofs.resize(count);
+    for (uint32_t index = 0; index < count; index++) {
+        // add HandleScope here to release reference to temp values
+        // after each iteration since data is being memcpy
+        Napi::HandleScope scope{env};
+        Blob *blob = get_blob(env, blobs_param[index]);
+        Bytes48 *commitment = blob == nullptr ? nullptr
+                                              : get_bytes48(
+                                                    env,
+                                                    commitments_param[index],
+                                                    "commitmentBytes"
+                                                );
+        Bytes48 *proof = commitment == nullptr
+                             ? nullptr
+                             : get_bytes48(
+                                   env, proofs_param[index], "proofBytes"
+                               );
+        if (proof == nullptr) {
+            delete worker;
+            return env.Null();
+        }
+        memcpy(&worker->blobs[index], blob, BYTES_PER_BLOB);
+        memcpy(&worker->commitments[index], commitment, BYTES_PER_COMMITMENT);
+        memcpy(&worker->proofs[index], proof, BYTES_PER_PROOF);
+    }
+
+    return worker->Start();
+}
+
+class CellsAndKzgProofsWorker : public KzgWorker {
+  public:
+    CellsAndKzgProofsWorker(
+        const Napi::Env &env, const char *name, KZGSettings *settings
+    )
+        : KzgWorker(env, name, settings),
+          name(name),
+          cells(CELLS_PER_EXT_BLOB),
+          proofs(CELLS_PER_EXT_BLOB) {}
+
+    /* The input blob, for computeCellsAndKzgProofsAsync */
+    Blob blob;
+    bool has_blob = false;
+    /* The input cells, for recoverCellsAndKzgProofsAsync */
+    std::vector<uint64_t> cell_indices;
+    std::vector<Cell> input_cells;
+
+  protected:
+    void Execute() override {
+        C_KZG_RET ret;
+        if (has_blob) {
+            ret = compute_cells_and_kzg_proofs(
+                cells.data(), proofs.data(), &blob, kzg_settings
+            );
+        } else {
+            ret = recover_cells_and_kzg_proofs(
+                cells.data(),
+                proofs.data(),
+                cell_indices.data(),
+                input_cells.data(),
+                input_cells.size(),
+                kzg_settings
+            );
+        }
+        if (ret != C_KZG_OK) Fail(name, ret);
+    }
+
+    Napi::Value Result(const Napi::Env &env) override {
+        return cells_and_proofs_to_tuple(env, cells.data(), proofs.data());
+    }
+
+    const char *name;
+    std::vector<Cell> cells;
+    std::vector<KZGProof> proofs;
+};
+
+/**
+ * Get the cells and proofs for a given blob, off the main thread.
+ *
+ * @param[in] {Blob}    blob - the blob to get cells/proofs for
+ *
+ * @return {Promise<[Cell[], KZGProof[]]>} - A tuple of cells and proofs
+ *
+ * @throws {TypeError} - For invalid arguments
+ */
+Napi::Value ComputeCellsAndKzgProofsAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Blob *blob = get_blob(env, info[0]);
+    if (blob == nullptr) {
+        return env.Null();
+    }
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+
+    auto *worker = new CellsAndKzgProofsWorker(
+        env, "computeCellsAndKzgProofsAsync", kzg_settings
+    );
+    worker->blob = *blob;
+    worker->has_blob = true;
+    return worker->Start();
+}
+
+/**
+ * Given at least 50% of cells, reconstruct the missing cells/proofs, off the
+ * main thread.
+ *
+ * @param[in] {number[]}  cellIndices - The identifiers for the cells you have
+ * @param[in] {Cell[]}    cells - The cells you have
+ *
+ * @return {Promise<[Cell[], KZGProof[]]>} - A tuple of cells and proofs
+ *
+ * @throws {Error} - Invalid input
+ */
+Napi::Value RecoverCellsAndKzgProofsAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!info[0].IsArray()) {
+        Napi::Error::New(env, "CellIndices must be an array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    if (!info[1].IsArray()) {
+        Napi::Error::New(env, "Cells must be an array")
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+
+    Napi::Array cell_indices_param = info[0].As<Napi::Array>();
+    Napi::Array cells_param = info[1].As<Napi::Array>();
+    if (cell_indices_param.Length() != cells_param.Length()) {
+        Napi::Error::New(
+            env, "There must equal lengths of cellIndices and cells"
+        )
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    uint32_t num_cells = cells_param.Length();
+    auto *worker = new CellsAndKzgProofsWorker(
+        env, "recoverCellsAndKzgProofsAsync", kzg_settings
+    );
+    worker->cell_indices.resize(num_cells);
+    worker->input_cells.resize(num_cells);
+    for (uint32_t i = 0; i < num_cells; i++) {
+        // add HandleScope here to release reference to temp values
+        // after each iteration since data is being memcpy
+        Napi::HandleScope scope{env};
+        worker->cell_indices[i] = get_cell_index(env, cell_indices_param[i]);
+        Cell *cell = env.IsExceptionPending() ? nullptr
+                                              : get_cell(env, cells_param[i]);
+        if (cell == nullptr) {
+            delete worker;
+            return env.Null();
+        }
+        memcpy(&worker->input_cells[i], cell, BYTES_PER_CELL);
+    }
+
+    return worker->Start();
+}
+
+class VerifyCellKzgProofBatchWorker : public KzgWorker {
+  public:
+    VerifyCellKzgProofBatchWorker(const Napi::Env &env, KZGSettings *settings)
+        : KzgWorker(env, "verifyCellKzgProofBatchAsync", settings) {}
+
+    std::vector<Bytes48> commitments;
+    std::vector<uint64_t> cell_indices;
+    std::vector<Cell> cells;
+    std::vector<Bytes48> proofs;
+    bool ok = false;
+
+  protected:
+    void Execute() override {
+        C_KZG_RET ret = verify_cell_kzg_proof_batch(
+            &ok,
+            commitments.data(),
+            cell_indices.data(),
+            cells.data(),
+            proofs.data(),
+            cells.size(),
+            kzg_settings
+        );
+        if (ret != C_KZG_OK) Fail("verifyCellKzgProofBatchAsync", ret);
+    }
+
+    Napi::Value Result(const Napi::Env &env) override {
+        return Napi::Boolean::New(env, ok);
+    }
+};
+
+/**
+ * Verify that multiple cells' proofs are valid, off the main thread.
+ *
+ * @param[in] {Bytes48[]} commitmentsBytes - The commitments for each cell
+ * @param[in] {number[]}  cellIndices - The cell index for each cell
+ * @param[in] {Cell[]}    cells - The cells to verify
+ * @param[in] {Bytes48[]} proofsBytes - The proof for each cell
+ *
+ * @return {Promise<boolean>} - True if the cells are valid with respect to the
+ * given commitments
+ *
+ * @throws {Error} - Invalid input
+ */
+Napi::Value VerifyCellKzgProofBatchAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!(info[0].IsArray() && info[1].IsArray() && info[2].IsArray() &&
+          info[3].IsArray())) {
+        Napi::Error::New(
+            env, "commitments, cell_indices, cells, and proofs must be arrays"
+        )
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    Napi::Array commitments_param = info[0].As<Napi::Array>();
+    Napi::Array cell_indices_param = info[1].As<Napi::Array>();
+    Napi::Array cells_param = info[2].As<Napi::Array>();
+    Napi::Array proofs_param = info[3].As<Napi::Array>();
+    KZGSettings *kzg_settings = get_kzg_settings(env, info);
+    if (kzg_settings == nullptr) {
+        return env.Null();
+    }
+
+    uint32_t num_cells = cells_param.Length();
+    if (commitments_param.Length() != num_cells ||
+        cell_indices_param.Length() != num_cells ||
+        proofs_param.Length() != num_cells) {
+        Napi::Error::New(
+            env,
+            "Must have equal lengths for commitments, cell_indices, cells, "
+            "and proofs"
+        )
+            .ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    auto *worker = new VerifyCellKzgProofBatchWorker(env, kzg_settings);
+    worker->commitments.resize(num_cells);
+    worker->cell_indices.resize(num_cells);
+    worker->cells.resize(num_cells);
+    worker->proofs.resize(num_cells);
+    for (uint32_t i = 0; i < num_cells; i++) {
+        // add HandleScope here to release reference to temp values
+        // after each iteration since data is being memcpy
+        Napi::HandleScope scope{env};
+        Bytes48 *commitment = get_bytes48(
+            env, commitments_param[i], "commitmentBytes"
+        );
+        if (commitment != nullptr) {
+            worker->cell_indices[i] = get_cell_index(
+                env, cell_indices_param[i]
+            );
+        }
+        Cell *cell = commitment == nullptr || env.IsExceptionPending()
+                         ? nullptr
+                         : get_cell(env, cells_param[i]);
+        Bytes48 *proof = cell == nullptr
+                             ? nullptr
+                             : get_bytes48(env, proofs_param[i], "proofBytes");
+        if (proof == nullptr) {
+            delete worker;
+            return env.Null();
+        }
+        memcpy(&worker->commitments[i], commitment, BYTES_PER_COMMITMENT);
+        memcpy(&worker->cells[i], cell, BYTES_PER_CELL);
+        memcpy(&worker->proofs[i], proof, BYTES_PER_PROOF);
+    }
+
+    return worker->Start();
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     KzgAddonData *data = (KzgAddonData *)malloc(sizeof(KzgAddonData));
     if (data == nullptr) {
@@ -950,6 +1457,26 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
         env, VerifyCellKzgProofBatch, "verifyCellKzgProofBatch"
     );
 
+    // Asynchronous functions, which run on the libuv threadpool
+    exports["blobToKzgCommitmentAsync"] = Napi::Function::New(
+        env, BlobToKzgCommitmentAsync, "blobToKzgCommitmentAsync"
+    );
+    exports["computeBlobKzgProofAsync"] = Napi::Function::New(
+        env, ComputeBlobKzgProofAsync, "computeBlobKzgProofAsync"
+    );
+    exports["verifyBlobKzgProofBatchAsync"] = Napi::Function::New(
+        env, VerifyBlobKzgProofBatchAsync, "verifyBlobKzgProofBatchAsync"
+    );
+    exports["computeCellsAndKzgProofsAsync"] = Napi::Function::New(
+        env, ComputeCellsAndKzgProofsAsync, "computeCellsAndKzgProofsAsync"
+    );
+    exports["recoverCellsAndKzgProofsAsync"] = Napi::Function::New(
+        env, RecoverCellsAndKzgProofsAsync, "recoverCellsAndKzgProofsAsync"
+    );
+    exports["verifyCellKzgProofBatchAsync"] = Napi::Function::New(
+        env, VerifyCellKzgProofBatchAsync, "verifyCellKzgProofBatchAsync"
+    );
+
     // Constants
     exports["BYTES_PER_BLOB"] = Napi::Number::New(env, BYTES_PER_BLOB);
     exports["BYTES_PER_COMMITMENT"] = Napi::Number::New(
@@ -29,6 +29,14 @@ const {
   computeCellsAndKzgProofs,
   verifyCellKzgProofBatch,
   recoverCellsAndKzgProofs,
+
+  // Asynchronous variants
+  blobToKzgCommitmentAsync,
+  computeBlobKzgProofAsync,
+  verifyBlobKzgProofBatchAsync,
+  computeCellsAndKzgProofsAsync,
+  recoverCellsAndKzgProofsAsync,
+  verifyCellKzgProofBatchAsync,
 } = kzg;
 
 // not exported by types, only exported for testing purposes
@@ -690,4 +698,188 @@ describe("C-KZG", () => {
       );
     });
   });
+
+  describe("asynchronous variants", () => {
+    const blob = generateRandomBlob();
+    // Every field element is above the modulus, so the library rejects it
+    const badBlob = new Uint8Array(BYTES_PER_BLOB).fill(0xff);
+    // Not a point on the curve
+    const badCommitment = new Uint8Array(BYTES_PER_COMMITMENT).fill(0xff);
+    let commitment: Uint8Array;
+    let proof: Uint8Array;
+    let cells: Uint8Array[];
+    let cellProofs: Uint8Array[];
+    let cellIndices: number[];
+    let partialCells: Uint8Array[];
+
+    beforeAll(() => {
+      commitment = blobToKzgCommitment(blob);
+      proof = computeBlobKzgProof(blob, commitment);
+      [cells, cellProofs] = computeCellsAndKzgProofs(blob);
+      cellIndices = Array.from({length: cells.length / 2}, (_, i) => i * 2);
+      partialCells = cellIndices.map((i) => cells[i]);
+    });
+
+    describe("blobToKzgCommitmentAsync", () => {
+      it("should match blobToKzgCommitment", async () => {
+        expect(await blobToKzgCommitmentAsync(blob)).toEqual(commitment);
+      });
+
+      it("should throw synchronously for an argument of invalid length", () => {
+        expect(() => blobToKzgCommitmentAsync(blobBadLength)).toThrowError("Expected blob to be 131072 bytes");
+      });
+
+      it("should reject an invalid blob", async () => {
+        await expect(blobToKzgCommitmentAsync(badBlob)).rejects.toThrow(
+          "Error in blobToKzgCommitmentAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    describe("computeBlobKzgProofAsync", () => {
+      it("should match computeBlobKzgProof", async () => {
+        expect(await computeBlobKzgProofAsync(blob, commitment)).toEqual(proof);
+      });
+
+      it("should throw synchronously for an argument of invalid length", () => {
+        expect(() => computeBlobKzgProofAsync(blob, commitmentBadLength)).toThrowError(
+          "Expected commitmentBytes to be 48 bytes"
+        );
+      });
+
+      it("should reject an invalid commitment", async () => {
+        await expect(computeBlobKzgProofAsync(blob, badCommitment)).rejects.toThrow(
+          "Error in computeBlobKzgProofAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    describe("verifyBlobKzgProofBatchAsync", () => {
+      it("should match verifyBlobKzgProofBatch", async () => {
+        expect(await verifyBlobKzgProofBatchAsync([blob], [commitment], [proof])).toBe(true);
+        expect(await verifyBlobKzgProofBatchAsync([blob, blob], [commitment, commitment], [proof, commitment])).toBe(
+          false
+        );
+        expect(await verifyBlobKzgProofBatchAsync([], [], [])).toBe(true);
+      });
+
+      it("should throw synchronously for mismatched lengths", () => {
+        expect(() => verifyBlobKzgProofBatchAsync([blob], [], [])).toThrowError(
+          "Requires equal number of blobs/commitments/proofs"
+        );
+      });
+
+      it("should reject an invalid commitment", async () => {
+        await expect(verifyBlobKzgProofBatchAsync([blob], [badCommitment], [proof])).rejects.toThrow(
+          "Error in verifyBlobKzgProofBatchAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    describe("computeCellsAndKzgProofsAsync", () => {
+      it("should match computeCellsAndKzgProofs", async () => {
+        expect(await computeCellsAndKzgProofsAsync(blob)).toEqual([cells, cellProofs]);
+      });
+
+      it("should throw synchronously for an argument of invalid length", () => {
+        expect(() => computeCellsAndKzgProofsAsync(blobBadLength)).toThrowError("Expected blob to be 131072 bytes");
+      });
+
+      it("should reject an invalid blob", async () => {
+        await expect(computeCellsAndKzgProofsAsync(badBlob)).rejects.toThrow(
+          "Error in computeCellsAndKzgProofsAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    describe("recoverCellsAndKzgProofsAsync", () => {
+      it("should match recoverCellsAndKzgProofs", async () => {
+        expect(await recoverCellsAndKzgProofsAsync(cellIndices, partialCells)).toEqual([cells, cellProofs]);
+      });
+
+      it("should throw synchronously for mismatched lengths", () => {
+        expect(() => recoverCellsAndKzgProofsAsync([0], [])).toThrowError(
+          "There must equal lengths of cellIndices and cells"
+        );
+      });
+
+      it("should reject too few cells", async () => {
+        await expect(recoverCellsAndKzgProofsAsync([0], [cells[0]])).rejects.toThrow(
+          "Error in recoverCellsAndKzgProofsAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    describe("verifyCellKzgProofBatchAsync", () => {
+      it("should match verifyCellKzgProofBatch", async () => {
+        const commitments = cellIndices.map(() => commitment);
+        const partialProofs = cellIndices.map((i) => cellProofs[i]);
+        expect(await verifyCellKzgProofBatchAsync(commitments, cellIndices, partialCells, partialProofs)).toBe(true);
+        expect(await verifyCellKzgProofBatchAsync([commitment], [0], [cells[0]], [cellProofs[1]])).toBe(false);
+      });
+
+      it("should throw synchronously for mismatched lengths", () => {
+        expect(() => verifyCellKzgProofBatchAsync([commitment], [0], [], [])).toThrowError(
+          "Must have equal lengths for commitments, cell_indices, cells, and proofs"
+        );
+      });
+
+      it("should reject an invalid commitment", async () => {
+        await expect(verifyCellKzgProofBatchAsync([badCommitment], [0], [cells[0]], [cellProofs[0]])).rejects.toThrow(
+          "Error in verifyCellKzgProofBatchAsync: C_KZG_BADARGS"
+        );
+      });
+    });
+
+    it("should copy the inputs before returning", async () => {
+      // Clear every input as soon as each call returns, which must not change the results
+      const copy = (bytes: Uint8Array): Uint8Array => new Uint8Array(bytes);
+      const inputs: Uint8Array[] = [];
+      const track = (bytes: Uint8Array): Uint8Array => {
+        const tracked = copy(bytes);
+        inputs.push(tracked);
+        return tracked;
+      };
+      const commitmentPromise = blobToKzgCommitmentAsync(track(blob));
+      const proofPromise = computeBlobKzgProofAsync(track(blob), track(commitment));
+      const batchPromise = verifyBlobKzgProofBatchAsync([track(blob)], [track(commitment)], [track(proof)]);
+      const cellsPromise = computeCellsAndKzgProofsAsync(track(blob));
+      const recoverPromise = recoverCellsAndKzgProofsAsync(cellIndices, partialCells.map(track));
+      const cellBatchPromise = verifyCellKzgProofBatchAsync(
+        [track(commitment)],
+        [0],
+        [track(cells[0])],
+        [track(cellProofs[0])]
+      );
+      for (const input of inputs) {
+        input.fill(0);
+      }
+
+      expect(await commitmentPromise).toEqual(commitment);
+      expect(await proofPromise).toEqual(proof);
+      expect(await batchPromise).toBe(true);
+      expect(await cellsPromise).toEqual([cells, cellProofs]);
+      expect(await recoverPromise).toEqual([cells, cellProofs]);
+      expect(await cellBatchPromise).toBe(true);
+    });
+
+    it("should not block the event loop", async () => {
+      // Count event loop turns until the promises settle, none would run if the work was synchronous
+      let turns = 0;
+      let settled = false;
+      const turn = (): void => {
+        if (!settled) {
+          turns++;
+          setImmediate(turn);
+        }
+      };
+      setImmediate(turn);
+      const commitments = await Promise.all([blob, blob, blob, blob].map((b) => blobToKzgCommitmentAsync(b)));
+      settled = true;
+      expect(turns).toBeGreaterThan(0);
+      for (const c of commitments) {
+        expect(c).toEqual(commitment);
+      }
+    });
+  });
 });
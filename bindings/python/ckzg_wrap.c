@@ -3,6 +3,97 @@
 #include <Python.h>
 #include <stdbool.h>
 
+/*
+ * Inputs can be any object which supports the buffer protocol (bytes,
+ * bytearray, memoryview, numpy arrays, ...). They are used in place rather than
+ * copied, and the views keep them alive and unresizable while the GIL is
+ * released.
+ */
+
+/* Get a contiguous view of a bytes-like object of exactly `size` bytes */
+static bool get_buffer(Py_buffer *view, PyObject *obj, Py_ssize_t size,
+                       const char *name, const char *size_name) {
+  if (PyObject_GetBuffer(obj, view, PyBUF_SIMPLE) != 0) {
+    PyErr_Format(PyExc_ValueError, "expected %s to be bytes-like", name);
+    return false;
+  }
+  if (view->len != size) {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_ValueError, "expected %s to be %s bytes", name,
+                 size_name);
+    return false;
+  }
+  return true;
+}
+
+/* Get a contiguous view of a bytes-like object of `count` items of `size` */
+static bool get_buffer_array(Py_buffer *view, Py_ssize_t *count, PyObject *obj,
+                             Py_ssize_t size, const char *name,
+                             const char *size_name) {
+  if (PyObject_GetBuffer(obj, view, PyBUF_SIMPLE) != 0) {
+    PyErr_Format(PyExc_ValueError, "expected %s to be bytes-like", name);
+    return false;
+  }
+  if (view->len % size != 0) {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_ValueError, "expected %s to be a multiple of %s bytes",
+                 name, size_name);
+    return false;
+  }
+  *count = view->len / size;
+  return true;
+}
+
+/* An array of fixed-size items, from a list or from one bytes-like object */
+typedef struct {
+  Py_buffer view;
+  bool has_view;
+  void *copy;
+  const void *data;
+  Py_ssize_t count;
+} ItemArray;
+
+/*
+ * Get an array of fixed-size items. A single bytes-like object with the items
+ * back to back is used in place, while a list of bytes-like items is copied.
+ */
+static bool get_item_array(ItemArray *out, PyObject *obj, Py_ssize_t size,
+                           const char *name, const char *size_name) {
+  memset(out, 0, sizeof(*out));
+
+  if (!PyList_Check(obj)) {
+    if (!get_buffer_array(&out->view, &out->count, obj, size, name,
+                          size_name))
+      return false;
+    out->has_view = true;
+    out->data = out->view.buf;
+    return true;
+  }
+
+  out->count = PyList_Size(obj);
+  out->copy = calloc(out->count > 0 ? out->count : 1, size);
+  if (out->copy == NULL) {
+    PyErr_NoMemory();
+    return false;
+  }
+  for (Py_ssize_t i = 0; i < out->count; i++) {
+    Py_buffer item;
+    if (!get_buffer(&item, PyList_GetItem(obj, i), size, name, size_name))
+      return false;
+    memcpy((uint8_t *)out->copy + i * size, item.buf, size);
+    PyBuffer_Release(&item);
+  }
+  out->data = out->copy;
+  return true;
+}
+
+static void release_item_array(ItemArray *a) {
+  if (a->has_view)
+    PyBuffer_Release(&a->view);
+  free(a->copy);
+  memset(a, 0, sizeof(*a));
+}
+
 static void free_KZGSettings(PyObject *c) {
   KZGSettings *s = PyCapsule_GetPointer(c, "KZGSettings");
   free_trusted_setup(s);
@@ -13,6 +104,7 @@ static PyObject *load_trusted_setup_wrap(PyObject *self, PyObject *args) {
   PyObject *f;
   PyObject *precompute;
   FILE *fp;
+  C_KZG_RET ret;
 
   if (!PyArg_UnpackTuple(args, "load_trusted_setup", 2, 2, &f, &precompute) ||
       !PyUnicode_Check(f)) {
@@ -34,7 +126,9 @@ static PyObject *load_trusted_setup_wrap(PyObject *self, PyObject *args) {
     return PyErr_Format(PyExc_RuntimeError, "error reading trusted setup");
   }
 
-  C_KZG_RET ret = load_trusted_setup_file(s, fp, precompute_value);
+  Py_BEGIN_ALLOW_THREADS
+  ret = load_trusted_setup_file(s, fp, precompute_value);
+  Py_END_ALLOW_THREADS
   fclose(fp);
 
   if (ret != C_KZG_OK) {
@@ -48,23 +142,30 @@ static PyObject *load_trusted_setup_wrap(PyObject *self, PyObject *args) {
 static PyObject *blob_to_kzg_commitment_wrap(PyObject *self, PyObject *args) {
   PyObject *b;
   PyObject *s;
+  Py_buffer blob;
+  C_KZG_RET ret;
 
   if (!PyArg_UnpackTuple(args, "blob_to_kzg_commitment_wrap", 2, 2, &b, &s) ||
-      !PyBytes_Check(b) || !PyCapsule_IsValid(s, "KZGSettings"))
+      !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError, "expected bytes and trusted setup");
 
-  if (PyBytes_Size(b) != BYTES_PER_BLOB)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected blobs to be BYTES_PER_BLOB bytes");
+  if (!get_buffer(&blob, b, BYTES_PER_BLOB, "blob", "BYTES_PER_BLOB"))
+    return NULL;
 
   PyObject *out = PyBytes_FromStringAndSize(NULL, BYTES_PER_COMMITMENT);
-  if (out == NULL)
+  if (out == NULL) {
+    PyBuffer_Release(&blob);
     return PyErr_NoMemory();
+  }
 
-  Blob *blob = (Blob *)PyBytes_AsString(b);
   KZGCommitment *k = (KZGCommitment *)PyBytes_AsString(out);
-  if (blob_to_kzg_commitment(k, blob, PyCapsule_GetPointer(s, "KZGSettings")) !=
-      C_KZG_OK) {
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = blob_to_kzg_commitment(k, blob.buf, settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&blob);
+
+  if (ret != C_KZG_OK) {
     Py_DECREF(out);
     return PyErr_Format(PyExc_RuntimeError, "blob_to_kzg_commitment failed");
   }
@@ -74,71 +175,92 @@ static PyObject *blob_to_kzg_commitment_wrap(PyObject *self, PyObject *args) {
 
 static PyObject *compute_kzg_proof_wrap(PyObject *self, PyObject *args) {
   PyObject *b, *z, *s;
+  Py_buffer blob, z_bytes;
+  C_KZG_RET ret;
 
   if (!PyArg_UnpackTuple(args, "compute_kzg_proof_wrap", 3, 3, &b, &z, &s) ||
-      !PyBytes_Check(b) || !PyBytes_Check(z) ||
       !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError,
                         "expected bytes, bytes, trusted setup");
 
-  if (PyBytes_Size(b) != BYTES_PER_BLOB)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected blobs to be BYTES_PER_BLOB bytes");
-  if (PyBytes_Size(z) != BYTES_PER_FIELD_ELEMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected blobs to be BYTES_PER_FIELD_ELEMENT bytes");
+  if (!get_buffer(&blob, b, BYTES_PER_BLOB, "blob", "BYTES_PER_BLOB"))
+    return NULL;
+  if (!get_buffer(&z_bytes, z, BYTES_PER_FIELD_ELEMENT, "z",
+                  "BYTES_PER_FIELD_ELEMENT")) {
+    PyBuffer_Release(&blob);
+    return NULL;
+  }
 
   PyObject *py_y = PyBytes_FromStringAndSize(NULL, BYTES_PER_FIELD_ELEMENT);
-  if (py_y == NULL)
-    return PyErr_NoMemory();
   PyObject *py_proof = PyBytes_FromStringAndSize(NULL, BYTES_PER_PROOF);
-  if (py_proof == NULL)
-    return PyErr_NoMemory();
-
-  PyObject *out = PyTuple_Pack(2, py_proof, py_y);
-  if (out == NULL)
+  if (py_y == NULL || py_proof == NULL) {
+    Py_XDECREF(py_y);
+    Py_XDECREF(py_proof);
+    PyBuffer_Release(&blob);
+    PyBuffer_Release(&z_bytes);
     return PyErr_NoMemory();
+  }
 
-  Blob *blob = (Blob *)PyBytes_AsString(b);
-  Bytes32 *z_bytes = (Bytes32 *)PyBytes_AsString(z);
   KZGProof *proof = (KZGProof *)PyBytes_AsString(py_proof);
   Bytes32 *y_bytes = (Bytes32 *)PyBytes_AsString(py_y);
-  if (compute_kzg_proof(proof, y_bytes, blob, z_bytes,
-                        PyCapsule_GetPointer(s, "KZGSettings")) != C_KZG_OK) {
-    Py_DECREF(out);
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = compute_kzg_proof(proof, y_bytes, blob.buf, z_bytes.buf, settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&blob);
+  PyBuffer_Release(&z_bytes);
+
+  if (ret != C_KZG_OK) {
+    Py_DECREF(py_y);
+    Py_DECREF(py_proof);
     return PyErr_Format(PyExc_RuntimeError, "compute_kzg_proof failed");
   }
 
+  /* The tuple takes its own references */
+  PyObject *out = PyTuple_Pack(2, py_proof, py_y);
+  Py_DECREF(py_y);
+  Py_DECREF(py_proof);
+  if (out == NULL)
+    return PyErr_NoMemory();
+
   return out;
 }
 
 static PyObject *compute_blob_kzg_proof_wrap(PyObject *self, PyObject *args) {
   PyObject *b, *c, *s;
+  Py_buffer blob, commitment;
+  C_KZG_RET ret;
 
   if (!PyArg_UnpackTuple(args, "compute_blob_kzg_proof_wrap", 3, 3, &b, &c,
                          &s) ||
-      !PyBytes_Check(b) || !PyBytes_Check(c) ||
       !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError,
                         "expected bytes, bytes, trusted setup");
 
-  if (PyBytes_Size(b) != BYTES_PER_BLOB)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected blobs to be BYTES_PER_BLOB bytes");
-  if (PyBytes_Size(c) != BYTES_PER_COMMITMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected commitment to be BYTES_PER_COMMITMENT bytes");
+  if (!get_buffer(&blob, b, BYTES_PER_BLOB, "blob", "BYTES_PER_BLOB"))
+    return NULL;
+  if (!get_buffer(&commitment, c, BYTES_PER_COMMITMENT, "commitment",
+                  "BYTES_PER_COMMITMENT")) {
+    PyBuffer_Release(&blob);
+    return NULL;
+  }
 
   PyObject *out = PyBytes_FromStringAndSize(NULL, BYTES_PER_PROOF);
-  if (out == NULL)
+  if (out == NULL) {
+    PyBuffer_Release(&blob);
+    PyBuffer_Release(&commitment);
     return PyErr_NoMemory();
+  }
 
-  Blob *blob = (Blob *)PyBytes_AsString(b);
-  Bytes48 *commitment_bytes = (Bytes48 *)PyBytes_AsString(c);
   KZGProof *proof = (KZGProof *)PyBytes_AsString(out);
-  if (compute_blob_kzg_proof(proof, blob, commitment_bytes,
-                             PyCapsule_GetPointer(s, "KZGSettings")) !=
-      C_KZG_OK) {
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = compute_blob_kzg_proof(proof, blob.buf, commitment.buf, settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&blob);
+  PyBuffer_Release(&commitment);
+
+  if (ret != C_KZG_OK) {
     Py_DECREF(out);
     return PyErr_Format(PyExc_RuntimeError, "compute_blob_kzg_proof failed");
   }
@@ -148,34 +270,38 @@ static PyObject *compute_blob_kzg_proof_wrap(PyObject *self, PyObject *args) {
 
 static PyObject *verify_kzg_proof_wrap(PyObject *self, PyObject *args) {
   PyObject *c, *z, *y, *p, *s;
+  Py_buffer commitment, z_bytes, y_bytes, proof;
+  C_KZG_RET ret;
+  bool ok;
 
   if (!PyArg_UnpackTuple(args, "verify_kzg_proof", 5, 5, &c, &z, &y, &p, &s) ||
-      !PyBytes_Check(c) || !PyBytes_Check(z) || !PyBytes_Check(y) ||
-      !PyBytes_Check(p) || !PyCapsule_IsValid(s, "KZGSettings"))
+      !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError,
                         "expected bytes, bytes, bytes, bytes, trusted setup");
 
-  if (PyBytes_Size(c) != BYTES_PER_COMMITMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected commitment to be BYTES_PER_COMMITMENT bytes");
-  if (PyBytes_Size(z) != BYTES_PER_FIELD_ELEMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected z to be BYTES_PER_FIELD_ELEMENT bytes");
-  if (PyBytes_Size(y) != BYTES_PER_FIELD_ELEMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected y to be BYTES_PER_FIELD_ELEMENT bytes");
-  if (PyBytes_Size(p) != BYTES_PER_PROOF)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected proof to be BYTES_PER_PROOF bytes");
+  if (!get_buffer(&commitment, c, BYTES_PER_COMMITMENT, "commitment",
+                  "BYTES_PER_COMMITMENT"))
+    return NULL;
+  if (!get_buffer(&z_bytes, z, BYTES_PER_FIELD_ELEMENT, "z",
+                  "BYTES_PER_FIELD_ELEMENT"))
+    goto release_commitment;
+  if (!get_buffer(&y_bytes, y, BYTES_PER_FIELD_ELEMENT, "y",
+                  "BYTES_PER_FIELD_ELEMENT"))
+    goto release_z;
+  if (!get_buffer(&proof, p, BYTES_PER_PROOF, "proof", "BYTES_PER_PROOF"))
+    goto release_y;
+
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = verify_kzg_proof(&ok, commitment.buf, z_bytes.buf, y_bytes.buf,
+                         proof.buf, settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&commitment);
+  PyBuffer_Release(&z_bytes);
+  PyBuffer_Release(&y_bytes);
+  PyBuffer_Release(&proof);
 
-  const Bytes48 *commitment_bytes = (Bytes48 *)PyBytes_AsString(c);
-  const Bytes32 *z_bytes = (Bytes32 *)PyBytes_AsString(z);
-  const Bytes32 *y_bytes = (Bytes32 *)PyBytes_AsString(y);
-  const Bytes48 *proof_bytes = (Bytes48 *)PyBytes_AsString(p);
-
-  bool ok;
-  if (verify_kzg_proof(&ok, commitment_bytes, z_bytes, y_bytes, proof_bytes,
-                       PyCapsule_GetPointer(s, "KZGSettings")) != C_KZG_OK) {
+  if (ret != C_KZG_OK) {
     return PyErr_Format(PyExc_RuntimeError, "verify_kzg_proof failed");
   }
 
@@ -183,35 +309,45 @@ static PyObject *verify_kzg_proof_wrap(PyObject *self, PyObject *args) {
     Py_RETURN_TRUE;
   else
     Py_RETURN_FALSE;
+
+release_y:
+  PyBuffer_Release(&y_bytes);
+release_z:
+  PyBuffer_Release(&z_bytes);
+release_commitment:
+  PyBuffer_Release(&commitment);
+  return NULL;
 }
 
 static PyObject *verify_blob_kzg_proof_wrap(PyObject *self, PyObject *args) {
   PyObject *b, *c, *p, *s;
+  Py_buffer blob, commitment, proof;
+  C_KZG_RET ret;
+  bool ok;
 
   if (!PyArg_UnpackTuple(args, "verify_blob_kzg_proof", 4, 4, &b, &c, &p, &s) ||
-      !PyBytes_Check(b) || !PyBytes_Check(c) || !PyBytes_Check(p) ||
       !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError,
                         "expected bytes, bytes, bytes, trusted setup");
 
-  if (PyBytes_Size(b) != BYTES_PER_BLOB)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected blob to be BYTES_PER_BLOB bytes");
-  if (PyBytes_Size(c) != BYTES_PER_COMMITMENT)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected commitment to be BYTES_PER_COMMITMENT bytes");
-  if (PyBytes_Size(p) != BYTES_PER_PROOF)
-    return PyErr_Format(PyExc_ValueError,
-                        "expected proof to be BYTES_PER_PROOF bytes");
-
-  const Blob *blob_bytes = (Blob *)PyBytes_AsString(b);
-  const Bytes48 *commitment_bytes = (Bytes48 *)PyBytes_AsString(c);
-  const Bytes48 *proof_bytes = (Bytes48 *)PyBytes_AsString(p);
+  if (!get_buffer(&blob, b, BYTES_PER_BLOB, "blob", "BYTES_PER_BLOB"))
+    return NULL;
+  if (!get_buffer(&commitment, c, BYTES_PER_COMMITMENT, "commitment",
+                  "BYTES_PER_COMMITMENT"))
+    goto release_blob;
+  if (!get_buffer(&proof, p, BYTES_PER_PROOF, "proof", "BYTES_PER_PROOF"))
+    goto release_commitment;
+
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = verify_blob_kzg_proof(&ok, blob.buf, commitment.buf, proof.buf,
+                              settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&blob);
+  PyBuffer_Release(&commitment);
+  PyBuffer_Release(&proof);
 
-  bool ok;
-  if (verify_blob_kzg_proof(&ok, blob_bytes, commitment_bytes, proof_bytes,
-                            PyCapsule_GetPointer(s, "KZGSettings")) !=
-      C_KZG_OK) {
+  if (ret != C_KZG_OK) {
     return PyErr_Format(PyExc_RuntimeError, "verify_blob_kzg_proof failed");
   }
 
@@ -219,53 +355,55 @@ static PyObject *verify_blob_kzg_proof_wrap(PyObject *self, PyObject *args) {
     Py_RETURN_TRUE;
   else
     Py_RETURN_FALSE;
+
+release_commitment:
+  PyBuffer_Release(&commitment);
+release_blob:
+  PyBuffer_Release(&blob);
+  return NULL;
 }
 
 static PyObject *verify_blob_kzg_proof_batch_wrap(PyObject *self,
                                                   PyObject *args) {
   PyObject *b, *c, *p, *s;
+  Py_buffer blobs, commitments, proofs;
+  Py_ssize_t blobs_count, commitments_count, proofs_count;
+  C_KZG_RET ret;
+  bool ok;
 
   if (!PyArg_UnpackTuple(args, "verify_blob_kzg_proof_batch", 4, 4, &b, &c, &p,
                          &s) ||
-      !PyBytes_Check(b) || !PyBytes_Check(c) || !PyBytes_Check(p) ||
       !PyCapsule_IsValid(s, "KZGSettings"))
     return PyErr_Format(PyExc_ValueError,
                         "expected bytes, bytes, bytes, trusted setup");
 
-  Py_ssize_t blobs_count = PyBytes_Size(b);
-  if (blobs_count % BYTES_PER_BLOB != 0)
-    return PyErr_Format(
-        PyExc_ValueError,
-        "expected blobs to be a multiple of BYTES_PER_BLOB bytes");
-  blobs_count = blobs_count / BYTES_PER_BLOB;
-
-  Py_ssize_t commitments_count = PyBytes_Size(c);
-  if (commitments_count % BYTES_PER_COMMITMENT != 0)
-    return PyErr_Format(
-        PyExc_ValueError,
-        "expected commitments to be a multiple of BYTES_PER_COMMITMENT bytes");
-  commitments_count = commitments_count / BYTES_PER_COMMITMENT;
-
-  Py_ssize_t proofs_count = PyBytes_Size(p);
-  if (proofs_count % BYTES_PER_PROOF != 0)
-    return PyErr_Format(
-        PyExc_ValueError,
-        "expected blobs to be a multiple of BYTES_PER_PROOF bytes");
-  proofs_count = proofs_count / BYTES_PER_PROOF;
+  if (!get_buffer_array(&blobs, &blobs_count, b, BYTES_PER_BLOB, "blobs",
+                        "BYTES_PER_BLOB"))
+    return NULL;
+  if (!get_buffer_array(&commitments, &commitments_count, c,
+                        BYTES_PER_COMMITMENT, "commitments",
+                        "BYTES_PER_COMMITMENT"))
+    goto release_blobs;
+  if (!get_buffer_array(&proofs, &proofs_count, p, BYTES_PER_PROOF, "proofs",
+                        "BYTES_PER_PROOF"))
+    goto release_commitments;
 
   if (blobs_count != commitments_count || blobs_count != proofs_count) {
-    return PyErr_Format(PyExc_ValueError,
-                        "expected same number of blobs/commitments/proofs");
+    PyErr_Format(PyExc_ValueError,
+                 "expected same number of blobs/commitments/proofs");
+    goto release_proofs;
   }
 
-  const Blob *blobs_bytes = (Blob *)PyBytes_AsString(b);
-  const Bytes48 *commitments_bytes = (Bytes48 *)PyBytes_AsString(c);
-  const Bytes48 *proofs_bytes = (Bytes48 *)PyBytes_AsString(p);
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  ret = verify_blob_kzg_proof_batch(&ok, blobs.buf, commitments.buf,
+                                    proofs.buf, blobs_count, settings);
+  Py_END_ALLOW_THREADS
+  PyBuffer_Release(&blobs);
+  PyBuffer_Release(&commitments);
+  PyBuffer_Release(&proofs);
 
-  bool ok;
-  if (verify_blob_kzg_proof_batch(
-          &ok, blobs_bytes, commitments_bytes, proofs_bytes, blobs_count,
-          PyCapsule_GetPointer(s, "KZGSettings")) != C_KZG_OK) {
+  if (ret != C_KZG_OK) {
     return PyErr_Format(PyExc_RuntimeError,
                         "verify_blob_kzg_proof_batch failed");
   }
@@ -274,29 +412,40 @@ static PyObject *verify_blob_kzg_proof_batch_wrap(PyObject *self,
     Py_RETURN_TRUE;
   else
     Py_RETURN_FALSE;
+
+release_proofs:
+  PyBuffer_Release(&proofs);
+release_commitments:
+  PyBuffer_Release(&commitments);
+release_blobs:
+  PyBuffer_Release(&blobs);
+  return NULL;
 }
 
 static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
                                                    PyObject *args) {
   PyObject *input_blob, *s;
   PyObject *ret = NULL;
+  PyObject *output_cells = NULL, *output_proofs = NULL;
+  Py_buffer blob;
+  bool has_blob = false;
   Cell *cells = NULL;
   KZGProof *proofs = NULL;
+  C_KZG_RET c_ret;
 
   /* Ensure inputs are the right types */
   if (!PyArg_UnpackTuple(args, "compute_cells_and_kzg_proofs", 2, 2,
                          &input_blob, &s) ||
-      !PyBytes_Check(input_blob) || !PyCapsule_IsValid(s, "KZGSettings")) {
+      !PyCapsule_IsValid(s, "KZGSettings")) {
     ret = PyErr_Format(PyExc_ValueError, "expected bytes and trusted setup");
     goto out;
   }
 
-  /* Ensure blob is the right size */
-  if (PyBytes_Size(input_blob) != BYTES_PER_BLOB) {
-    ret = PyErr_Format(PyExc_ValueError,
-                       "expected blob to be BYTES_PER_BLOB bytes");
+  /* Ensure blob is bytes-like and the right size */
+  has_blob =
+      get_buffer(&blob, input_blob, BYTES_PER_BLOB, "blob", "BYTES_PER_BLOB");
+  if (!has_blob)
     goto out;
-  }
 
   /* Allocate space for the cells */
   cells = calloc(CELLS_PER_EXT_BLOB, BYTES_PER_CELL);
@@ -314,18 +463,19 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
     goto out;
   }
 
-  /* Call our C function with our inputs */
-  const Blob *blob = (Blob *)PyBytes_AsString(input_blob);
-  if (compute_cells_and_kzg_proofs(cells, proofs, blob,
-                                   PyCapsule_GetPointer(s, "KZGSettings")) !=
-      C_KZG_OK) {
+  /* Call our C function with our inputs, other threads can run meanwhile */
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  c_ret = compute_cells_and_kzg_proofs(cells, proofs, blob.buf, settings);
+  Py_END_ALLOW_THREADS
+  if (c_ret != C_KZG_OK) {
     ret =
         PyErr_Format(PyExc_RuntimeError, "compute_cells_and_kzg_proofs failed");
     goto out;
   }
 
   /* Convert our cells result to a list of bytes objects */
-  PyObject *output_cells = PyList_New(CELLS_PER_EXT_BLOB);
+  output_cells = PyList_New(CELLS_PER_EXT_BLOB);
   if (output_cells == NULL) {
     ret = PyErr_Format(PyExc_MemoryError,
                        "Failed to allocate memory for output cells");
@@ -336,7 +486,6 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
     PyObject *cell_bytes =
         PyBytes_FromStringAndSize((const char *)&cells[i], BYTES_PER_CELL);
     if (cell_bytes == NULL) {
-      Py_DECREF(cell_bytes);
       ret = PyErr_Format(PyExc_MemoryError,
                          "Failed to allocate memory for cell bytes");
       goto out;
@@ -346,7 +495,7 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
   }
 
   /* Convert our proofs result to a list of bytes objects */
-  PyObject *output_proofs = PyList_New(CELLS_PER_EXT_BLOB);
+  output_proofs = PyList_New(CELLS_PER_EXT_BLOB);
   if (output_proofs == NULL) {
     ret = PyErr_Format(PyExc_MemoryError,
                        "Failed to allocate memory for output proofs");
@@ -357,7 +506,6 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
     PyObject *proof_bytes =
         PyBytes_FromStringAndSize((const char *)&proofs[i], BYTES_PER_PROOF);
     if (proof_bytes == NULL) {
-      Py_DECREF(proof_bytes);
       ret = PyErr_Format(PyExc_MemoryError,
                          "Failed to allocate memory for proof bytes");
       goto out;
@@ -366,6 +514,7 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
     PyList_SetItem(output_proofs, i, proof_bytes);
   }
 
+  /* The tuple takes its own references to the lists, ours are dropped below */
   PyObject *cells_and_proofs = PyTuple_Pack(2, output_cells, output_proofs);
   if (cells_and_proofs == NULL) {
     ret = PyErr_Format(PyExc_RuntimeError,
@@ -377,6 +526,10 @@ static PyObject *compute_cells_and_kzg_proofs_wrap(PyObject *self,
   ret = cells_and_proofs;
 
 out:
+  Py_XDECREF(output_cells);
+  Py_XDECREF(output_proofs);
+  if (has_blob)
+    PyBuffer_Release(&blob);
   free(cells);
   free(proofs);
   return ret;
@@ -386,23 +539,32 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
                                                    PyObject *args) {
   PyObject *input_cell_indices, *input_cells, *s;
   PyObject *ret = NULL;
+  PyObject *recovered_cells_list = NULL, *recovered_proofs_list = NULL;
   uint64_t *cell_indices = NULL;
-  Cell *cells = NULL;
+  ItemArray cells;
   Cell *recovered_cells = NULL;
   KZGProof *recovered_proofs = NULL;
+  C_KZG_RET c_ret;
+
+  memset(&cells, 0, sizeof(cells));
 
   /* Ensure inputs are the right types */
   if (!PyArg_UnpackTuple(args, "recover_cells_and_kzg_proofs", 3, 3,
                          &input_cell_indices, &input_cells, &s) ||
-      !PyList_Check(input_cell_indices) || !PyList_Check(input_cells) ||
+      !PyList_Check(input_cell_indices) ||
       !PyCapsule_IsValid(s, "KZGSettings")) {
     ret = PyErr_Format(PyExc_ValueError, "expected list, list, trusted setup");
     goto out;
   }
 
+  /* The cells can be a list of cells or all of the cells back to back */
+  if (!get_item_array(&cells, input_cells, BYTES_PER_CELL, "cell",
+                      "BYTES_PER_CELL"))
+    goto out;
+
   /* Ensure cell indices/cells are the same length */
   Py_ssize_t cell_indices_count = PyList_Size(input_cell_indices);
-  Py_ssize_t cells_count = PyList_Size(input_cells);
+  Py_ssize_t cells_count = cells.count;
   if (cell_indices_count != cells_count) {
     ret = PyErr_Format(PyExc_ValueError,
                        "expected same number of cell_indices and cells");
@@ -435,31 +597,6 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
     memcpy(&cell_indices[i], &value, sizeof(uint64_t));
   }
 
-  /* Allocate space for the cells */
-  cells = (Cell *)calloc(cells_count, BYTES_PER_CELL);
-  if (cells == NULL) {
-    ret =
-        PyErr_Format(PyExc_MemoryError, "Failed to allocate memory for cells");
-    goto out;
-  }
-  for (Py_ssize_t i = 0; i < cells_count; i++) {
-    /* Ensure each cell is bytes */
-    PyObject *cell = PyList_GetItem(input_cells, i);
-    if (!PyBytes_Check(cell)) {
-      ret = PyErr_Format(PyExc_ValueError, "expected cell to be bytes");
-      goto out;
-    }
-    /* Ensure each cell is the right size */
-    Py_ssize_t cell_size = PyBytes_Size(cell);
-    if (cell_size != BYTES_PER_CELL) {
-      ret = PyErr_Format(PyExc_ValueError,
-                         "expected cell to be BYTES_PER_CELL bytes");
-      goto out;
-    }
-    /* The cell is good, copy it to our array */
-    memcpy(&cells[i], PyBytes_AsString(cell), BYTES_PER_CELL);
-  }
-
   /* Allocate space for the recovered cells/proofs */
   recovered_cells = calloc(CELLS_PER_EXT_BLOB, BYTES_PER_CELL);
   if (recovered_cells == NULL) {
@@ -474,23 +611,27 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
     goto out;
   }
 
-  /* Call our C function with our inputs */
-  if (recover_cells_and_kzg_proofs(
-          recovered_cells, recovered_proofs, cell_indices, cells, cells_count,
-          PyCapsule_GetPointer(s, "KZGSettings")) != C_KZG_OK) {
+  /* Call our C function with our inputs, other threads can run meanwhile */
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  c_ret = recover_cells_and_kzg_proofs(recovered_cells, recovered_proofs,
+                                       cell_indices, cells.data, cells_count,
+                                       settings);
+  Py_END_ALLOW_THREADS
+  if (c_ret != C_KZG_OK) {
     ret =
         PyErr_Format(PyExc_RuntimeError, "recover_cells_and_kzg_proofs failed");
     goto out;
   }
 
   /* Convert our result to a list of bytes objects */
-  PyObject *recovered_cells_list = PyList_New(CELLS_PER_EXT_BLOB);
+  recovered_cells_list = PyList_New(CELLS_PER_EXT_BLOB);
   if (recovered_cells_list == NULL) {
     ret = PyErr_Format(PyExc_MemoryError,
                        "Failed to allocate memory for return list of cells");
     goto out;
   }
-  PyObject *recovered_proofs_list = PyList_New(CELLS_PER_EXT_BLOB);
+  recovered_proofs_list = PyList_New(CELLS_PER_EXT_BLOB);
   if (recovered_proofs_list == NULL) {
     ret = PyErr_Format(PyExc_MemoryError,
                        "Failed to allocate memory for return list of proofs");
@@ -501,7 +642,6 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
     PyObject *cell_bytes = PyBytes_FromStringAndSize(
         (const char *)&recovered_cells[i], BYTES_PER_CELL);
     if (cell_bytes == NULL) {
-      Py_DECREF(cell_bytes);
       ret = PyErr_Format(PyExc_MemoryError,
                          "Failed to allocate memory for cell bytes");
       goto out;
@@ -512,7 +652,6 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
     PyObject *proof_bytes = PyBytes_FromStringAndSize(
         (const char *)&recovered_proofs[i], BYTES_PER_PROOF);
     if (proof_bytes == NULL) {
-      Py_DECREF(proof_bytes);
       ret = PyErr_Format(PyExc_MemoryError,
                          "Failed to allocate memory for proof bytes");
       goto out;
@@ -521,7 +660,7 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
     PyList_SetItem(recovered_proofs_list, i, proof_bytes);
   }
 
-  /* Pack recovered cells/proofs into a tuple */
+  /* Pack recovered cells/proofs into a tuple, ours are dropped below */
   PyObject *recovered_cells_and_proofs =
       PyTuple_Pack(2, recovered_cells_list, recovered_proofs_list);
   if (recovered_cells_and_proofs == NULL) {
@@ -534,8 +673,10 @@ static PyObject *recover_cells_and_kzg_proofs_wrap(PyObject *self,
   ret = recovered_cells_and_proofs;
 
 out:
+  Py_XDECREF(recovered_cells_list);
+  Py_XDECREF(recovered_proofs_list);
   free(cell_indices);
-  free(cells);
+  release_item_array(&cells);
   free(recovered_cells);
   free(recovered_proofs);
   return ret;
@@ -546,30 +687,44 @@ static PyObject *verify_cell_kzg_proof_batch_wrap(PyObject *self,
   PyObject *input_commitments, *input_cell_indices, *input_cells, *input_proofs,
       *s;
   PyObject *ret = NULL;
-  Bytes48 *commitments = NULL;
+  ItemArray commitments, cells, proofs;
   uint64_t *cell_indices = NULL;
-  Cell *cells = NULL;
-  Bytes48 *proofs = NULL;
+  C_KZG_RET c_ret;
   bool ok = false;
 
+  memset(&commitments, 0, sizeof(commitments));
+  memset(&cells, 0, sizeof(cells));
+  memset(&proofs, 0, sizeof(proofs));
+
   /* Ensure inputs are the right types */
   if (!PyArg_UnpackTuple(args, "verify_cell_kzg_proof_batch", 5, 5,
                          &input_commitments, &input_cell_indices, &input_cells,
                          &input_proofs, &s) ||
-      !PyList_Check(input_commitments) || !PyList_Check(input_cell_indices) ||
-      !PyList_Check(input_cells) || !PyList_Check(input_proofs) ||
+      !PyList_Check(input_cell_indices) ||
       !PyCapsule_IsValid(s, "KZGSettings")) {
     ret = PyErr_Format(PyExc_ValueError,
                        "expected list, list, list, list, trusted setup");
     goto out;
   }
 
-  /* Ensure input lists are the same length */
-  Py_ssize_t commitments_count = PyList_Size(input_commitments);
+  /*
+   * The commitments, cells and proofs can each be a list of items or all of the
+   * items back to back.
+   */
+  if (!get_item_array(&commitments, input_commitments, BYTES_PER_COMMITMENT,
+                      "commitment", "BYTES_PER_COMMITMENT"))
+    goto out;
+  if (!get_item_array(&cells, input_cells, BYTES_PER_CELL, "cell",
+                      "BYTES_PER_CELL"))
+    goto out;
+  if (!get_item_array(&proofs, input_proofs, BYTES_PER_PROOF, "proof",
+                      "BYTES_PER_PROOF"))
+    goto out;
+
+  /* Ensure inputs are the same length */
   Py_ssize_t cell_indices_count = PyList_Size(input_cell_indices);
-  Py_ssize_t cells_count = PyList_Size(input_cells);
-  Py_ssize_t proofs_count = PyList_Size(input_proofs);
-  if (commitments_count != cells_count) {
+  Py_ssize_t cells_count = cells.count;
+  if (commitments.count != cells_count) {
     ret = PyErr_Format(PyExc_ValueError,
                        "expected same number of commitments and cells");
     goto out;
@@ -579,38 +734,12 @@ static PyObject *verify_cell_kzg_proof_batch_wrap(PyObject *self,
                        "expected same number of column indices and cells");
     goto out;
   }
-  if (proofs_count != cells_count) {
+  if (proofs.count != cells_count) {
     ret = PyErr_Format(PyExc_ValueError,
                        "expected same number of proofs and cells");
     goto out;
   }
 
-  /* Allocate space for the commitments */
-  commitments = (Bytes48 *)calloc(commitments_count, BYTES_PER_COMMITMENT);
-  if (commitments == NULL) {
-    ret = PyErr_Format(PyExc_MemoryError,
-                       "Failed to allocate memory for commitments");
-    goto out;
-  }
-  for (Py_ssize_t i = 0; i < commitments_count; i++) {
-    /* Ensure each commitment is bytes */
-    PyObject *commitment = PyList_GetItem(input_commitments, i);
-    if (!PyBytes_Check(commitment)) {
-      ret = PyErr_Format(PyExc_ValueError, "expected commitment to be bytes");
-      goto out;
-    }
-    /* Ensure each commitment is the right size */
-    Py_ssize_t commitment_size = PyBytes_Size(commitment);
-    if (commitment_size != BYTES_PER_COMMITMENT) {
-      ret =
-          PyErr_Format(PyExc_ValueError,
-                       "expected commitment to be BYTES_PER_COMMITMENT bytes");
-      goto out;
-    }
-    /* The commitment is good, copy it to our array */
-    memcpy(&commitments[i], PyBytes_AsString(commitment), BYTES_PER_COMMITMENT);
-  }
-
   /* Allocate space for the column indices */
   cell_indices = (uint64_t *)calloc(cell_indices_count, sizeof(uint64_t));
   if (cell_indices == NULL) {
@@ -637,60 +766,14 @@ static PyObject *verify_cell_kzg_proof_batch_wrap(PyObject *self,
     memcpy(&cell_indices[i], &value, sizeof(uint64_t));
   }
 
-  /* Allocate space for the cells */
-  cells = (Cell *)calloc(cells_count, BYTES_PER_CELL);
-  if (cells == NULL) {
-    ret =
-        PyErr_Format(PyExc_MemoryError, "Failed to allocate memory for cells");
-    goto out;
-  }
-  for (Py_ssize_t i = 0; i < cells_count; i++) {
-    /* Ensure each cell is bytes */
-    PyObject *cell = PyList_GetItem(input_cells, i);
-    if (!PyBytes_Check(cell)) {
-      ret = PyErr_Format(PyExc_ValueError, "expected cell to be bytes");
-      goto out;
-    }
-    /* Ensure each cell is the right size */
-    Py_ssize_t cell_size = PyBytes_Size(cell);
-    if (cell_size != BYTES_PER_CELL) {
-      ret = PyErr_Format(PyExc_ValueError,
-                         "expected cell to be BYTES_PER_CELL bytes");
-      goto out;
-    }
-    /* The cell is good, copy it to our array */
-    memcpy(&cells[i], PyBytes_AsString(cell), BYTES_PER_CELL);
-  }
-
-  /* Allocate space for the proofs */
-  proofs = (Bytes48 *)calloc(proofs_count, BYTES_PER_PROOF);
-  if (proofs == NULL) {
-    ret =
-        PyErr_Format(PyExc_MemoryError, "Failed to allocate memory for proofs");
-    goto out;
-  }
-  for (Py_ssize_t i = 0; i < proofs_count; i++) {
-    /* Ensure each proof is bytes */
-    PyObject *proof = PyList_GetItem(input_proofs, i);
-    if (!PyBytes_Check(proof)) {
-      ret = PyErr_Format(PyExc_ValueError, "expected proof to be bytes");
-      goto out;
-    }
-    /* Ensure each proof is the right size */
-    Py_ssize_t proof_size = PyBytes_Size(proof);
-    if (proof_size != BYTES_PER_PROOF) {
-      ret = PyErr_Format(PyExc_ValueError,
-                         "expected proof to be BYTES_PER_PROOF bytes");
-      goto out;
-    }
-    /* The proof is good, copy it to our array */
-    memcpy(&proofs[i], PyBytes_AsString(proof), BYTES_PER_PROOF);
-  }
-
-  /* Call our C function with our inputs */
-  if (verify_cell_kzg_proof_batch(
-          &ok, commitments, cell_indices, cells, proofs, cells_count,
-          PyCapsule_GetPointer(s, "KZGSettings")) != C_KZG_OK) {
+  /* Call our C function with our inputs, other threads can run meanwhile */
+  const KZGSettings *settings = PyCapsule_GetPointer(s, "KZGSettings");
+  Py_BEGIN_ALLOW_THREADS
+  c_ret = verify_cell_kzg_proof_batch(&ok, commitments.data, cell_indices,
+                                      cells.data, proofs.data, cells_count,
+                                      settings);
+  Py_END_ALLOW_THREADS
+  if (c_ret != C_KZG_OK) {
     ret =
         PyErr_Format(PyExc_RuntimeError, "verify_cell_kzg_proof_batch failed");
     goto out;
@@ -706,10 +789,10 @@ static PyObject *verify_cell_kzg_proof_batch_wrap(PyObject *self,
   }
 
 out:
-  free(commitments);
+  release_item_array(&commitments);
   free(cell_indices);
-  free(cells);
-  free(proofs);
+  release_item_array(&cells);
+  release_item_array(&proofs);
   return ret;
 }
 
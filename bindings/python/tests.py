@@ -232,6 +232,36 @@ def test_verify_cell_kzg_proof_batch(ts):
         assert valid == expected_valid, f"{test_file}\n{valid=}\n{expected_valid=}"
 
 
+def test_buffer_inputs(ts):
+    test_files = glob.glob(VERIFY_CELL_KZG_PROOF_BATCH_TESTS)
+    assert len(test_files) > 0
+
+    for test_file in test_files:
+        with open(test_file, "r") as f:
+            test = yaml.safe_load(f)
+
+        commitments = list(map(bytes_from_hex, test["input"]["commitments"]))
+        cell_indices = test["input"]["cell_indices"]
+        cells = list(map(bytes_from_hex, test["input"]["cells"]))
+        proofs = list(map(bytes_from_hex, test["input"]["proofs"]))
+
+        # Any bytes-like object works, either per item or with the items back to back
+        try:
+            valid = ckzg.verify_cell_kzg_proof_batch(
+                memoryview(b"".join(commitments)),
+                cell_indices,
+                bytearray(b"".join(cells)),
+                list(map(memoryview, proofs)),
+                ts,
+            )
+        except:
+            assert test["output"] is None
+            continue
+
+        expected_valid = test["output"]
+        assert valid == expected_valid, f"{test_file}\n{valid=}\n{expected_valid=}"
+
+
 ###############################################################################
 # Main Logic
 ###############################################################################
@@ -250,4 +280,6 @@ if __name__ == "__main__":
     test_recover_cells_and_kzg_proofs(ts)
     test_verify_cell_kzg_proof_batch(ts)
 
+    test_buffer_inputs(ts)
+
     print("tests passed")
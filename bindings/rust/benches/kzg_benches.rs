@@ -0,0 +1,214 @@
+use c_kzg::*;
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use rand::{rngs::ThreadRng, Rng};
+use std::path::Path;
+
+/// Blob counts to benchmark batch APIs with: a single blob, the Deneb and Electra per-block
+/// targets and maximums, and a few beyond that to show how throughput scales.
+const BLOB_COUNTS: [usize; 6] = [1, 3, 6, 9, 16, 32];
+
+fn generate_random_field_element(rng: &mut ThreadRng) -> Bytes32 {
+    let mut arr = [0u8; BYTES_PER_FIELD_ELEMENT];
+    rng.fill(&mut arr[..]);
+    // Ensure that the field element is canonical
+    arr[0] = 0;
+    arr.into()
+}
+
+fn generate_random_blob(rng: &mut ThreadRng) -> Blob {
+    let mut arr = [0u8; BYTES_PER_BLOB];
+    rng.fill(&mut arr[..]);
+    // Ensure that the blob is canonical by ensuring that
+    // each field element contained in the blob is < BLS_MODULUS
+    for i in 0..FIELD_ELEMENTS_PER_BLOB {
+        arr[i * BYTES_PER_FIELD_ELEMENT] = 0;
+    }
+    arr.into()
+}
+
+pub fn criterion_benchmark(c: &mut Criterion) {
+    let max_count = *BLOB_COUNTS.iter().max().unwrap();
+    let mut rng = rand::thread_rng();
+    let trusted_setup_file = Path::new("src/trusted_setup.txt");
+    assert!(trusted_setup_file.exists());
+    let kzg_settings = KzgSettings::load_trusted_setup_file(trusted_setup_file, 0).unwrap();
+
+    let blobs: Vec<Blob> = (0..max_count)
+        .map(|_| generate_random_blob(&mut rng))
+        .collect();
+    let commitments: Vec<Bytes48> = blobs
+        .iter()
+        .map(|blob| kzg_settings.blob_to_kzg_commitment(blob).unwrap())
+        .map(|commitment| commitment.to_bytes())
+        .collect();
+    let proofs: Vec<Bytes48> = blobs
+        .iter()
+        .zip(commitments.iter())
+        .map(|(blob, commitment)| {
+            kzg_settings
+                .compute_blob_kzg_proof(blob, commitment)
+                .unwrap()
+        })
+        .map(|proof| proof.to_bytes())
+        .collect();
+    let fields: Vec<Bytes32> = (0..max_count)
+        .map(|_| generate_random_field_element(&mut rng))
+        .collect();
+    let blobs_cells_and_proofs: Vec<_> = blobs
+        .iter()
+        .map(|blob| kzg_settings.compute_cells_and_kzg_proofs(blob).unwrap())
+        .collect();
+
+    /*
+     * Single-blob operations
+     */
+
+    c.bench_function("blob_to_kzg_commitment", |b| {
+        b.iter(|| kzg_settings.blob_to_kzg_commitment(&blobs[0]))
+    });
+
+    c.bench_function("compute_kzg_proof", |b| {
+        b.iter(|| kzg_settings.compute_kzg_proof(&blobs[0], &fields[0]))
+    });
+
+    c.bench_function("compute_blob_kzg_proof", |b| {
+        b.iter(|| kzg_settings.compute_blob_kzg_proof(&blobs[0], &commitments[0]))
+    });
+
+    c.bench_function("verify_kzg_proof", |b| {
+        let (proof, y) = kzg_settings
+            .compute_kzg_proof(&blobs[0], &fields[0])
+            .unwrap();
+        b.iter(|| kzg_settings.verify_kzg_proof(&commitments[0], &fields[0], &y, &proof.to_bytes()))
+    });
+
+    c.bench_function("verify_blob_kzg_proof", |b| {
+        b.iter(|| kzg_settings.verify_blob_kzg_proof(&blobs[0], &commitments[0], &proofs[0]))
+    });
+
+    c.bench_function("compute_cells_and_kzg_proofs", |b| {
+        b.iter(|| kzg_settings.compute_cells_and_kzg_proofs(&blobs[0]))
+    });
+
+    // Recovery from exactly half of the cells, the minimum it requires and the worst case.
+    c.bench_function("recover_cells_and_kzg_proofs", |b| {
+        let cell_indices: Vec<u64> = (0..CELLS_PER_EXT_BLOB as u64).step_by(2).collect();
+        let cells: Vec<Cell> = blobs_cells_and_proofs[0]
+            .0
+            .iter()
+            .step_by(2)
+            .copied()
+            .collect();
+        b.iter(|| kzg_settings.recover_cells_and_kzg_proofs(&cell_indices, &cells))
+    });
+
+    /*
+     * Batch verification
+     */
+
+    let mut group = c.benchmark_group("verify_blob_kzg_proof_batch");
+    for count in BLOB_COUNTS {
+        group.throughput(Throughput::Elements(count as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(count), &count, |b, &count| {
+            b.iter(|| {
+                kzg_settings.verify_blob_kzg_proof_batch(
+                    &blobs[..count],
+                    &commitments[..count],
+                    &proofs[..count],
+                )
+            })
+        });
+    }
+    group.finish();
+
+    // A data column sidecar: the cell at one column index from each blob in a block.
+    let mut group = c.benchmark_group("verify_cell_kzg_proof_batch (column)");
+    for count in BLOB_COUNTS {
+        let cell_indices = vec![0u64; count];
+        let cells: Vec<Cell> = blobs_cells_and_proofs[..count]
+            .iter()
+            .map(|(cells, _)| cells[0])
+            .collect();
+        let cell_proofs: Vec<Bytes48> = blobs_cells_and_proofs[..count]
+            .iter()
+            .map(|(_, proofs)| proofs[0].to_bytes())
+            .collect();
+        group.throughput(Throughput::Elements(count as u64));
+        group.bench_with_input(BenchmarkId::from_parameter(count), &count, |b, &count| {
+            b.iter(|| {
+                kzg_settings.verify_cell_kzg_proof_batch(
+                    &commitments[..count],
+                    &cell_indices,
+                    &cells,
+                    &cell_proofs,
+                )
+            })
+        });
+    }
+    group.finish();
+
+    // Every cell of a single blob.
+    c.bench_function("verify_cell_kzg_proof_batch (row)", |b| {
+        let row_commitments = vec![commitments[0]; CELLS_PER_EXT_BLOB];
+        let cell_indices: Vec<u64> = (0..CELLS_PER_EXT_BLOB as u64).collect();
+        let cell_proofs: Vec<Bytes48> = blobs_cells_and_proofs[0]
+            .1
+            .iter()
+            .map(|proof| proof.to_bytes())
+            .collect();
+        b.iter(|| {
+            kzg_settings.verify_cell_kzg_proof_batch(
+                &row_commitments,
+                &cell_indices,
+                blobs_cells_and_proofs[0].0.as_slice(),
+                &cell_proofs,
+            )
+        })
+    });
+
+    /*
+     * Multi-blob operations
+     */
+
+    #[cfg(feature = "parallel")]
+    {
+        let mut group = c.benchmark_group("blob_to_kzg_commitment_batch");
+        for count in BLOB_COUNTS {
+            group.throughput(Throughput::Elements(count as u64));
+            group.bench_with_input(BenchmarkId::from_parameter(count), &count, |b, &count| {
+                b.iter(|| kzg_settings.blob_to_kzg_commitment_batch(&blobs[..count]))
+            });
+        }
+        group.finish();
+
+        let mut group = c.benchmark_group("compute_cells_and_kzg_proofs_batch");
+        group.sample_size(10);
+        for count in BLOB_COUNTS {
+            group.throughput(Throughput::Elements(count as u64));
+            group.bench_with_input(BenchmarkId::from_parameter(count), &count, |b, &count| {
+                b.iter(|| kzg_settings.compute_cells_and_kzg_proofs_batch(&blobs[..count]))
+            });
+        }
+        group.finish();
+
+        let mut group = c.benchmark_group("recover_cells_and_kzg_proofs_batch");
+        group.sample_size(10);
+        for count in BLOB_COUNTS {
+            let cell_indices: Vec<Vec<u64>> = (0..count)
+                .map(|_| (0..CELLS_PER_EXT_BLOB as u64).step_by(2).collect())
+                .collect();
+            let cells: Vec<Vec<Cell>> = blobs_cells_and_proofs[..count]
+                .iter()
+                .map(|(cells, _)| cells.iter().step_by(2).copied().collect())
+                .collect();
+            group.throughput(Throughput::Elements(count as u64));
+            group.bench_with_input(BenchmarkId::from_parameter(count), &count, |b, _| {
+                b.iter(|| kzg_settings.recover_cells_and_kzg_proofs_batch(&cell_indices, &cells))
+            });
+        }
+        group.finish();
+    }
+}
+
+criterion_group!(benches, criterion_benchmark);
+criterion_main!(benches);
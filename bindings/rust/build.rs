@@ -103,6 +103,8 @@ fn make_bindings(
         .blocklist_type("FILE")
         // Inject rust code using libc's FILE
         .raw_line("use libc::FILE;")
+        // Refer to `core` rather than `std`, so the bindings also build with `no_std`.
+        .use_core()
         // Do not generate layout tests.
         .layout_tests(false)
         // Extern functions do not need individual extern blocks.
@@ -81,6 +81,27 @@ pub struct Bytes48 {
 pub struct Blob {
     bytes: [u8; 131072usize],
 }
+#[doc = " A unit of work, run once for each index `i` handed to a parallel-for."]
+pub type kzg_task_fn =
+    ::core::option::Option<unsafe extern "C" fn(task_ctx: *mut ::core::ffi::c_void, i: u64)>;
+#[doc = " A host-provided parallel-for.\n\n It must call `task(task_ctx, i)` exactly once for every `i` in `[0, n)`, in any order and on any\n threads, and only return once all of those calls have returned. The tasks never block on each\n other, so running them serially is always correct. As `n` can be in the thousands, the host\n should hand out contiguous ranges of indices rather than one index at a time."]
+pub type kzg_parallel_for_fn = ::core::option::Option<
+    unsafe extern "C" fn(
+        executor_ctx: *mut ::core::ffi::c_void,
+        task: kzg_task_fn,
+        task_ctx: *mut ::core::ffi::c_void,
+        n: u64,
+    ),
+>;
+#[doc = " An executor that the library can hand independent units of work to."]
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Hash, PartialEq, Eq)]
+pub struct KZGExecutor {
+    #[doc = " The parallel-for, or NULL to run everything on the calling thread."]
+    parallel_for: kzg_parallel_for_fn,
+    #[doc = " An opaque pointer which is passed to `parallel_for` as is."]
+    ctx: *mut ::core::ffi::c_void,
+}
 #[doc = " Stores the setup and parameters needed for computing KZG proofs."]
 #[repr(C)]
 #[derive(Debug, Hash, PartialEq, Eq)]
@@ -91,20 +112,26 @@ pub struct KZGSettings {
     brp_roots_of_unity: *mut fr_t,
     #[doc = " Roots of unity for the subgroup of size `FIELD_ELEMENTS_PER_EXT_BLOB` in reversed order.\n\n It is the reversed version of `roots_of_unity`. Essentially:\n    `reverse_roots_of_unity = reverse(roots_of_unity)`\n\n This array is primarily used in FFTs.\n The array contains `FIELD_ELEMENTS_PER_EXT_BLOB + 1` elements.\n The array starts and ends with Fr::one()."]
     reverse_roots_of_unity: *mut fr_t,
-    #[doc = " G1 group elements from the trusted setup in monomial form.\n The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements."]
-    g1_values_monomial: *mut g1_t,
-    #[doc = " G1 group elements from the trusted setup in Lagrange form and bit-reversed order.\n The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements."]
-    g1_values_lagrange_brp: *mut g1_t,
+    #[doc = " Powers of the coset shift factor used by coset FFTs during cell recovery.\n\n The array contains `FIELD_ELEMENTS_PER_EXT_BLOB` elements."]
+    coset_shift_powers: *mut fr_t,
+    #[doc = " Powers of the inverse of the coset shift factor used by coset IFFTs during cell recovery,\n each divided by `FIELD_ELEMENTS_PER_EXT_BLOB` so that they also do the IFFT's scaling.\n\n The array contains `FIELD_ELEMENTS_PER_EXT_BLOB` elements."]
+    inv_coset_shift_powers: *mut fr_t,
+    #[doc = " G1 group elements from the trusted setup in monomial form.\n The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements.\n\n The elements are kept in affine form so that they can be used by MSMs directly."]
+    g1_values_monomial: *mut blst_p1_affine,
+    #[doc = " G1 group elements from the trusted setup in Lagrange form and bit-reversed order.\n The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements.\n\n The elements are kept in affine form so that they can be used by MSMs directly."]
+    g1_values_lagrange_brp: *mut blst_p1_affine,
     #[doc = " G2 group elements from the trusted setup in monomial form.\n The array contains `NUM_G2_POINTS` elements."]
     g2_values_monomial: *mut g2_t,
-    #[doc = " Data used during FK20 proof generation."]
-    x_ext_fft_columns: *mut *mut g1_t,
+    #[doc = " Data used during FK20 proof generation, in affine form."]
+    x_ext_fft_columns: *mut *mut blst_p1_affine,
     #[doc = " The precomputed tables for fixed-base MSM."]
     tables: *mut *mut blst_p1_affine,
     #[doc = " The window size for the fixed-base MSM."]
     wbits: usize,
     #[doc = " The scratch size for the fixed-base MSM."]
     scratch_size: usize,
+    #[doc = " Where independent units of work are run, see set_kzg_executor()."]
+    executor: KZGExecutor,
 }
 #[doc = " A single cell for a blob."]
 #[repr(C)]
@@ -154,12 +181,37 @@ extern "C" {
         n: u64,
         s: *const KZGSettings,
     ) -> C_KZG_RET;
+    pub fn verify_blob_kzg_proof_batch_with_report(
+        ok: *mut bool,
+        valid_out: *mut bool,
+        blobs: *const Blob,
+        commitments_bytes: *const Bytes48,
+        proofs_bytes: *const Bytes48,
+        n: u64,
+        s: *const KZGSettings,
+    ) -> C_KZG_RET;
     pub fn compute_cells_and_kzg_proofs(
         cells: *mut Cell,
         proofs: *mut KZGProof,
         blob: *const Blob,
         s: *const KZGSettings,
     ) -> C_KZG_RET;
+    pub fn compute_cells_and_kzg_proofs_for_indices(
+        cells: *mut Cell,
+        proofs: *mut KZGProof,
+        cell_indices: *const u64,
+        num_cells: u64,
+        blob: *const Blob,
+        s: *const KZGSettings,
+    ) -> C_KZG_RET;
+    pub fn compute_blob_sidecar(
+        commitment_out: *mut KZGCommitment,
+        proof_out: *mut KZGProof,
+        cells: *mut Cell,
+        cell_proofs: *mut KZGProof,
+        blob: *const Blob,
+        s: *const KZGSettings,
+    ) -> C_KZG_RET;
     pub fn recover_cells_and_kzg_proofs(
         recovered_cells: *mut Cell,
         recovered_proofs: *mut KZGProof,
@@ -168,6 +220,16 @@ extern "C" {
         num_cells: u64,
         s: *const KZGSettings,
     ) -> C_KZG_RET;
+    pub fn recover_cells_and_kzg_proofs_for_indices(
+        recovered_cells: *mut Cell,
+        recovered_proofs: *mut KZGProof,
+        wanted_cell_indices: *const u64,
+        num_wanted_cells: u64,
+        cell_indices: *const u64,
+        cells: *const Cell,
+        num_cells: u64,
+        s: *const KZGSettings,
+    ) -> C_KZG_RET;
     pub fn verify_cell_kzg_proof_batch(
         ok: *mut bool,
         commitments_bytes: *const Bytes48,
@@ -177,6 +239,16 @@ extern "C" {
         num_cells: u64,
         s: *const KZGSettings,
     ) -> C_KZG_RET;
+    pub fn verify_cell_kzg_proof_batch_with_report(
+        ok: *mut bool,
+        valid_out: *mut bool,
+        commitments_bytes: *const Bytes48,
+        cell_indices: *const u64,
+        cells: *const Cell,
+        proofs_bytes: *const Bytes48,
+        num_cells: u64,
+        s: *const KZGSettings,
+    ) -> C_KZG_RET;
     pub fn load_trusted_setup(
         out: *mut KZGSettings,
         g1_monomial_bytes: *const u8,
@@ -187,10 +259,27 @@ extern "C" {
         num_g2_monomial_bytes: u64,
         precompute: u64,
     ) -> C_KZG_RET;
+    pub fn load_trusted_setup_with_executor(
+        out: *mut KZGSettings,
+        g1_monomial_bytes: *const u8,
+        num_g1_monomial_bytes: u64,
+        g1_lagrange_bytes: *const u8,
+        num_g1_lagrange_bytes: u64,
+        g2_monomial_bytes: *const u8,
+        num_g2_monomial_bytes: u64,
+        precompute: u64,
+        parallel_for: kzg_parallel_for_fn,
+        executor_ctx: *mut ::core::ffi::c_void,
+    ) -> C_KZG_RET;
     pub fn load_trusted_setup_file(
         out: *mut KZGSettings,
         in_: *mut FILE,
         precompute: u64,
     ) -> C_KZG_RET;
     pub fn free_trusted_setup(s: *mut KZGSettings);
+    pub fn set_kzg_executor(
+        s: *mut KZGSettings,
+        parallel_for: kzg_parallel_for_fn,
+        executor_ctx: *mut ::core::ffi::c_void,
+    );
 }
@@ -25,6 +25,9 @@ use alloc::ffi::CString;
 #[cfg(feature = "std")]
 use std::path::Path;
 
+#[cfg(feature = "parallel")]
+use rayon::prelude::*;
+
 const BYTES_PER_G1_POINT: usize = 48;
 const BYTES_PER_G2_POINT: usize = 96;
 
@@ -554,6 +557,72 @@ impl KZGSettings {
     }
 }
 
+/// Multi-blob variants of the single-blob APIs, driven by rayon's global thread pool.
+///
+/// Each blob is processed independently, so results are returned in the same order as the
+/// inputs. If any blob fails, one of the errors is returned and the other results are discarded.
+#[cfg(feature = "parallel")]
+impl KZGSettings {
+    pub fn blob_to_kzg_commitment_batch(
+        &self,
+        blobs: &[Blob],
+    ) -> Result<Vec<KZGCommitment>, Error> {
+        blobs
+            .par_iter()
+            .map(|blob| self.blob_to_kzg_commitment(blob))
+            .collect()
+    }
+
+    pub fn compute_cells_and_kzg_proofs_batch(
+        &self,
+        blobs: &[Blob],
+    ) -> Result<
+        Vec<(
+            Box<[Cell; CELLS_PER_EXT_BLOB]>,
+            Box<[KZGProof; CELLS_PER_EXT_BLOB]>,
+        )>,
+        Error,
+    > {
+        blobs
+            .par_iter()
+            .map(|blob| self.compute_cells_and_kzg_proofs(blob))
+            .collect()
+    }
+
+    /// Recover the cells and proofs of several blobs; `cell_indices[i]` and `cells[i]` are the
+    /// available cells of the i-th blob.
+    pub fn recover_cells_and_kzg_proofs_batch<I, C>(
+        &self,
+        cell_indices: &[I],
+        cells: &[C],
+    ) -> Result<
+        Vec<(
+            Box<[Cell; CELLS_PER_EXT_BLOB]>,
+            Box<[KZGProof; CELLS_PER_EXT_BLOB]>,
+        )>,
+        Error,
+    >
+    where
+        I: AsRef<[u64]> + Sync,
+        C: AsRef<[Cell]> + Sync,
+    {
+        if cell_indices.len() != cells.len() {
+            return Err(Error::MismatchLength(format!(
+                "There are {} cell index lists and {} cell lists",
+                cell_indices.len(),
+                cells.len()
+            )));
+        }
+        cell_indices
+            .par_iter()
+            .zip(cells.par_iter())
+            .map(|(indices, cells)| {
+                self.recover_cells_and_kzg_proofs(indices.as_ref(), cells.as_ref())
+            })
+            .collect()
+    }
+}
+
 impl Drop for KZGSettings {
     fn drop(&mut self) {
         unsafe { free_trusted_setup(self) }
@@ -970,6 +1039,67 @@ mod tests {
         test_simple(trusted_setup_file);
     }
 
+    #[cfg(feature = "parallel")]
+    fn proofs_to_bytes(proofs: &[KZGProof]) -> Vec<Bytes48> {
+        proofs.iter().map(|p| p.to_bytes()).collect()
+    }
+
+    #[cfg(feature = "parallel")]
+    #[test]
+    fn test_parallel_batches_match_single_blob_calls() {
+        let mut rng = rand::thread_rng();
+        let trusted_setup_file = Path::new("src/trusted_setup.txt");
+        assert!(trusted_setup_file.exists());
+        let kzg_settings = KZGSettings::load_trusted_setup_file(trusted_setup_file, 0).unwrap();
+
+        let num_blobs: usize = rng.gen_range(1..8);
+        let blobs: Vec<Blob> = (0..num_blobs)
+            .map(|_| generate_random_blob(&mut rng))
+            .collect();
+
+        let commitments = kzg_settings.blob_to_kzg_commitment_batch(&blobs).unwrap();
+        let cells_and_proofs = kzg_settings
+            .compute_cells_and_kzg_proofs_batch(&blobs)
+            .unwrap();
+        assert_eq!(commitments.len(), num_blobs);
+        assert_eq!(cells_and_proofs.len(), num_blobs);
+
+        for (i, blob) in blobs.iter().enumerate() {
+            let commitment = kzg_settings.blob_to_kzg_commitment(blob).unwrap();
+            assert_eq!(commitments[i].to_bytes(), commitment.to_bytes());
+            let (cells, proofs) = kzg_settings.compute_cells_and_kzg_proofs(blob).unwrap();
+            assert_eq!(cells_and_proofs[i].0.as_slice(), cells.as_slice());
+            assert_eq!(
+                proofs_to_bytes(cells_and_proofs[i].1.as_slice()),
+                proofs_to_bytes(proofs.as_slice())
+            );
+        }
+
+        // Recover every blob from the even-numbered half of its cells.
+        let cell_indices: Vec<Vec<u64>> = (0..num_blobs)
+            .map(|_| (0..CELLS_PER_EXT_BLOB as u64).step_by(2).collect())
+            .collect();
+        let cells: Vec<Vec<Cell>> = cells_and_proofs
+            .iter()
+            .map(|(cells, _)| cells.iter().step_by(2).copied().collect())
+            .collect();
+        let recovered = kzg_settings
+            .recover_cells_and_kzg_proofs_batch(&cell_indices, &cells)
+            .unwrap();
+        for (i, (cells, proofs)) in recovered.iter().enumerate() {
+            assert_eq!(cells.as_slice(), cells_and_proofs[i].0.as_slice());
+            assert_eq!(
+                proofs_to_bytes(proofs.as_slice()),
+                proofs_to_bytes(cells_and_proofs[i].1.as_slice())
+            );
+        }
+
+        let error = kzg_settings
+            .recover_cells_and_kzg_proofs_batch(&cell_indices[1..], &cells)
+            .unwrap_err();
+        assert!(matches!(error, Error::MismatchLength(_)));
+    }
+
     const BLOB_TO_KZG_COMMITMENT_TESTS: &str = "tests/blob_to_kzg_commitment/*/*/*";
     const COMPUTE_KZG_PROOF_TESTS: &str = "tests/compute_kzg_proof/*/*/*";
     const COMPUTE_BLOB_KZG_PROOF_TESTS: &str = "tests/compute_blob_kzg_proof/*/*/*";
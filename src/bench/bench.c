@@ -0,0 +1,1087 @@
+/*
+ * This file contains benchmarks for C-KZG-4844.
+ *
+ * There are two suites. The `api` suite times every public function for a few input shapes and
+ * the `primitives` suite times the building blocks (FFTs, MSMs, permutations, inversions and
+ * pairings) over a sweep of sizes. Both are run for each requested precompute level and the results
+ * are written to stdout as JSON or CSV so that they can be compared between releases.
+ *
+ * Usage: ./benchmarks [-s api|primitives|all] [-f json|csv] [-t <ms per benchmark>] [-p <level>]...
+ */
+#include "ckzg.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The most samples that are recorded for a single benchmark. */
+#define MAX_SAMPLES 100000
+
+/** The fewest samples that are recorded for a single benchmark. */
+#define MIN_SAMPLES 3
+
+/** The largest number of blobs used by any benchmark. */
+#define MAX_BLOBS 64
+
+/** The number of blobs that cells and cell proofs are computed for. */
+#define MAX_CELL_BLOBS 6
+
+/** The most precompute levels that can be requested. */
+#define MAX_PRECOMPUTE_LEVELS 16
+
+/** The time spent on each benchmark if none is given, in milliseconds. */
+#define DEFAULT_BUDGET_MS 1000
+
+/** The largest FFT over field elements. */
+#define MAX_FR_FFT_SIZE FIELD_ELEMENTS_PER_EXT_BLOB
+
+/** The largest FFT over G1 points. */
+#define MAX_G1_FFT_SIZE 256
+
+/** The largest linear combination of G1 points. */
+#define MAX_LINCOMB_LENGTH FIELD_ELEMENTS_PER_BLOB
+
+/** The batch sizes used for the blob batch verification benchmarks. */
+static const uint64_t BLOB_BATCH_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+
+/**
+ * The number of cells requested in the partial cell computation benchmarks. These straddle the
+ * crossover between direct proofs and FK20.
+ */
+static const uint64_t CELL_INDEX_COUNTS[] = {
+    1, MAX_CELLS_FOR_DIRECT_PROOFS, MAX_CELLS_FOR_DIRECT_PROOFS + 1, 32
+};
+
+/** The number of missing cells in the recovery benchmarks. */
+static const uint64_t MISSING_CELL_COUNTS[] = {1, 16, 32, 64};
+
+/** The number of columns (cells per blob) in the cell verification benchmarks. */
+static const uint64_t COLUMN_COUNTS[] = {1, 8, 32, 128};
+
+/** The number of blobs in the cell verification benchmarks. */
+static const uint64_t CELL_BLOB_COUNTS[] = {1, MAX_CELL_BLOBS};
+
+/** The lengths of the linear combinations, dense around the naive method threshold. */
+static const uint64_t LINCOMB_LENGTHS[] = {1, 2, 4, 6, 7, 8, 9, 12, 16, 32, 64, 128, 1024, 4096};
+
+/** The lengths of the batch inversions. */
+static const uint64_t BATCH_INV_LENGTHS[] = {1, 16, 64, 128, 1024, 4096, 8192};
+
+/** Get the number of elements in a static array. */
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The inputs and outputs shared by every benchmark. */
+typedef struct {
+    /** The trusted setup being benchmarked. */
+    KZGSettings *s;
+    /** The size parameter of the current benchmark, e.g. a batch size. */
+    uint64_t n;
+    /** The number of entries in the cell verification arrays. */
+    uint64_t num_verify_cells;
+    /** The number of entries in the available cell arrays for recovery. */
+    uint64_t num_available_cells;
+    /** Random blobs, length MAX_BLOBS. */
+    Blob *blobs;
+    /** The commitments to the blobs, length MAX_BLOBS. */
+    KZGCommitment *commitments;
+    /** The blob proofs for the blobs, length MAX_BLOBS. */
+    KZGProof *blob_proofs;
+    /** The cells of the first MAX_CELL_BLOBS blobs, CELLS_PER_EXT_BLOB per blob. */
+    Cell *cells;
+    /** The cell proofs of the first MAX_CELL_BLOBS blobs, CELLS_PER_EXT_BLOB per blob. */
+    KZGProof *cell_proofs;
+    /** The commitments for the cell verification benchmarks. */
+    Bytes48 *verify_commitments;
+    /** The cell indices for the cell verification benchmarks. */
+    uint64_t *verify_cell_indices;
+    /** The cells for the cell verification benchmarks. */
+    Cell *verify_cells;
+    /** The proofs for the cell verification benchmarks. */
+    Bytes48 *verify_proofs;
+    /** The cell indices of the available cells for recovery. */
+    uint64_t *available_cell_indices;
+    /** The available cells for recovery. */
+    Cell *available_cells;
+    /** The cell indices requested from the partial benchmarks, length CELLS_PER_EXT_BLOB. */
+    uint64_t *wanted_cell_indices;
+    /** Output cells, length CELLS_PER_EXT_BLOB. */
+    Cell *cells_out;
+    /** Output proofs, length CELLS_PER_EXT_BLOB. */
+    KZGProof *proofs_out;
+    /** Output validity flags, length MAX_CELL_BLOBS * CELLS_PER_EXT_BLOB. */
+    bool *valid_out;
+    /** The trusted setup file, only used by the setup benchmark. */
+    FILE *trusted_setup_file;
+    /** The precompute level of the trusted setup. */
+    uint64_t precompute;
+    /** The time to spend on each benchmark, in nanoseconds. */
+    uint64_t budget_ns;
+    /** An evaluation point. */
+    Bytes32 z;
+    /** The evaluation of the first blob at `z`. */
+    Bytes32 y;
+    /** The proof for the evaluation of the first blob at `z`. */
+    KZGProof proof;
+    /** Field elements for the primitives, length MAX_FR_FFT_SIZE. */
+    fr_t *fr_in;
+    /** Output field elements for the primitives, length MAX_FR_FFT_SIZE. */
+    fr_t *fr_out;
+    /** G1 points for the primitives, length MAX_LINCOMB_LENGTH. */
+    g1_t *g1_in;
+    /** Output G1 points for the primitives, length MAX_LINCOMB_LENGTH. */
+    g1_t *g1_out;
+    /** Scalars for the fixed-base MSM, length FIELD_ELEMENTS_PER_CELL. */
+    blst_scalar *scalars;
+    /** Scratch space for the fixed-base MSM, or NULL without precomputation. */
+    limb_t *scratch;
+    /** G1 points for the pairing benchmarks. */
+    g1_t pairing_g1[3];
+    /** G2 points for the pairing benchmarks. */
+    g2_t pairing_g2[3];
+} BenchContext;
+
+/** A function that does one operation and returns its result. */
+typedef C_KZG_RET (*bench_fn)(BenchContext *ctx);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The number of results printed so far, used to separate them with commas. */
+static size_t num_results = 0;
+
+/** Whether results are printed as CSV rather than JSON. */
+static bool output_csv = false;
+
+/** The latencies of the current benchmark, in nanoseconds. */
+static uint64_t samples[MAX_SAMPLES];
+
+/**
+ * Get a monotonic timestamp.
+ *
+ * @return The time in nanoseconds since an arbitrary point.
+ */
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Compare two latencies, for sorting.
+ *
+ * @param[in]   a   The first latency
+ * @param[in]   b   The second latency
+ *
+ * @return Negative, zero, or positive, like memcmp.
+ */
+static int compare_samples(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Deterministically generate a blob of valid field elements.
+ *
+ * @param[out]  out The blob
+ */
+static void get_rand_blob(Blob *out) {
+    static uint64_t seed = 0;
+    Bytes32 hash;
+    fr_t field;
+
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
+        blst_sha256(hash.bytes, (uint8_t *)&seed, sizeof(seed));
+        hash_to_bls_field(&field, &hash);
+        bytes_from_bls_field((Bytes32 *)&out->bytes[i * BYTES_PER_FIELD_ELEMENT], &field);
+        seed++;
+    }
+}
+
+/**
+ * Time an operation and print its statistics as a JSON object or a CSV row.
+ *
+ * The operation is run once to check that it succeeds, then repeatedly until the time budget has
+ * been spent. Each run is timed individually so that percentiles can be reported.
+ *
+ * @param[in]   name    The name of the benchmarked function
+ * @param[in]   param   A description of the input shape, may be empty
+ * @param[in]   fn      The operation
+ * @param[in]   ctx     The benchmark context
+ *
+ * @return C_KZG_OK if the operation succeeded, otherwise its error.
+ */
+static C_KZG_RET run_bench(const char *name, const char *param, bench_fn fn, BenchContext *ctx) {
+    C_KZG_RET ret;
+    uint64_t total_ns = 0;
+    size_t n = 0;
+
+    /* Warm up, and make sure that we are timing the success path */
+    ret = fn(ctx);
+    if (ret != C_KZG_OK) {
+        fprintf(stderr, "[-] %s %s failed with %d\n", name, param, (int)ret);
+        return ret;
+    }
+
+    while (n < MAX_SAMPLES && (n < MIN_SAMPLES || total_ns < ctx->budget_ns)) {
+        uint64_t start = get_time_ns();
+        fn(ctx);
+        uint64_t elapsed = get_time_ns() - start;
+        samples[n++] = elapsed;
+        total_ns += elapsed;
+    }
+
+    qsort(samples, n, sizeof(uint64_t), compare_samples);
+    uint64_t p50 = samples[(n - 1) * 50 / 100];
+    uint64_t p99 = samples[(n - 1) * 99 / 100];
+    double ns_per_op = (double)total_ns / (double)n;
+    double ops_per_sec = 1e9 / ns_per_op;
+
+    if (output_csv) {
+        printf(
+            "%s,\"%s\",%llu,%llu,%.1f,%llu,%llu,%.3f\n",
+            name,
+            param,
+            (unsigned long long)ctx->precompute,
+            (unsigned long long)n,
+            ns_per_op,
+            (unsigned long long)p50,
+            (unsigned long long)p99,
+            ops_per_sec
+        );
+    } else {
+        printf(
+            "%s\n    {\"name\": \"%s\", \"param\": \"%s\", \"precompute\": %llu, "
+            "\"iterations\": %llu, \"ns_per_op\": %.1f, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+            "\"ops_per_sec\": %.3f}",
+            num_results == 0 ? "" : ",",
+            name,
+            param,
+            (unsigned long long)ctx->precompute,
+            (unsigned long long)n,
+            ns_per_op,
+            (unsigned long long)p50,
+            (unsigned long long)p99,
+            ops_per_sec
+        );
+    }
+    fflush(stdout);
+    num_results++;
+
+    fprintf(stderr, "[+] %s %s: %.1f ns/op\n", name, param, ns_per_op);
+    return C_KZG_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Benchmarked operations
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static C_KZG_RET op_load_trusted_setup_file(BenchContext *ctx) {
+    KZGSettings settings;
+    rewind(ctx->trusted_setup_file);
+    C_KZG_RET ret = load_trusted_setup_file(&settings, ctx->trusted_setup_file, ctx->precompute);
+    if (ret == C_KZG_OK) free_trusted_setup(&settings);
+    return ret;
+}
+
+static C_KZG_RET op_blob_to_kzg_commitment(BenchContext *ctx) {
+    KZGCommitment c;
+    return blob_to_kzg_commitment(&c, &ctx->blobs[0], ctx->s);
+}
+
+static C_KZG_RET op_compute_kzg_proof(BenchContext *ctx) {
+    KZGProof proof;
+    Bytes32 y;
+    return compute_kzg_proof(&proof, &y, &ctx->blobs[0], &ctx->z, ctx->s);
+}
+
+static C_KZG_RET op_compute_blob_kzg_proof(BenchContext *ctx) {
+    KZGProof proof;
+    return compute_blob_kzg_proof(&proof, &ctx->blobs[0], &ctx->commitments[0], ctx->s);
+}
+
+static C_KZG_RET op_verify_kzg_proof(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_kzg_proof(
+        &ok, &ctx->commitments[0], &ctx->z, &ctx->y, &ctx->proof, ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_verify_blob_kzg_proof(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_blob_kzg_proof(
+        &ok, &ctx->blobs[0], &ctx->commitments[0], &ctx->blob_proofs[0], ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_verify_blob_kzg_proof_batch(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_blob_kzg_proof_batch(
+        &ok, ctx->blobs, ctx->commitments, ctx->blob_proofs, ctx->n, ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_verify_blob_kzg_proof_batch_with_report(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_blob_kzg_proof_batch_with_report(
+        &ok, ctx->valid_out, ctx->blobs, ctx->commitments, ctx->blob_proofs, ctx->n, ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_compute_cells(BenchContext *ctx) {
+    return compute_cells_and_kzg_proofs(ctx->cells_out, NULL, &ctx->blobs[0], ctx->s);
+}
+
+static C_KZG_RET op_compute_cells_and_kzg_proofs(BenchContext *ctx) {
+    return compute_cells_and_kzg_proofs(ctx->cells_out, ctx->proofs_out, &ctx->blobs[0], ctx->s);
+}
+
+static C_KZG_RET op_compute_cells_and_kzg_proofs_for_indices(BenchContext *ctx) {
+    return compute_cells_and_kzg_proofs_for_indices(
+        ctx->cells_out, ctx->proofs_out, ctx->wanted_cell_indices, ctx->n, &ctx->blobs[0], ctx->s
+    );
+}
+
+static C_KZG_RET op_compute_blob_sidecar(BenchContext *ctx) {
+    KZGCommitment commitment;
+    KZGProof proof;
+    return compute_blob_sidecar(
+        &commitment, &proof, ctx->cells_out, ctx->proofs_out, &ctx->blobs[0], ctx->s
+    );
+}
+
+static C_KZG_RET op_recover_cells(BenchContext *ctx) {
+    return recover_cells_and_kzg_proofs(
+        ctx->cells_out,
+        NULL,
+        ctx->available_cell_indices,
+        ctx->available_cells,
+        ctx->num_available_cells,
+        ctx->s
+    );
+}
+
+static C_KZG_RET op_recover_cells_and_kzg_proofs(BenchContext *ctx) {
+    return recover_cells_and_kzg_proofs(
+        ctx->cells_out,
+        ctx->proofs_out,
+        ctx->available_cell_indices,
+        ctx->available_cells,
+        ctx->num_available_cells,
+        ctx->s
+    );
+}
+
+static C_KZG_RET op_recover_cells_and_kzg_proofs_for_indices(BenchContext *ctx) {
+    return recover_cells_and_kzg_proofs_for_indices(
+        ctx->cells_out,
+        ctx->proofs_out,
+        ctx->wanted_cell_indices,
+        ctx->n,
+        ctx->available_cell_indices,
+        ctx->available_cells,
+        ctx->num_available_cells,
+        ctx->s
+    );
+}
+
+static C_KZG_RET op_verify_cell_kzg_proof_batch(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_cell_kzg_proof_batch(
+        &ok,
+        ctx->verify_commitments,
+        ctx->verify_cell_indices,
+        ctx->verify_cells,
+        ctx->verify_proofs,
+        ctx->num_verify_cells,
+        ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_verify_cell_kzg_proof_batch_with_report(BenchContext *ctx) {
+    bool ok;
+    C_KZG_RET ret = verify_cell_kzg_proof_batch_with_report(
+        &ok,
+        ctx->valid_out,
+        ctx->verify_commitments,
+        ctx->verify_cell_indices,
+        ctx->verify_cells,
+        ctx->verify_proofs,
+        ctx->num_verify_cells,
+        ctx->s
+    );
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+    return ret;
+}
+
+static C_KZG_RET op_kzg_verifier_add_cell_kzg_proof_batch(BenchContext *ctx) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+
+    ret = kzg_verifier_begin(&v, ctx->s);
+    if (ret != C_KZG_OK) return ret;
+    ret = kzg_verifier_add_cell_kzg_proof_batch(
+        &v,
+        ctx->verify_commitments,
+        ctx->verify_cell_indices,
+        ctx->verify_cells,
+        ctx->verify_proofs,
+        ctx->num_verify_cells
+    );
+    kzg_verifier_free(&v);
+    return ret;
+}
+
+static C_KZG_RET op_kzg_verifier(BenchContext *ctx) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    bool ok = false;
+
+    ret = kzg_verifier_begin(&v, ctx->s);
+    if (ret != C_KZG_OK) return ret;
+    ret = kzg_verifier_add_blob_kzg_proof_batch(
+        &v, ctx->blobs, ctx->commitments, ctx->blob_proofs, ctx->n
+    );
+    if (ret != C_KZG_OK) goto out;
+    ret = kzg_verifier_add_cell_kzg_proof_batch(
+        &v,
+        ctx->verify_commitments,
+        ctx->verify_cell_indices,
+        ctx->verify_cells,
+        ctx->verify_proofs,
+        ctx->num_verify_cells
+    );
+    if (ret != C_KZG_OK) goto out;
+    ret = kzg_verifier_finish(&ok, &v);
+    if (ret == C_KZG_OK && !ok) ret = C_KZG_ERROR;
+
+out:
+    kzg_verifier_free(&v);
+    return ret;
+}
+
+static C_KZG_RET op_fr_fft(BenchContext *ctx) {
+    return fr_fft(ctx->fr_out, ctx->fr_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_fr_ifft(BenchContext *ctx) {
+    return fr_ifft(ctx->fr_out, ctx->fr_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_coset_fft(BenchContext *ctx) {
+    return coset_fft(ctx->fr_out, ctx->fr_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_coset_ifft(BenchContext *ctx) {
+    return coset_ifft(ctx->fr_out, ctx->fr_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_g1_fft(BenchContext *ctx) {
+    return g1_fft(ctx->g1_out, ctx->g1_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_g1_ifft(BenchContext *ctx) {
+    return g1_ifft(ctx->g1_out, ctx->g1_in, ctx->n, ctx->s);
+}
+
+static C_KZG_RET op_g1_lincomb_naive(BenchContext *ctx) {
+    g1_lincomb_naive(ctx->g1_out, ctx->g1_in, ctx->fr_in, ctx->n);
+    return C_KZG_OK;
+}
+
+static C_KZG_RET op_g1_lincomb_fast(BenchContext *ctx) {
+    return g1_lincomb_fast(ctx->g1_out, ctx->g1_in, ctx->fr_in, ctx->n);
+}
+
+static C_KZG_RET op_g1_lincomb_affine(BenchContext *ctx) {
+    return g1_lincomb_affine(ctx->g1_out, ctx->s->g1_values_monomial, ctx->fr_in, ctx->n);
+}
+
+static C_KZG_RET op_blst_p1s_mult_wbits(BenchContext *ctx) {
+    const byte *scalars_arg[2] = {(byte *)ctx->scalars, NULL};
+    blst_p1s_mult_wbits(
+        ctx->g1_out,
+        ctx->s->tables[0],
+        ctx->s->wbits,
+        FIELD_ELEMENTS_PER_CELL,
+        scalars_arg,
+        BITS_PER_FIELD_ELEMENT,
+        ctx->scratch
+    );
+    return C_KZG_OK;
+}
+
+static C_KZG_RET op_bit_reversal_permutation_fr(BenchContext *ctx) {
+    return bit_reversal_permutation(ctx->fr_out, sizeof(fr_t), ctx->n);
+}
+
+static C_KZG_RET op_bit_reversal_permutation_g1(BenchContext *ctx) {
+    return bit_reversal_permutation(ctx->g1_out, sizeof(g1_t), ctx->n);
+}
+
+static C_KZG_RET op_fr_batch_inv(BenchContext *ctx) {
+    return fr_batch_inv(ctx->fr_out, ctx->fr_in, (int)ctx->n);
+}
+
+static C_KZG_RET op_pairings_verify(BenchContext *ctx) {
+    pairings_verify(
+        &ctx->pairing_g1[0], &ctx->pairing_g2[0], &ctx->pairing_g1[1], &ctx->pairing_g2[1]
+    );
+    return C_KZG_OK;
+}
+
+static C_KZG_RET op_pairings_product_is_one(BenchContext *ctx) {
+    bool ok;
+    return pairings_product_is_one(&ok, ctx->pairing_g1, ctx->pairing_g2, ctx->n);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Input preparation
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Select the cells for the cell verification benchmarks.
+ *
+ * @param[in,out]   ctx         The benchmark context
+ * @param[in]       num_blobs   The number of blobs the cells come from
+ * @param[in]       num_columns The number of evenly spaced cells taken from each blob
+ */
+static void select_verify_cells(BenchContext *ctx, uint64_t num_blobs, uint64_t num_columns) {
+    uint64_t spacing = CELLS_PER_EXT_BLOB / num_columns;
+    size_t k = 0;
+    for (size_t b = 0; b < num_blobs; b++) {
+        for (size_t c = 0; c < num_columns; c++) {
+            uint64_t index = c * spacing;
+            size_t from = b * CELLS_PER_EXT_BLOB + index;
+            memcpy(&ctx->verify_commitments[k], &ctx->commitments[b], sizeof(Bytes48));
+            ctx->verify_cell_indices[k] = index;
+            memcpy(&ctx->verify_cells[k], &ctx->cells[from], sizeof(Cell));
+            memcpy(&ctx->verify_proofs[k], &ctx->cell_proofs[from], sizeof(Bytes48));
+            k++;
+        }
+    }
+    ctx->num_verify_cells = k;
+}
+
+/**
+ * Select the available cells of the first blob for the recovery benchmarks.
+ *
+ * @param[in,out]   ctx             The benchmark context
+ * @param[in]       num_missing     The number of missing cells
+ * @param[in]       missing_parity  Whether the missing cells are the second half, if 64 are missing
+ */
+static void select_available_cells(BenchContext *ctx, uint64_t num_missing, bool missing_parity) {
+    size_t k = 0;
+    for (uint64_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        bool missing;
+        if (missing_parity) {
+            missing = i >= CELLS_PER_BLOB;
+        } else {
+            /* Spread the missing cells out, so that both halves are incomplete */
+            missing = i % 2 == 1 && i / 2 < num_missing;
+        }
+        if (missing) continue;
+        ctx->available_cell_indices[k] = i;
+        memcpy(&ctx->available_cells[k], &ctx->cells[i], sizeof(Cell));
+        k++;
+    }
+    ctx->num_available_cells = k;
+}
+
+/**
+ * Compute the blobs, commitments, proofs and cells that the benchmarks use.
+ *
+ * @param[in,out]   ctx The benchmark context
+ *
+ * @return C_KZG_OK if everything was computed, otherwise an error.
+ */
+static C_KZG_RET prepare_inputs(BenchContext *ctx) {
+    C_KZG_RET ret;
+    fr_t z;
+    Bytes32 hash;
+
+    for (size_t i = 0; i < MAX_BLOBS; i++) {
+        ret = blob_to_kzg_commitment(&ctx->commitments[i], &ctx->blobs[i], ctx->s);
+        if (ret != C_KZG_OK) return ret;
+        ret = compute_blob_kzg_proof(
+            &ctx->blob_proofs[i], &ctx->blobs[i], &ctx->commitments[i], ctx->s
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    for (size_t i = 0; i < MAX_CELL_BLOBS; i++) {
+        ret = compute_cells_and_kzg_proofs(
+            &ctx->cells[i * CELLS_PER_EXT_BLOB],
+            &ctx->cell_proofs[i * CELLS_PER_EXT_BLOB],
+            &ctx->blobs[i],
+            ctx->s
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    memset(hash.bytes, 0x42, sizeof(hash.bytes));
+    hash_to_bls_field(&z, &hash);
+    bytes_from_bls_field(&ctx->z, &z);
+    ret = compute_kzg_proof(&ctx->proof, &ctx->y, &ctx->blobs[0], &ctx->z, ctx->s);
+    if (ret != C_KZG_OK) return ret;
+
+    for (uint64_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        /* Ask for cells from both halves */
+        ctx->wanted_cell_indices[i] = (i * 5 + 3) % CELLS_PER_EXT_BLOB;
+    }
+
+    /* Non-zero field elements and the setup's points for the primitives */
+    for (size_t i = 0; i < MAX_FR_FFT_SIZE; i++) {
+        memcpy(hash.bytes, &i, sizeof(i));
+        hash_to_bls_field(&ctx->fr_in[i], &hash);
+        if (fr_equal(&ctx->fr_in[i], &FR_ZERO)) ctx->fr_in[i] = FR_ONE;
+    }
+    for (size_t i = 0; i < MAX_LINCOMB_LENGTH; i++) {
+        blst_p1_from_affine(&ctx->g1_in[i], &ctx->s->g1_values_monomial[i]);
+    }
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+        blst_scalar_from_fr(&ctx->scalars[i], &ctx->fr_in[i]);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        ctx->pairing_g1[i] = ctx->g1_in[i];
+        ctx->pairing_g2[i] = ctx->s->g2_values_monomial[i % NUM_G2_POINTS];
+    }
+
+    return C_KZG_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Benchmark suites
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Run every public function benchmark for the current trusted setup.
+ *
+ * @param[in,out]   ctx The benchmark context
+ *
+ * @return C_KZG_OK if every benchmark succeeded, otherwise the first error.
+ */
+static C_KZG_RET run_api_suite(BenchContext *ctx) {
+    C_KZG_RET ret;
+    char param[64];
+
+    /* Setup */
+    ret = run_bench("load_trusted_setup_file", "", op_load_trusted_setup_file, ctx);
+    if (ret != C_KZG_OK) return ret;
+
+    /* EIP-4844 */
+    ret = run_bench("blob_to_kzg_commitment", "", op_blob_to_kzg_commitment, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench("compute_kzg_proof", "", op_compute_kzg_proof, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench("compute_blob_kzg_proof", "", op_compute_blob_kzg_proof, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench("verify_kzg_proof", "", op_verify_kzg_proof, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench("verify_blob_kzg_proof", "", op_verify_blob_kzg_proof, ctx);
+    if (ret != C_KZG_OK) return ret;
+    for (size_t i = 0; i < ARRAY_LEN(BLOB_BATCH_COUNTS); i++) {
+        ctx->n = BLOB_BATCH_COUNTS[i];
+        snprintf(param, sizeof(param), "blobs=%llu", (unsigned long long)ctx->n);
+        ret = run_bench("verify_blob_kzg_proof_batch", param, op_verify_blob_kzg_proof_batch, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench(
+            "verify_blob_kzg_proof_batch_with_report",
+            param,
+            op_verify_blob_kzg_proof_batch_with_report,
+            ctx
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    /* EIP-7594, computing */
+    ret = run_bench("compute_cells_and_kzg_proofs", "cells_only", op_compute_cells, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench("compute_cells_and_kzg_proofs", "", op_compute_cells_and_kzg_proofs, ctx);
+    if (ret != C_KZG_OK) return ret;
+    for (size_t i = 0; i < ARRAY_LEN(CELL_INDEX_COUNTS); i++) {
+        ctx->n = CELL_INDEX_COUNTS[i];
+        snprintf(param, sizeof(param), "cells=%llu", (unsigned long long)ctx->n);
+        ret = run_bench(
+            "compute_cells_and_kzg_proofs_for_indices",
+            param,
+            op_compute_cells_and_kzg_proofs_for_indices,
+            ctx
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+    ret = run_bench("compute_blob_sidecar", "", op_compute_blob_sidecar, ctx);
+    if (ret != C_KZG_OK) return ret;
+
+    /* EIP-7594, recovering */
+    for (size_t i = 0; i < ARRAY_LEN(MISSING_CELL_COUNTS); i++) {
+        select_available_cells(ctx, MISSING_CELL_COUNTS[i], false);
+        snprintf(param, sizeof(param), "missing=%llu", (unsigned long long)MISSING_CELL_COUNTS[i]);
+        ret = run_bench(
+            "recover_cells_and_kzg_proofs", param, op_recover_cells_and_kzg_proofs, ctx
+        );
+        if (ret != C_KZG_OK) return ret;
+        snprintf(
+            param,
+            sizeof(param),
+            "missing=%llu,cells_only",
+            (unsigned long long)MISSING_CELL_COUNTS[i]
+        );
+        ret = run_bench("recover_cells_and_kzg_proofs", param, op_recover_cells, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+    select_available_cells(ctx, CELLS_PER_BLOB, true);
+    ret = run_bench(
+        "recover_cells_and_kzg_proofs", "missing=64,parity", op_recover_cells_and_kzg_proofs, ctx
+    );
+    if (ret != C_KZG_OK) return ret;
+    select_available_cells(ctx, CELLS_PER_BLOB, false);
+    for (size_t i = 0; i < ARRAY_LEN(CELL_INDEX_COUNTS); i++) {
+        ctx->n = CELL_INDEX_COUNTS[i];
+        snprintf(param, sizeof(param), "missing=64,cells=%llu", (unsigned long long)ctx->n);
+        ret = run_bench(
+            "recover_cells_and_kzg_proofs_for_indices",
+            param,
+            op_recover_cells_and_kzg_proofs_for_indices,
+            ctx
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    /* EIP-7594, verifying */
+    for (size_t i = 0; i < ARRAY_LEN(CELL_BLOB_COUNTS); i++) {
+        for (size_t j = 0; j < ARRAY_LEN(COLUMN_COUNTS); j++) {
+            select_verify_cells(ctx, CELL_BLOB_COUNTS[i], COLUMN_COUNTS[j]);
+            snprintf(
+                param,
+                sizeof(param),
+                "blobs=%llu,columns=%llu",
+                (unsigned long long)CELL_BLOB_COUNTS[i],
+                (unsigned long long)COLUMN_COUNTS[j]
+            );
+            ret = run_bench(
+                "verify_cell_kzg_proof_batch", param, op_verify_cell_kzg_proof_batch, ctx
+            );
+            if (ret != C_KZG_OK) return ret;
+        }
+    }
+    select_verify_cells(ctx, MAX_CELL_BLOBS, CELLS_PER_EXT_BLOB);
+    snprintf(param, sizeof(param), "blobs=%d,columns=%d", MAX_CELL_BLOBS, CELLS_PER_EXT_BLOB);
+    ret = run_bench(
+        "verify_cell_kzg_proof_batch_with_report",
+        param,
+        op_verify_cell_kzg_proof_batch_with_report,
+        ctx
+    );
+    if (ret != C_KZG_OK) return ret;
+    ret = run_bench(
+        "kzg_verifier_add_cell_kzg_proof_batch",
+        param,
+        op_kzg_verifier_add_cell_kzg_proof_batch,
+        ctx
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    /* Deferred verification of a block's blobs and columns together */
+    ctx->n = MAX_CELL_BLOBS;
+    ret = run_bench("kzg_verifier", param, op_kzg_verifier, ctx);
+    if (ret != C_KZG_OK) return ret;
+
+    return C_KZG_OK;
+}
+
+/**
+ * Run the primitive benchmarks for the current trusted setup.
+ *
+ * Only the fixed-base MSM depends on the precompute level, so everything else can be skipped when
+ * the suite is repeated for another level.
+ *
+ * @param[in,out]   ctx             The benchmark context
+ * @param[in]       only_wbits      Whether to only run the fixed-base MSM
+ *
+ * @return C_KZG_OK if every benchmark succeeded, otherwise the first error.
+ */
+static C_KZG_RET run_primitives_suite(BenchContext *ctx, bool only_wbits) {
+    C_KZG_RET ret;
+    char param[64];
+
+    if (ctx->s->wbits != 0) {
+        snprintf(
+            param,
+            sizeof(param),
+            "wbits=%llu,points=%d",
+            (unsigned long long)ctx->s->wbits,
+            FIELD_ELEMENTS_PER_CELL
+        );
+        ret = run_bench("blst_p1s_mult_wbits", param, op_blst_p1s_mult_wbits, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+    if (only_wbits) return C_KZG_OK;
+
+    for (ctx->n = 2; ctx->n <= MAX_FR_FFT_SIZE; ctx->n *= 2) {
+        snprintf(param, sizeof(param), "n=%llu", (unsigned long long)ctx->n);
+        ret = run_bench("fr_fft", param, op_fr_fft, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("fr_ifft", param, op_fr_ifft, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("coset_fft", param, op_coset_fft, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("coset_ifft", param, op_coset_ifft, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    for (ctx->n = 2; ctx->n <= MAX_G1_FFT_SIZE; ctx->n *= 2) {
+        snprintf(param, sizeof(param), "n=%llu", (unsigned long long)ctx->n);
+        ret = run_bench("g1_fft", param, op_g1_fft, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("g1_ifft", param, op_g1_ifft, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    for (size_t i = 0; i < ARRAY_LEN(LINCOMB_LENGTHS); i++) {
+        ctx->n = LINCOMB_LENGTHS[i];
+        snprintf(param, sizeof(param), "len=%llu", (unsigned long long)ctx->n);
+        ret = run_bench("g1_lincomb_naive", param, op_g1_lincomb_naive, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("g1_lincomb_fast", param, op_g1_lincomb_fast, ctx);
+        if (ret != C_KZG_OK) return ret;
+        ret = run_bench("g1_lincomb_affine", param, op_g1_lincomb_affine, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    for (ctx->n = 64; ctx->n <= FIELD_ELEMENTS_PER_EXT_BLOB; ctx->n *= 2) {
+        snprintf(param, sizeof(param), "n=%llu,size=%zu", (unsigned long long)ctx->n, sizeof(fr_t));
+        ret = run_bench("bit_reversal_permutation", param, op_bit_reversal_permutation_fr, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+    for (ctx->n = 64; ctx->n <= MAX_LINCOMB_LENGTH; ctx->n *= 2) {
+        snprintf(param, sizeof(param), "n=%llu,size=%zu", (unsigned long long)ctx->n, sizeof(g1_t));
+        ret = run_bench("bit_reversal_permutation", param, op_bit_reversal_permutation_g1, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    for (size_t i = 0; i < ARRAY_LEN(BATCH_INV_LENGTHS); i++) {
+        ctx->n = BATCH_INV_LENGTHS[i];
+        snprintf(param, sizeof(param), "len=%llu", (unsigned long long)ctx->n);
+        ret = run_bench("fr_batch_inv", param, op_fr_batch_inv, ctx);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    ret = run_bench("pairings_verify", "", op_pairings_verify, ctx);
+    if (ret != C_KZG_OK) return ret;
+    ctx->n = 3;
+    ret = run_bench("pairings_product_is_one", "n=3", op_pairings_product_is_one, ctx);
+    if (ret != C_KZG_OK) return ret;
+
+    return C_KZG_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Main logic
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Allocate the buffers of a benchmark context.
+ *
+ * @param[out]  ctx The benchmark context
+ *
+ * @return C_KZG_OK if everything was allocated, otherwise C_KZG_MALLOC.
+ */
+static C_KZG_RET alloc_context(BenchContext *ctx) {
+    C_KZG_RET ret;
+    size_t num_cells = MAX_CELL_BLOBS * CELLS_PER_EXT_BLOB;
+
+    ret = c_kzg_calloc((void **)&ctx->blobs, MAX_BLOBS, sizeof(Blob));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->commitments, MAX_BLOBS, sizeof(KZGCommitment));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->blob_proofs, MAX_BLOBS, sizeof(KZGProof));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->cells, num_cells, sizeof(Cell));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->cell_proofs, num_cells, sizeof(KZGProof));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->verify_commitments, num_cells, sizeof(Bytes48));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->verify_cell_indices, num_cells, sizeof(uint64_t));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->verify_cells, num_cells, sizeof(Cell));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->verify_proofs, num_cells, sizeof(Bytes48));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->available_cell_indices, CELLS_PER_EXT_BLOB, sizeof(uint64_t));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->available_cells, CELLS_PER_EXT_BLOB, sizeof(Cell));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->wanted_cell_indices, CELLS_PER_EXT_BLOB, sizeof(uint64_t));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->cells_out, CELLS_PER_EXT_BLOB, sizeof(Cell));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->proofs_out, CELLS_PER_EXT_BLOB, sizeof(KZGProof));
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->valid_out, num_cells, sizeof(bool));
+    if (ret != C_KZG_OK) return ret;
+    ret = new_fr_array(&ctx->fr_in, MAX_FR_FFT_SIZE);
+    if (ret != C_KZG_OK) return ret;
+    ret = new_fr_array(&ctx->fr_out, MAX_FR_FFT_SIZE);
+    if (ret != C_KZG_OK) return ret;
+    ret = new_g1_array(&ctx->g1_in, MAX_LINCOMB_LENGTH);
+    if (ret != C_KZG_OK) return ret;
+    ret = new_g1_array(&ctx->g1_out, MAX_LINCOMB_LENGTH);
+    if (ret != C_KZG_OK) return ret;
+    ret = c_kzg_calloc((void **)&ctx->scalars, FIELD_ELEMENTS_PER_CELL, sizeof(blst_scalar));
+    if (ret != C_KZG_OK) return ret;
+
+    return C_KZG_OK;
+}
+
+/**
+ * Free the buffers of a benchmark context.
+ *
+ * @param[in]   ctx The benchmark context
+ */
+static void free_context(BenchContext *ctx) {
+    c_kzg_free(ctx->blobs);
+    c_kzg_free(ctx->commitments);
+    c_kzg_free(ctx->blob_proofs);
+    c_kzg_free(ctx->cells);
+    c_kzg_free(ctx->cell_proofs);
+    c_kzg_free(ctx->verify_commitments);
+    c_kzg_free(ctx->verify_cell_indices);
+    c_kzg_free(ctx->verify_cells);
+    c_kzg_free(ctx->verify_proofs);
+    c_kzg_free(ctx->available_cell_indices);
+    c_kzg_free(ctx->available_cells);
+    c_kzg_free(ctx->wanted_cell_indices);
+    c_kzg_free(ctx->cells_out);
+    c_kzg_free(ctx->proofs_out);
+    c_kzg_free(ctx->valid_out);
+    c_kzg_free(ctx->fr_in);
+    c_kzg_free(ctx->fr_out);
+    c_kzg_free(ctx->g1_in);
+    c_kzg_free(ctx->g1_out);
+    c_kzg_free(ctx->scalars);
+    c_kzg_free(ctx->scratch);
+}
+
+int main(int argc, char **argv) {
+    C_KZG_RET ret = C_KZG_OK;
+    BenchContext ctx;
+    KZGSettings s;
+    uint64_t precompute_levels[MAX_PRECOMPUTE_LEVELS];
+    size_t num_precompute_levels = 0;
+    uint64_t budget_ms = DEFAULT_BUDGET_MS;
+    bool run_api = true;
+    bool run_primitives = false;
+
+    /* Parse the arguments */
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "-t") == 0 && value != NULL) {
+            budget_ms = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "-p") == 0 && value != NULL &&
+                   num_precompute_levels < MAX_PRECOMPUTE_LEVELS) {
+            precompute_levels[num_precompute_levels++] = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && value != NULL) {
+            run_api = strcmp(value, "api") == 0 || strcmp(value, "all") == 0;
+            run_primitives = strcmp(value, "primitives") == 0 || strcmp(value, "all") == 0;
+            if (!run_api && !run_primitives) value = NULL;
+        } else if (strcmp(argv[i], "-f") == 0 && value != NULL) {
+            output_csv = strcmp(value, "csv") == 0;
+            if (!output_csv && strcmp(value, "json") != 0) value = NULL;
+        } else {
+            value = NULL;
+        }
+        if (value == NULL) {
+            fprintf(
+                stderr,
+                "usage: %s [-s api|primitives|all] [-f json|csv] [-t <ms per benchmark>] "
+                "[-p <precompute>]...\n",
+                argv[0]
+            );
+            return 1;
+        }
+        i++;
+    }
+    if (num_precompute_levels == 0) {
+        precompute_levels[num_precompute_levels++] = 0;
+        precompute_levels[num_precompute_levels++] = 8;
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.budget_ns = budget_ms * 1000000;
+    ctx.s = &s;
+
+    ret = alloc_context(&ctx);
+    if (ret != C_KZG_OK) goto out;
+    for (size_t i = 0; i < MAX_BLOBS; i++) {
+        get_rand_blob(&ctx.blobs[i]);
+    }
+
+    /* Open the mainnet trusted setup file */
+    ctx.trusted_setup_file = fopen("trusted_setup.txt", "r");
+    if (ctx.trusted_setup_file == NULL) {
+        fprintf(stderr, "[-] could not open trusted_setup.txt\n");
+        ret = C_KZG_BADARGS;
+        goto out;
+    }
+
+    if (output_csv) {
+        printf("name,param,precompute,iterations,ns_per_op,p50_ns,p99_ns,ops_per_sec\n");
+    } else {
+        printf("{\"benchmarks\": [");
+    }
+    for (size_t i = 0; i < num_precompute_levels; i++) {
+        ctx.precompute = precompute_levels[i];
+        fprintf(
+            stderr,
+            "[+] loading trusted setup with precompute=%llu\n",
+            (unsigned long long)ctx.precompute
+        );
+
+        rewind(ctx.trusted_setup_file);
+        ret = load_trusted_setup_file(&s, ctx.trusted_setup_file, ctx.precompute);
+        if (ret != C_KZG_OK) goto out;
+
+        /* The fixed-base MSM needs scratch space for this setup's tables */
+        c_kzg_free(ctx.scratch);
+        ctx.scratch = NULL;
+        if (s.wbits != 0) ret = c_kzg_malloc((void **)&ctx.scratch, s.scratch_size);
+
+        if (ret == C_KZG_OK) ret = prepare_inputs(&ctx);
+        if (ret == C_KZG_OK && run_api) ret = run_api_suite(&ctx);
+        if (ret == C_KZG_OK && run_primitives) ret = run_primitives_suite(&ctx, i != 0);
+        free_trusted_setup(&s);
+        if (ret != C_KZG_OK) goto out;
+    }
+    if (!output_csv) printf("\n]}\n");
+
+out:
+    if (ctx.trusted_setup_file != NULL) fclose(ctx.trusted_setup_file);
+    free_context(&ctx);
+    return ret == C_KZG_OK ? 0 : 1;
+}
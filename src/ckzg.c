@@ -17,8 +17,11 @@
 #include "common/alloc.c"
 #include "common/bytes.c"
 #include "common/ec.c"
+#include "common/executor.c"
 #include "common/fr.c"
 #include "common/lincomb.c"
+#include "common/sha256.c"
+#include "common/stats.c"
 #include "common/utils.c"
 #include "eip4844/blob.c"
 #include "eip4844/eip4844.c"
@@ -29,3 +32,4 @@
 #include "eip7594/poly.c"
 #include "eip7594/recovery.c"
 #include "setup/setup.c"
+#include "verifier/verifier.c"
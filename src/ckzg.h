@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "common/stats.h"
 #include "eip4844/eip4844.h"
 #include "eip7594/eip7594.h"
 #include "setup/setup.h"
+#include "verifier/verifier.h"
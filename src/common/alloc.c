@@ -17,6 +17,7 @@
 #include "common/alloc.h"
 #include "common/ec.h"
 #include "common/fr.h"
+#include "common/stats.h"
 
 #include <stdbool.h> /* For bool */
 #include <stddef.h>  /* For size_t & NULL */
@@ -38,7 +39,9 @@ C_KZG_RET c_kzg_malloc(void **out, size_t size) {
     *out = NULL;
     if (size == 0) return C_KZG_BADARGS;
     *out = malloc(size);
-    return *out != NULL ? C_KZG_OK : C_KZG_MALLOC;
+    if (*out == NULL) return C_KZG_MALLOC;
+    STATS_RECORD_ALLOC(size);
+    return C_KZG_OK;
 }
 
 /**
@@ -54,7 +57,9 @@ C_KZG_RET c_kzg_calloc(void **out, size_t count, size_t size) {
     *out = NULL;
     if (count == 0 || size == 0) return C_KZG_BADARGS;
     *out = calloc(count, size);
-    return *out != NULL ? C_KZG_OK : C_KZG_MALLOC;
+    if (*out == NULL) return C_KZG_MALLOC;
+    STATS_RECORD_ALLOC(count * size);
+    return C_KZG_OK;
 }
 
 /**
@@ -69,6 +74,18 @@ C_KZG_RET new_g1_array(g1_t **x, size_t n) {
     return c_kzg_calloc((void **)x, n, sizeof(g1_t));
 }
 
+/**
+ * Allocate memory for an array of G1 group elements in affine representation.
+ *
+ * @param[out]  x   Pointer to the allocated space
+ * @param[in]   n   The number of G1 elements to be allocated
+ *
+ * @remark Free the space later using c_kzg_free().
+ */
+C_KZG_RET new_g1_affine_array(blst_p1_affine **x, size_t n) {
+    return c_kzg_calloc((void **)x, n, sizeof(blst_p1_affine));
+}
+
 /**
  * Allocate memory for an array of G2 group elements.
  *
@@ -49,6 +49,7 @@ extern "C" {
 C_KZG_RET c_kzg_malloc(void **out, size_t size);
 C_KZG_RET c_kzg_calloc(void **out, size_t count, size_t size);
 C_KZG_RET new_g1_array(g1_t **x, size_t n);
+C_KZG_RET new_g1_affine_array(blst_p1_affine **x, size_t n);
 C_KZG_RET new_g2_array(g2_t **x, size_t n);
 C_KZG_RET new_fr_array(fr_t **x, size_t n);
 C_KZG_RET new_bool_array(bool **x, size_t n);
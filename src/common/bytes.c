@@ -15,8 +15,49 @@
  */
 
 #include "common/bytes.h"
+#include "common/stats.h"
 
-#include <stdio.h> /* For printf */
+#include <stdio.h>  /* For printf */
+#include <string.h> /* For memcpy */
+
+/** The BLS scalar field modulus, as little-endian 64-bit limbs. */
+static const uint64_t BLS_MODULUS_LIMBS[4] = {
+    0xffffffff00000001ULL,
+    0x53bda402fffe5bfeULL,
+    0x3339d80809a1d805ULL,
+    0x73eda753299d7d48ULL,
+};
+
+/**
+ * Deserialize 8 big-endian bytes into a 64-bit unsigned integer.
+ *
+ * @param[in]   in  An 8-byte array containing the serialized integer
+ *
+ * @remark Compilers recognize this pattern and emit a single byte-swapping load.
+ */
+static inline uint64_t uint64_from_bendian(const uint8_t in[8]) {
+    uint64_t n = 0;
+    for (size_t i = 0; i < 8; i++) {
+        n = (n << 8) | in[i];
+    }
+    return n;
+}
+
+/**
+ * Check if little-endian limbs represent a value less than the BLS scalar field modulus.
+ *
+ * @param[in]   limbs   The value to check
+ *
+ * @remark This is branch-free so that the range check over an array can be vectorized.
+ */
+static inline uint64_t limbs_are_canonical(const uint64_t limbs[4]) {
+    uint64_t less = 0;
+    for (size_t i = 0; i < 4; i++) {
+        less = (uint64_t)(limbs[i] < BLS_MODULUS_LIMBS[i]) |
+               ((uint64_t)(limbs[i] == BLS_MODULUS_LIMBS[i]) & less);
+    }
+    return less;
+}
 
 /**
  * Serialize a 64-bit unsigned integer into bytes.
@@ -69,6 +110,60 @@ C_KZG_RET bytes_to_bls_field(fr_t *out, const Bytes32 *b) {
     return C_KZG_OK;
 }
 
+/**
+ * Convert an array of untrusted bytes to trusted and validated BLS scalar field elements.
+ *
+ * This is equivalent to calling bytes_to_bls_field() on each element, but works in bulk passes: all
+ * elements are byte-swapped and range-checked first, so that no Montgomery conversions are done for
+ * invalid input, and then all of them are converted.
+ *
+ * @param[out]  out                 The field elements, length `n`
+ * @param[out]  invalid_index_out   The index of the first invalid element, may be NULL
+ * @param[in]   bytes               The serialized field elements, length `n * 32`
+ * @param[in]   n                   The number of field elements
+ *
+ * @remark On error, the contents of `out` are unspecified.
+ */
+C_KZG_RET bytes_to_bls_field_array(
+    fr_t *out, size_t *invalid_index_out, const uint8_t *bytes, size_t n
+) {
+    uint64_t all_canonical = 1;
+    uint64_t limbs[4];
+    STATS_TIMER_START(timer);
+
+    /* Byte-swap every element into little-endian limbs, staged in the output */
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t *element = &bytes[i * BYTES_PER_FIELD_ELEMENT];
+        for (size_t j = 0; j < 4; j++) {
+            limbs[j] = uint64_from_bendian(&element[(3 - j) * sizeof(uint64_t)]);
+        }
+        all_canonical &= limbs_are_canonical(limbs);
+        memcpy(&out[i], limbs, sizeof(limbs));
+    }
+
+    /* Only in the error case, go back to find the first element that was not canonical */
+    if (!all_canonical) {
+        for (size_t i = 0; i < n; i++) {
+            memcpy(limbs, &out[i], sizeof(limbs));
+            if (!limbs_are_canonical(limbs)) {
+                if (invalid_index_out != NULL) *invalid_index_out = i;
+                break;
+            }
+        }
+        STATS_TIMER_STOP(timer, C_KZG_PHASE_DECODE);
+        return C_KZG_BADARGS;
+    }
+
+    /* Convert every element to Montgomery form */
+    for (size_t i = 0; i < n; i++) {
+        memcpy(limbs, &out[i], sizeof(limbs));
+        blst_fr_from_uint64(&out[i], limbs);
+    }
+
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_DECODE);
+    return C_KZG_OK;
+}
+
 /**
  * Perform BLS validation required by the types KZGProof and KZGCommitment.
  *
@@ -101,7 +196,10 @@ static C_KZG_RET validate_kzg_g1(g1_t *out, const Bytes48 *b) {
  * @param[in]   b   The commitment bytes
  */
 C_KZG_RET bytes_to_kzg_commitment(g1_t *out, const Bytes48 *b) {
-    return validate_kzg_g1(out, b);
+    STATS_TIMER_START(timer);
+    C_KZG_RET ret = validate_kzg_g1(out, b);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_DECODE);
+    return ret;
 }
 
 /**
@@ -111,7 +209,10 @@ C_KZG_RET bytes_to_kzg_commitment(g1_t *out, const Bytes48 *b) {
  * @param[in]   b   The proof bytes
  */
 C_KZG_RET bytes_to_kzg_proof(g1_t *out, const Bytes48 *b) {
-    return validate_kzg_g1(out, b);
+    STATS_TIMER_START(timer);
+    C_KZG_RET ret = validate_kzg_g1(out, b);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_DECODE);
+    return ret;
 }
 
 /**
@@ -21,6 +21,7 @@
 #include "common/ret.h"
 
 #include <inttypes.h> /* For uint*_t */
+#include <stddef.h>   /* For size_t */
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Macros
@@ -67,6 +68,9 @@ void bytes_from_uint64(uint8_t out[8], uint64_t n);
 void bytes_from_g1(Bytes48 *out, const g1_t *in);
 void bytes_from_bls_field(Bytes32 *out, const fr_t *in);
 C_KZG_RET bytes_to_bls_field(fr_t *out, const Bytes32 *b);
+C_KZG_RET bytes_to_bls_field_array(
+    fr_t *out, size_t *invalid_index_out, const uint8_t *bytes, size_t n
+);
 C_KZG_RET bytes_to_kzg_commitment(g1_t *out, const Bytes48 *b);
 C_KZG_RET bytes_to_kzg_proof(g1_t *out, const Bytes48 *b);
 void hash_to_bls_field(fr_t *out, const Bytes32 *b);
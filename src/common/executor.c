@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/executor.h"
+#include "common/alloc.h"
+
+#include <stdlib.h> /* For NULL */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Adapts a kzg_checked_task_fn to a kzg_task_fn by storing each result. */
+typedef struct {
+    kzg_checked_task_fn task;
+    void *task_ctx;
+    C_KZG_RET *rets;
+} CheckedTask;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Running Tasks
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Run one checked task and store its result.
+ *
+ * @param[in]   ctx The CheckedTask
+ * @param[in]   i   The index of the task
+ */
+static void run_checked_task(void *ctx, uint64_t i) {
+    CheckedTask *checked = (CheckedTask *)ctx;
+    checked->rets[i] = checked->task(checked->task_ctx, (size_t)i);
+}
+
+/**
+ * Run `task(task_ctx, i)` for every `i` in `[0, n)`, on the executor if there is one.
+ *
+ * Without an executor, the tasks are run in order on the calling thread and stop at the first
+ * failure. With one, every task is run and the first failure by index is returned.
+ *
+ * @param[in]   executor    The executor, may be NULL
+ * @param[in]   task        The task to run
+ * @param[in]   task_ctx    An opaque pointer which is passed to every task
+ * @param[in]   n           The number of tasks
+ */
+C_KZG_RET run_parallel_for(
+    const KZGExecutor *executor, kzg_checked_task_fn task, void *task_ctx, size_t n
+) {
+    C_KZG_RET ret = C_KZG_OK;
+    CheckedTask checked = {task, task_ctx, NULL};
+
+    /* Run serially when there is nothing to gain from the executor */
+    if (executor == NULL || executor->parallel_for == NULL || n < 2) {
+        for (size_t i = 0; i < n; i++) {
+            ret = task(task_ctx, i);
+            if (ret != C_KZG_OK) goto out;
+        }
+        goto out;
+    }
+
+    /* Each task gets its own slot, so no synchronization is needed */
+    ret = c_kzg_calloc((void **)&checked.rets, n, sizeof(C_KZG_RET));
+    if (ret != C_KZG_OK) goto out;
+
+    executor->parallel_for(executor->ctx, run_checked_task, &checked, n);
+
+    for (size_t i = 0; i < n; i++) {
+        ret = checked.rets[i];
+        if (ret != C_KZG_OK) goto out;
+    }
+
+out:
+    c_kzg_free(checked.rets);
+    return ret;
+}
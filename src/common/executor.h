@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/ret.h"
+
+#include <stddef.h> /* For size_t */
+#include <stdint.h> /* For uint64_t */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A unit of work, run once for each index `i` handed to a parallel-for. */
+typedef void (*kzg_task_fn)(void *task_ctx, uint64_t i);
+
+/**
+ * A host-provided parallel-for.
+ *
+ * It must call `task(task_ctx, i)` exactly once for every `i` in `[0, n)`, in any order and on any
+ * threads, and only return once all of those calls have returned. The tasks never block on each
+ * other, so running them serially is always correct. As `n` can be in the thousands, the host
+ * should hand out contiguous ranges of indices rather than one index at a time.
+ */
+typedef void (*kzg_parallel_for_fn)(
+    void *executor_ctx, kzg_task_fn task, void *task_ctx, uint64_t n
+);
+
+/** An executor that the library can hand independent units of work to. */
+typedef struct {
+    /** The parallel-for, or NULL to run everything on the calling thread. */
+    kzg_parallel_for_fn parallel_for;
+    /** An opaque pointer which is passed to `parallel_for` as is. */
+    void *ctx;
+} KZGExecutor;
+
+/** A unit of work which can fail, used internally on top of kzg_task_fn. */
+typedef C_KZG_RET (*kzg_checked_task_fn)(void *task_ctx, size_t i);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+C_KZG_RET run_parallel_for(
+    const KZGExecutor *executor, kzg_checked_task_fn task, void *task_ctx, size_t n
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,8 +16,10 @@
 
 #include "common/lincomb.h"
 #include "common/alloc.h"
+#include "common/stats.h"
 
 #include <stdlib.h> /* For NULL */
+#include <string.h> /* For memmove */
 
 /**
  * Calculate a linear combination of G1 group elements.
@@ -33,11 +35,13 @@
  */
 void g1_lincomb_naive(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t len) {
     g1_t tmp;
+    STATS_TIMER_START(timer);
     *out = G1_IDENTITY;
     for (size_t i = 0; i < len; i++) {
         g1_mul(&tmp, &p[i], &coeffs[i]);
         blst_p1_add_or_double(out, out, &tmp);
     }
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_MSM);
 }
 
 /**
@@ -67,10 +71,9 @@ void g1_lincomb_naive(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t len)
  */
 C_KZG_RET g1_lincomb_fast(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t len) {
     C_KZG_RET ret;
-    limb_t *scratch = NULL;
     blst_p1 *p_filtered = NULL;
     blst_p1_affine *p_affine = NULL;
-    blst_scalar *scalars = NULL;
+    fr_t *coeffs_filtered = NULL;
 
     /* Tunable parameter: must be at least 2 since blst fails for 0 or 1 */
     const size_t min_length_threshold = 8;
@@ -85,36 +88,25 @@ C_KZG_RET g1_lincomb_fast(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t l
     /* Allocate space for arrays */
     ret = c_kzg_calloc((void **)&p_filtered, len, sizeof(blst_p1));
     if (ret != C_KZG_OK) goto out;
-    ret = c_kzg_calloc((void **)&p_affine, len, sizeof(blst_p1_affine));
+    ret = new_g1_affine_array(&p_affine, len);
     if (ret != C_KZG_OK) goto out;
-    ret = c_kzg_calloc((void **)&scalars, len, sizeof(blst_scalar));
+    ret = new_fr_array(&coeffs_filtered, len);
     if (ret != C_KZG_OK) goto out;
 
-    /* Allocate space for Pippenger scratch */
-    size_t scratch_size = blst_p1s_mult_pippenger_scratch_sizeof(len);
-    ret = c_kzg_malloc((void **)&scratch, scratch_size);
-    if (ret != C_KZG_OK) goto out;
-
-    /* Transform the field elements to 256-bit scalars */
-    for (size_t i = 0; i < len; i++) {
-        blst_scalar_from_fr(&scalars[i], &coeffs[i]);
-    }
-
-    /* Filter out zero points: make a new list p_filtered that contains only non-zero points */
+    /* Filter out zero points and zero coefficients, which don't contribute to the result */
     size_t new_len = 0;
     for (size_t i = 0; i < len; i++) {
-        if (!blst_p1_is_inf(&p[i])) {
+        if (!blst_p1_is_inf(&p[i]) && !fr_equal(&coeffs[i], &FR_ZERO)) {
             /* Copy valid points to the new position */
             p_filtered[new_len] = p[i];
-            scalars[new_len] = scalars[i];
+            coeffs_filtered[new_len] = coeffs[i];
             new_len++;
         }
     }
 
     /* Check if the new length is fine */
     if (new_len < min_length_threshold) {
-        /* We must use the original inputs */
-        g1_lincomb_naive(out, p, coeffs, len);
+        g1_lincomb_naive(out, p_filtered, coeffs_filtered, new_len);
         ret = C_KZG_OK;
         goto out;
     }
@@ -123,16 +115,130 @@ C_KZG_RET g1_lincomb_fast(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t l
     const blst_p1 *p_arg[2] = {p_filtered, NULL};
     blst_p1s_to_affine(p_affine, p_arg, new_len);
 
+    ret = g1_lincomb_affine(out, p_affine, coeffs_filtered, new_len);
+
+out:
+    c_kzg_free(p_filtered);
+    c_kzg_free(p_affine);
+    c_kzg_free(coeffs_filtered);
+    return ret;
+}
+
+/**
+ * Return the number of bits needed to represent a 256-bit scalar.
+ *
+ * @param[in]   bytes   The scalar, in little-endian order
+ */
+static size_t scalar_bit_length(const uint8_t bytes[32]) {
+    for (size_t i = 32; i > 0; i--) {
+        uint8_t top = bytes[i - 1];
+        if (top != 0) {
+            size_t bits = (i - 1) * 8;
+            while (top != 0) {
+                top >>= 1;
+                bits++;
+            }
+            return bits;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Calculate a linear combination of G1 group elements in affine representation.
+ *
+ * Calculates `[coeffs_0]p_0 + [coeffs_1]p_1 + ... + [coeffs_n]p_n` where `n` is `len - 1`.
+ *
+ * This is the Pippenger core of g1_lincomb_fast(). Fixed bases, like those in the trusted setup,
+ * are stored in affine form so that they can be passed here directly, without being copied and
+ * normalized on every call.
+ *
+ * Terms with a zero coefficient are dropped, and the number of bits processed is the bit length of
+ * the largest coefficient rather than BITS_PER_FIELD_ELEMENT. This makes the MSM proportionally
+ * cheaper for sparse or small coefficients, like those of partially filled blobs.
+ *
+ * @param[out]  out     The resulting sum-product
+ * @param[in]   p       Array of G1 group elements in affine representation, length `len`
+ * @param[in]   coeffs  Array of field elements, length `len`
+ * @param[in]   len     The number of group/field elements
+ *
+ * @remark This function should not be called with the point at infinity in `p`.
+ * @remark The remaining points are passed to blst as an array of pointers. The scalars are passed
+ * as a contiguous array, which blst reads with a stride of `(nbits + 7) / 8` bytes, so they are
+ * repacked to that stride once `nbits` is known.
+ */
+C_KZG_RET g1_lincomb_affine(g1_t *out, const blst_p1_affine *p, const fr_t *coeffs, size_t len) {
+    C_KZG_RET ret;
+    limb_t *scratch = NULL;
+    blst_scalar *scalars = NULL;
+    const blst_p1_affine **points = NULL;
+    uint8_t scalars_or[32] = {0};
+    uint8_t *packed;
+    size_t new_len = 0;
+    size_t nbits, nbytes;
+
+    /* Tunable parameter: must be at least 2 since blst fails for 0 or 1 */
+    const size_t min_length_threshold = 8;
+
+    STATS_TIMER_START(timer);
+
+    /* Allocate space for arrays */
+    ret = c_kzg_calloc((void **)&scalars, len, sizeof(blst_scalar));
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&points, len, sizeof(blst_p1_affine *));
+    if (ret != C_KZG_OK) goto out;
+
+    /* Transform the field elements to 256-bit scalars, dropping the zero ones */
+    for (size_t i = 0; i < len; i++) {
+        uint8_t scalar_or = 0;
+        blst_scalar_from_fr(&scalars[new_len], &coeffs[i]);
+        for (size_t j = 0; j < 32; j++) {
+            scalar_or |= scalars[new_len].b[j];
+            scalars_or[j] |= scalars[new_len].b[j];
+        }
+        if (scalar_or != 0) {
+            points[new_len] = &p[i];
+            new_len++;
+        }
+    }
+
+    /* The largest scalar has as many bits as all of the scalars OR-ed together */
+    nbits = scalar_bit_length(scalars_or);
+
+    /* Use naive method if there are too few terms left */
+    if (new_len < min_length_threshold) {
+        g1_t point, tmp;
+        *out = G1_IDENTITY;
+        for (size_t i = 0; i < new_len; i++) {
+            blst_p1_from_affine(&point, points[i]);
+            blst_p1_mult(&tmp, &point, scalars[i].b, nbits);
+            blst_p1_add_or_double(out, out, &tmp);
+        }
+        ret = C_KZG_OK;
+        goto out;
+    }
+
+    /* Repack the scalars to the stride that blst expects for this many bits */
+    nbytes = (nbits + 7) / 8;
+    packed = (uint8_t *)scalars;
+    for (size_t i = 1; i < new_len; i++) {
+        memmove(&packed[i * nbytes], scalars[i].b, nbytes);
+    }
+
+    /* Allocate space for Pippenger scratch */
+    size_t scratch_size = blst_p1s_mult_pippenger_scratch_sizeof(new_len);
+    ret = c_kzg_malloc((void **)&scratch, scratch_size);
+    if (ret != C_KZG_OK) goto out;
+
     /* Call the Pippenger implementation */
-    const byte *scalars_arg[2] = {(byte *)scalars, NULL};
-    const blst_p1_affine *points_arg[2] = {p_affine, NULL};
-    blst_p1s_mult_pippenger(out, points_arg, new_len, scalars_arg, BITS_PER_FIELD_ELEMENT, scratch);
+    const byte *scalars_arg[2] = {packed, NULL};
+    blst_p1s_mult_pippenger(out, points, new_len, scalars_arg, nbits, scratch);
     ret = C_KZG_OK;
 
 out:
     c_kzg_free(scratch);
-    c_kzg_free(p_filtered);
-    c_kzg_free(p_affine);
     c_kzg_free(scalars);
+    c_kzg_free(points);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_MSM);
     return ret;
 }
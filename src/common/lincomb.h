@@ -30,6 +30,7 @@ extern "C" {
 
 void g1_lincomb_naive(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t len);
 C_KZG_RET g1_lincomb_fast(g1_t *out, const g1_t *p, const fr_t *coeffs, size_t len);
+C_KZG_RET g1_lincomb_affine(g1_t *out, const blst_p1_affine *p, const fr_t *coeffs, size_t len);
 
 #ifdef __cplusplus
 }
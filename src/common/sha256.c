@@ -0,0 +1,574 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/sha256.h"
+
+#include <stdbool.h> /* For bool */
+#include <string.h>  /* For memcpy & memset */
+
+/*
+ * On x86-64 with GCC or Clang, blocks are compressed with the SHA extensions, and several messages
+ * can be compressed together in the lanes of AVX2 registers. This code is compiled for those
+ * instructions regardless of the build flags and is only used if the CPU supports them, so binaries
+ * stay portable. Define __BLST_NO_ASM__ to use only the portable code.
+ */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__BLST_NO_ASM__)
+#define SHA256_X86
+#include <cpuid.h>     /* For __get_cpuid_count */
+#include <immintrin.h> /* For SHA & AVX2 intrinsics */
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The initial hash value, from FIPS 180-4 section 5.3.3. */
+static const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/** The round constants, from FIPS 180-4 section 4.2.2. */
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CPU Features
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SHA256_X86
+
+/** True if the CPU has the SHA extensions. */
+static bool sha256_cpu_has_sha_ni = false;
+
+/** True if the CPU and OS support AVX2. */
+static bool sha256_cpu_has_avx2 = false;
+
+/** True if blocks are compressed with the SHA extensions. */
+static bool sha256_have_sha_ni = false;
+
+/** True if messages are compressed together in AVX2 lanes. */
+static bool sha256_have_avx2 = false;
+
+/**
+ * Detect the CPU features once, when the library is loaded.
+ */
+__attribute__((constructor)) static void sha256_detect_cpu_features(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    __builtin_cpu_init();
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        sha256_cpu_has_sha_ni = (ebx >> 29) & 1 && __builtin_cpu_supports("sse4.1");
+    }
+    sha256_cpu_has_avx2 = __builtin_cpu_supports("avx2");
+    sha256_have_sha_ni = sha256_cpu_has_sha_ni;
+    sha256_have_avx2 = sha256_cpu_has_avx2;
+}
+
+#endif /* SHA256_X86 */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Compression
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Rotate a 32-bit word right. */
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+ * Compress 64-byte blocks into the intermediate hash value, in portable C.
+ *
+ * @param[in,out]   state       The intermediate hash value
+ * @param[in]       blocks      The blocks, length `64 * num_blocks`
+ * @param[in]       num_blocks  The number of blocks
+ */
+static void sha256_compress_portable(
+    uint32_t state[8], const uint8_t *blocks, size_t num_blocks
+) {
+    uint32_t w[64];
+
+    for (size_t n = 0; n < num_blocks; n++) {
+        const uint8_t *block = &blocks[n * 64];
+
+        /* Prepare the message schedule */
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 |
+                   (uint32_t)block[4 * i + 2] << 8 | (uint32_t)block[4 * i + 3];
+        }
+        for (size_t i = 16; i < 64; i++) {
+            uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        /* Do the rounds */
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t i = 0; i < 64; i++) {
+            uint32_t s1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+            uint32_t s0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef SHA256_X86
+
+/**
+ * Compress 64-byte blocks into the intermediate hash value, with the SHA extensions.
+ *
+ * @param[in,out]   state       The intermediate hash value
+ * @param[in]       blocks      The blocks, length `64 * num_blocks`
+ * @param[in]       num_blocks  The number of blocks
+ */
+__attribute__((target("sha,sse4.1"))) static void sha256_compress_sha_ni(
+    uint32_t state[8], const uint8_t *blocks, size_t num_blocks
+) {
+    __m128i state0, state1, abef, cdgh, msg, tmp, msgs[4];
+
+    /* Reverses the bytes of each 32-bit word, the message is big-endian */
+    const __m128i bswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    /* The instructions take the state as ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(const void *)&state[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(const void *)&state[4]), 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (size_t n = 0; n < num_blocks; n++) {
+        const uint8_t *block = &blocks[n * 64];
+        abef = state0;
+        cdgh = state1;
+
+        /* Do four rounds at a time, extending the message schedule as we go */
+        for (size_t g = 0; g < 16; g++) {
+            __m128i *cur = &msgs[g % 4];
+            if (g < 4) {
+                msg = _mm_loadu_si128((const __m128i *)(const void *)&block[g * 16]);
+                *cur = _mm_shuffle_epi8(msg, bswap);
+            }
+            msg = _mm_add_epi32(
+                *cur, _mm_loadu_si128((const __m128i *)(const void *)&SHA256_K[g * 4])
+            );
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (g >= 3 && g < 15) {
+                __m128i *next = &msgs[(g + 1) % 4];
+                tmp = _mm_alignr_epi8(*cur, msgs[(g + 3) % 4], 4);
+                *next = _mm_sha256msg2_epu32(_mm_add_epi32(*next, tmp), *cur);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (g >= 1 && g < 13) {
+                msgs[(g + 3) % 4] = _mm_sha256msg1_epu32(msgs[(g + 3) % 4], *cur);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    /* Put the state back in order */
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)(void *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)(void *)&state[4], state1);
+}
+
+#endif /* SHA256_X86 */
+
+/**
+ * Compress 64-byte blocks into the intermediate hash value.
+ *
+ * @param[in,out]   state       The intermediate hash value
+ * @param[in]       blocks      The blocks, length `64 * num_blocks`
+ * @param[in]       num_blocks  The number of blocks
+ */
+static void sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t num_blocks) {
+#ifdef SHA256_X86
+    if (sha256_have_sha_ni) {
+        sha256_compress_sha_ni(state, blocks, num_blocks);
+        return;
+    }
+#endif
+    sha256_compress_portable(state, blocks, num_blocks);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Multi-Lane Compression
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SHA256_X86
+
+/** Rotate each 32-bit lane of an AVX2 register right. */
+#define ROTR32X8(x, n) \
+    _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+/**
+ * Compress blocks of eight messages at once, one message per 32-bit lane of the AVX2 registers.
+ *
+ * @param[in,out]   ctxs        The hashes, length `SHA256_LANES`
+ * @param[in]       blocks      The blocks of each message, length `SHA256_LANES`
+ * @param[in]       num_blocks  The number of blocks per message
+ *
+ * @remark A lane can be filled by repeating another lane's hash and blocks. Both lanes then compute
+ * the same state, so the repeated write is harmless.
+ */
+__attribute__((target("avx2"))) static void sha256_compress_x8(
+    Sha256 *const *ctxs, const uint8_t *const *blocks, size_t num_blocks
+) {
+    __m256i state[8], w[64], r[8], t[8];
+    uint32_t lanes[SHA256_LANES];
+
+    /* Reverses the bytes of each 32-bit word, the message is big-endian */
+    const __m256i bswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+    );
+
+    /* Gather the intermediate hash values, message `k` goes in lane `k` */
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t k = 0; k < SHA256_LANES; k++) {
+            lanes[k] = ctxs[k]->state[i];
+        }
+        state[i] = _mm256_loadu_si256((const __m256i *)(const void *)lanes);
+    }
+
+    for (size_t n = 0; n < num_blocks; n++) {
+        /* Load and transpose the message words, eight words of each message at a time */
+        for (size_t half = 0; half < 2; half++) {
+            for (size_t k = 0; k < SHA256_LANES; k++) {
+                const uint8_t *words = &blocks[k][n * 64 + half * 32];
+                r[k] = _mm256_loadu_si256((const __m256i *)(const void *)words);
+            }
+            for (size_t k = 0; k < 8; k += 2) {
+                t[k] = _mm256_unpacklo_epi32(r[k], r[k + 1]);
+                t[k + 1] = _mm256_unpackhi_epi32(r[k], r[k + 1]);
+            }
+            for (size_t k = 0; k < 8; k += 4) {
+                r[k] = _mm256_unpacklo_epi64(t[k], t[k + 2]);
+                r[k + 1] = _mm256_unpackhi_epi64(t[k], t[k + 2]);
+                r[k + 2] = _mm256_unpacklo_epi64(t[k + 1], t[k + 3]);
+                r[k + 3] = _mm256_unpackhi_epi64(t[k + 1], t[k + 3]);
+            }
+            for (size_t k = 0; k < 4; k++) {
+                t[k] = _mm256_permute2x128_si256(r[k], r[k + 4], 0x20);
+                t[k + 4] = _mm256_permute2x128_si256(r[k], r[k + 4], 0x31);
+            }
+            for (size_t k = 0; k < 8; k++) {
+                w[half * 8 + k] = _mm256_shuffle_epi8(t[k], bswap);
+            }
+        }
+
+        /* Prepare the rest of the message schedule */
+        for (size_t i = 16; i < 64; i++) {
+            __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(ROTR32X8(w[i - 15], 7), ROTR32X8(w[i - 15], 18)),
+                _mm256_srli_epi32(w[i - 15], 3)
+            );
+            __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(ROTR32X8(w[i - 2], 17), ROTR32X8(w[i - 2], 19)),
+                _mm256_srli_epi32(w[i - 2], 10)
+            );
+            w[i] = _mm256_add_epi32(
+                _mm256_add_epi32(w[i - 16], s0), _mm256_add_epi32(w[i - 7], s1)
+            );
+        }
+
+        /* Do the rounds */
+        __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+        __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t i = 0; i < 64; i++) {
+            __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(ROTR32X8(e, 6), ROTR32X8(e, 11)), ROTR32X8(e, 25)
+            );
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i k = _mm256_add_epi32(_mm256_set1_epi32((int)SHA256_K[i]), w[i]);
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1), _mm256_add_epi32(ch, k));
+            __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(ROTR32X8(a, 2), ROTR32X8(a, 13)), ROTR32X8(a, 22)
+            );
+            __m256i maj = _mm256_or_si256(
+                _mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c)
+            );
+            __m256i t2 = _mm256_add_epi32(s0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        state[0] = _mm256_add_epi32(state[0], a);
+        state[1] = _mm256_add_epi32(state[1], b);
+        state[2] = _mm256_add_epi32(state[2], c);
+        state[3] = _mm256_add_epi32(state[3], d);
+        state[4] = _mm256_add_epi32(state[4], e);
+        state[5] = _mm256_add_epi32(state[5], f);
+        state[6] = _mm256_add_epi32(state[6], g);
+        state[7] = _mm256_add_epi32(state[7], h);
+    }
+
+    /* Scatter the intermediate hash values back */
+    for (size_t i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i *)(void *)lanes, state[i]);
+        for (size_t k = 0; k < SHA256_LANES; k++) {
+            ctxs[k]->state[i] = lanes[k];
+        }
+    }
+}
+
+#endif /* SHA256_X86 */
+
+/**
+ * Compress the same number of blocks into each of several hashes.
+ *
+ * @param[in,out]   ctxs        The hashes, length `n`
+ * @param[in]       blocks      The blocks of each message, length `n`
+ * @param[in]       num_blocks  The number of blocks per message
+ * @param[in]       n           The number of hashes
+ *
+ * @remark A group of messages in AVX2 lanes costs about as much as eight messages with the SHA
+ * extensions, or two in portable C. So the lanes are only used for groups that are large enough.
+ */
+static void sha256_compress_many(
+    Sha256 *ctxs, const uint8_t *const *blocks, size_t num_blocks, size_t n
+) {
+    size_t start = 0;
+
+    if (num_blocks == 0) return;
+
+#ifdef SHA256_X86
+    if (sha256_have_avx2) {
+        Sha256 *lane_ctxs[SHA256_LANES];
+        const uint8_t *lane_blocks[SHA256_LANES];
+        size_t min_group_size = sha256_have_sha_ni ? SHA256_LANES : 2;
+        while (n - start >= min_group_size) {
+            size_t count = n - start < SHA256_LANES ? n - start : SHA256_LANES;
+
+            /* Fill unused lanes by repeating the first message of the group */
+            for (size_t k = 0; k < SHA256_LANES; k++) {
+                size_t i = k < count ? start + k : start;
+                lane_ctxs[k] = &ctxs[i];
+                lane_blocks[k] = blocks[i];
+            }
+            sha256_compress_x8(lane_ctxs, lane_blocks, num_blocks);
+            start += count;
+        }
+    }
+#endif
+
+    for (size_t i = start; i < n; i++) {
+        sha256_compress(ctxs[i].state, blocks[i], num_blocks);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Start a new hash.
+ *
+ * @param[out]  ctx The hash to initialize
+ */
+void sha256_init(Sha256 *ctx) {
+    memcpy(ctx->state, SHA256_IV, sizeof(SHA256_IV));
+    ctx->length = 0;
+    ctx->block_length = 0;
+}
+
+/**
+ * Absorb data into a hash.
+ *
+ * @param[in,out]   ctx     The hash
+ * @param[in]       data    The data to absorb, length `size`
+ * @param[in]       size    The number of bytes
+ *
+ * @remark Whole blocks are compressed directly from `data` without being copied.
+ */
+void sha256_update(Sha256 *ctx, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    ctx->length += size;
+
+    /* Top up a partial block first */
+    if (ctx->block_length > 0) {
+        size_t fill = 64 - ctx->block_length;
+        if (size < fill) {
+            memcpy(&ctx->block[ctx->block_length], bytes, size);
+            ctx->block_length += size;
+            return;
+        }
+        memcpy(&ctx->block[ctx->block_length], bytes, fill);
+        sha256_compress(ctx->state, ctx->block, 1);
+        ctx->block_length = 0;
+        bytes += fill;
+        size -= fill;
+    }
+
+    /* Compress whole blocks in place */
+    size_t num_blocks = size / 64;
+    sha256_compress(ctx->state, bytes, num_blocks);
+    bytes += num_blocks * 64;
+    size -= num_blocks * 64;
+
+    /* Keep the remainder for later */
+    memcpy(ctx->block, bytes, size);
+    ctx->block_length = size;
+}
+
+/**
+ * Absorb the same amount of data into each of several hashes.
+ *
+ * This is equivalent to calling sha256_update() on each hash, but the messages are compressed
+ * together when the CPU allows it.
+ *
+ * @param[in,out]   ctxs    The hashes, length `n`
+ * @param[in]       data    The data to absorb into each hash, length `n`
+ * @param[in]       size    The number of bytes for each hash
+ * @param[in]       n       The number of hashes
+ *
+ * @remark Every hash must have absorbed the same number of bytes before.
+ */
+void sha256_update_many(Sha256 *ctxs, const uint8_t *const *data, size_t size, size_t n) {
+    const uint8_t *bytes[SHA256_LANES];
+
+    for (size_t start = 0; start < n; start += SHA256_LANES) {
+        size_t count = n - start < SHA256_LANES ? n - start : SHA256_LANES;
+        size_t remaining = size;
+
+        /* The hashes are in lockstep, so the partial blocks all have the same length */
+        size_t fill = (64 - ctxs[start].block_length) % 64;
+        if (fill > remaining) fill = remaining;
+        for (size_t k = 0; k < count; k++) {
+            sha256_update(&ctxs[start + k], data[start + k], fill);
+            bytes[k] = data[start + k] + fill;
+        }
+        remaining -= fill;
+
+        /* Stop if the data did not even complete the partial blocks */
+        if (ctxs[start].block_length != 0) continue;
+
+        /* Compress whole blocks in place, in parallel lanes */
+        size_t num_blocks = remaining / 64;
+        sha256_compress_many(&ctxs[start], bytes, num_blocks, count);
+
+        /* Keep the remainder for later */
+        for (size_t k = 0; k < count; k++) {
+            const uint8_t *tail = bytes[k] + num_blocks * 64;
+            ctxs[start + k].length += remaining;
+            memcpy(ctxs[start + k].block, tail, remaining - num_blocks * 64);
+            ctxs[start + k].block_length = remaining - num_blocks * 64;
+        }
+    }
+}
+
+/**
+ * Absorb an integer into a hash, as 8 big-endian bytes.
+ *
+ * @param[in,out]   ctx The hash
+ * @param[in]       n   The integer to absorb
+ */
+void sha256_update_uint64(Sha256 *ctx, uint64_t n) {
+    uint8_t bytes[8];
+    for (size_t i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(n >> (8 * (7 - i)));
+    }
+    sha256_update(ctx, bytes, sizeof(bytes));
+}
+
+/**
+ * Finish a hash and output the digest.
+ *
+ * @param[out]  out The 32-byte digest
+ * @param[in]   ctx The hash, which must be initialized again before it is reused
+ */
+void sha256_final(uint8_t out[32], Sha256 *ctx) {
+    uint64_t bit_length = ctx->length * 8;
+
+    /* Append the 1 bit, then pad with zeros up to the length field */
+    ctx->block[ctx->block_length++] = 0x80;
+    if (ctx->block_length > 56) {
+        memset(&ctx->block[ctx->block_length], 0, 64 - ctx->block_length);
+        sha256_compress(ctx->state, ctx->block, 1);
+        ctx->block_length = 0;
+    }
+    memset(&ctx->block[ctx->block_length], 0, 56 - ctx->block_length);
+
+    /* Append the message length in bits */
+    for (size_t i = 0; i < 8; i++) {
+        ctx->block[56 + i] = (uint8_t)(bit_length >> (8 * (7 - i)));
+    }
+    sha256_compress(ctx->state, ctx->block, 1);
+
+    for (size_t i = 0; i < 8; i++) {
+        out[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        out[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        out[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        out[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+/**
+ * Choose which compressors are used, so that tests can check each of them on one machine.
+ *
+ * @param[in]   sha_ni  Whether to compress blocks with the SHA extensions
+ * @param[in]   avx2    Whether to compress messages together in AVX2 lanes
+ *
+ * @retval true if the CPU supports everything that was asked for
+ *
+ * @remark A compressor that the CPU does not support is never used, so passing true for both
+ * restores the detected defaults. This is not thread safe and is only meant for testing.
+ */
+bool sha256_use_compressors(bool sha_ni, bool avx2) {
+#ifdef SHA256_X86
+    sha256_have_sha_ni = sha_ni && sha256_cpu_has_sha_ni;
+    sha256_have_avx2 = avx2 && sha256_cpu_has_avx2;
+    return sha256_have_sha_ni == sha_ni && sha256_have_avx2 == avx2;
+#else
+    return !sha_ni && !avx2;
+#endif
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h> /* For bool */
+#include <stddef.h>  /* For size_t */
+#include <stdint.h>  /* For uint*_t */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The largest number of messages that are compressed together in parallel lanes. */
+#define SHA256_LANES 8
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An incremental SHA-256 hash.
+ *
+ * Data is absorbed in place as it is given to sha256_update(), so that a Fiat-Shamir transcript can
+ * be hashed straight from the caller's buffers instead of being copied into one large buffer first.
+ */
+typedef struct {
+    /** The intermediate hash value. */
+    uint32_t state[8];
+    /** The total number of bytes absorbed. */
+    uint64_t length;
+    /** A partial block that has not been compressed yet. */
+    uint8_t block[64];
+    /** The number of bytes in `block`. */
+    size_t block_length;
+} Sha256;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void sha256_init(Sha256 *ctx);
+void sha256_update(Sha256 *ctx, const void *data, size_t size);
+void sha256_update_many(Sha256 *ctxs, const uint8_t *const *data, size_t size, size_t n);
+void sha256_update_uint64(Sha256 *ctx, uint64_t n);
+void sha256_final(uint8_t out[32], Sha256 *ctx);
+bool sha256_use_compressors(bool sha_ni, bool avx2);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/stats.h"
+
+#include <string.h> /* For memset */
+#include <time.h>   /* For clock_gettime */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Globals
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef C_KZG_STATS
+
+#ifdef _MSC_VER
+#define C_KZG_THREAD_LOCAL __declspec(thread)
+#else
+#define C_KZG_THREAD_LOCAL _Thread_local
+#endif
+
+/** The counters for the current thread. */
+static C_KZG_THREAD_LOCAL KZGStats thread_stats;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Recording
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Get a monotonic timestamp.
+ *
+ * @return The time in nanoseconds since an arbitrary point.
+ */
+uint64_t stats_time_ns(void) {
+    struct timespec ts;
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Record that a phase has finished.
+ *
+ * @param[in]   phase       The phase
+ * @param[in]   start_ns    The timestamp from when the phase started
+ */
+void stats_record_phase(C_KZG_PHASE phase, uint64_t start_ns) {
+    uint64_t end_ns = stats_time_ns();
+    thread_stats.calls[phase]++;
+    thread_stats.nanoseconds[phase] += end_ns - start_ns;
+}
+
+/**
+ * Record an allocation.
+ *
+ * @param[in]   size    The number of bytes allocated
+ */
+void stats_record_alloc(size_t size) {
+    thread_stats.allocations++;
+    thread_stats.bytes_allocated += size;
+}
+
+#endif /* C_KZG_STATS */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Get the counters and timers of the calling thread.
+ *
+ * @param[out]  out The statistics since the last reset
+ *
+ * @remark Every value is zero unless the library was built with C_KZG_STATS defined.
+ * @remark Each thread has its own statistics, so call this on the thread that did the work.
+ */
+void c_kzg_get_stats(KZGStats *out) {
+#ifdef C_KZG_STATS
+    *out = thread_stats;
+#else
+    memset(out, 0, sizeof(KZGStats));
+#endif
+}
+
+/**
+ * Reset the counters and timers of the calling thread to zero.
+ */
+void c_kzg_reset_stats(void) {
+#ifdef C_KZG_STATS
+    memset(&thread_stats, 0, sizeof(KZGStats));
+#endif
+}
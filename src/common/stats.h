@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h> /* For size_t */
+#include <stdint.h> /* For uint64_t */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The internal phases that are timed when built with C_KZG_STATS. */
+typedef enum {
+    C_KZG_PHASE_DECODE,      /**< Converting untrusted bytes to field elements and points. */
+    C_KZG_PHASE_CHALLENGE,   /**< Fiat-Shamir hashing. */
+    C_KZG_PHASE_DEDUPLICATE, /**< Deduplicating commitments. */
+    C_KZG_PHASE_MSM,         /**< Multi-scalar multiplications. */
+    C_KZG_PHASE_INTERPOLATE, /**< Committing to the interpolation polynomials of cells. */
+    C_KZG_PHASE_PAIRING,     /**< Pairing checks. */
+    C_KZG_PHASE_FFT,         /**< FFTs over field elements and G1 points. */
+    C_KZG_PHASE_FK20,        /**< Computing all of the cell proofs with FK20. */
+    C_KZG_PHASE_RECOVERY,    /**< Recovering missing cells. */
+    C_KZG_NUM_PHASES,
+} C_KZG_PHASE;
+
+/**
+ * Counters and timers for the calling thread.
+ *
+ * Phases can be nested (e.g., interpolation does FFTs and an MSM), so the time of a phase includes
+ * the time of any phases inside it.
+ */
+typedef struct {
+    /** The number of times each phase was entered. */
+    uint64_t calls[C_KZG_NUM_PHASES];
+    /** The total time spent in each phase, in nanoseconds. */
+    uint64_t nanoseconds[C_KZG_NUM_PHASES];
+    /** The number of allocations made through c_kzg_malloc() and c_kzg_calloc(). */
+    uint64_t allocations;
+    /** The number of bytes allocated through c_kzg_malloc() and c_kzg_calloc(). */
+    uint64_t bytes_allocated;
+} KZGStats;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Instrumentation is only compiled in when C_KZG_STATS is defined. Otherwise these macros expand to
+ * nothing and c_kzg_get_stats() always reports zeros.
+ */
+#ifdef C_KZG_STATS
+#define STATS_TIMER_START(t) uint64_t t = stats_time_ns()
+#define STATS_TIMER_STOP(t, phase) stats_record_phase(phase, t)
+#define STATS_RECORD_ALLOC(size) stats_record_alloc(size)
+#else
+#define STATS_TIMER_START(t)
+#define STATS_TIMER_STOP(t, phase)
+#define STATS_RECORD_ALLOC(size)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void c_kzg_get_stats(KZGStats *out);
+void c_kzg_reset_stats(void);
+
+#ifdef C_KZG_STATS
+uint64_t stats_time_ns(void);
+void stats_record_phase(C_KZG_PHASE phase, uint64_t start_ns);
+void stats_record_alloc(size_t size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
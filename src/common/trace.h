@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * User-space statically defined tracepoints (USDT) at the phase boundaries of the expensive
+ * operations. These are only compiled in when C_KZG_USDT is defined, which requires <sys/sdt.h>
+ * (from systemtap-sdt-dev or similar). Each probe is a single nop at its call site until a tracer
+ * like perf or bpftrace attaches to it, and its arguments are read from registers. Without the
+ * flag, these macros expand to nothing.
+ *
+ * All probes belong to the `c_kzg` provider. For example, to list them:
+ *
+ *     bpftrace -l 'usdt:/path/to/libckzg.so:c_kzg:*'
+ *
+ * The probes and their arguments are:
+ *
+ *     fk20__start                                  compute_fk20_cell_proofs() entered
+ *     fk20__toeplitz_done                          Toeplitz coefficients transformed
+ *     fk20__msm_done                               Column MSMs done
+ *     fk20__done(ret)                              compute_fk20_cell_proofs() returning
+ *     recover__start(num_cells, num_missing)       recover_cells() entered
+ *     recover__half(from_second_half)              Decoding from a complete half instead
+ *     recover__done(ret)                           recover_cells() returning
+ *     batch__start(n)                              verify_kzg_proof_batch() entered
+ *     batch__challenge_done(n)                     Fiat-Shamir challenges computed
+ *     batch__done(ret, ok)                         verify_kzg_proof_batch() returning
+ *     cell_batch__start(num_cells, num_unique)     Cell commitments deduplicated
+ *     cell_batch__challenge_done(num_cells)        Fiat-Shamir challenges computed
+ *     cell_batch__decode_done(num_cells)           Cells, commitments & proofs decoded
+ *     cell_batch__done(ret)                        Cell batch reduced to a pairing equation
+ */
+#ifdef C_KZG_USDT
+#include <sys/sdt.h>
+#define TRACE_PROBE(name) DTRACE_PROBE(c_kzg, name)
+#define TRACE_PROBE1(name, a) DTRACE_PROBE1(c_kzg, name, a)
+#define TRACE_PROBE2(name, a, b) DTRACE_PROBE2(c_kzg, name, a, b)
+#else
+#define TRACE_PROBE(name)
+#define TRACE_PROBE1(name, a)
+#define TRACE_PROBE2(name, a, b)
+#endif
@@ -16,6 +16,7 @@
 
 #include "common/utils.h"
 #include "common/alloc.h"
+#include "common/stats.h"
 
 #include <assert.h> /* For assert */
 #include <stddef.h> /* For size_t */
@@ -167,6 +168,8 @@ bool pairings_verify(const g1_t *a1, const g2_t *a2, const g1_t *b1, const g2_t
     blst_fp12 loop0, loop1, gt_point;
     blst_p1_affine aa1, bb1;
     blst_p2_affine aa2, bb2;
+    bool ok;
+    STATS_TIMER_START(timer);
 
     /*
      * As an optimisation, we want to invert one of the pairings,
@@ -186,5 +189,71 @@ bool pairings_verify(const g1_t *a1, const g2_t *a2, const g1_t *b1, const g2_t
     blst_fp12_mul(&gt_point, &loop0, &loop1);
     blst_final_exp(&gt_point, &gt_point);
 
-    return blst_fp12_is_one(&gt_point);
+    ok = blst_fp12_is_one(&gt_point);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_PAIRING);
+    return ok;
+}
+
+/**
+ * Perform a product of pairings and test whether it is the identity in G_T.
+ *
+ * Tests whether `e(p[0], q[0]) * e(p[1], q[1]) * ... * e(p[n-1], q[n-1]) == 1`. All of the Miller
+ * loops are evaluated together and only a single final exponentiation is done.
+ *
+ * @param[out]  ok  True if the product of the pairings is one, otherwise false
+ * @param[in]   p   The G1 group points, length `n`
+ * @param[in]   q   The G2 group points, length `n`
+ * @param[in]   n   The number of pairings
+ *
+ * @remark The product of zero pairings is one.
+ */
+C_KZG_RET pairings_product_is_one(bool *ok, const g1_t *p, const g2_t *q, size_t n) {
+    C_KZG_RET ret;
+    blst_fp12 gt_point;
+    blst_p1_affine *p_affine = NULL;
+    blst_p2_affine *q_affine = NULL;
+    const blst_p1_affine **p_ptrs = NULL;
+    const blst_p2_affine **q_ptrs = NULL;
+
+    *ok = false;
+
+    if (n == 0) {
+        *ok = true;
+        return C_KZG_OK;
+    }
+
+    STATS_TIMER_START(timer);
+
+    ret = c_kzg_calloc((void **)&p_affine, n, sizeof(blst_p1_affine));
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&q_affine, n, sizeof(blst_p2_affine));
+    if (ret != C_KZG_OK) goto out;
+    /*
+     * The pointer arrays get a trailing NULL entry. For a single pairing, blst would then read the
+     * points as a contiguous array, which is equivalent.
+     */
+    ret = c_kzg_calloc((void **)&p_ptrs, n + 1, sizeof(blst_p1_affine *));
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&q_ptrs, n + 1, sizeof(blst_p2_affine *));
+    if (ret != C_KZG_OK) goto out;
+
+    for (size_t i = 0; i < n; i++) {
+        blst_p1_to_affine(&p_affine[i], &p[i]);
+        blst_p2_to_affine(&q_affine[i], &q[i]);
+        p_ptrs[i] = &p_affine[i];
+        q_ptrs[i] = &q_affine[i];
+    }
+
+    blst_miller_loop_n(&gt_point, q_ptrs, p_ptrs, n);
+    blst_final_exp(&gt_point, &gt_point);
+
+    *ok = blst_fp12_is_one(&gt_point);
+
+out:
+    c_kzg_free(p_affine);
+    c_kzg_free(q_affine);
+    c_kzg_free(p_ptrs);
+    c_kzg_free(q_ptrs);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_PAIRING);
+    return ret;
 }
@@ -29,12 +29,7 @@
  * the function will set the first FIELD_ELEMENTS_PER_BLOB elements of p.
  */
 C_KZG_RET blob_to_polynomial(fr_t *p, const Blob *blob) {
-    C_KZG_RET ret;
-    for (size_t i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-        ret = bytes_to_bls_field(&p[i], (const Bytes32 *)&blob->bytes[i * BYTES_PER_FIELD_ELEMENT]);
-        if (ret != C_KZG_OK) return ret;
-    }
-    return C_KZG_OK;
+    return bytes_to_bls_field_array(p, NULL, blob->bytes, FIELD_ELEMENTS_PER_BLOB);
 }
 
 /**
@@ -20,6 +20,9 @@
 #include "common/fr.h"
 #include "common/lincomb.h"
 #include "common/ret.h"
+#include "common/sha256.h"
+#include "common/stats.h"
+#include "common/trace.h"
 #include "common/utils.h"
 #include "setup/settings.h"
 
@@ -34,9 +37,6 @@
 /** Length of the domain string. */
 #define DOMAIN_STR_LENGTH 16
 
-/* Input size to the Fiat-Shamir challenge computation. */
-#define CHALLENGE_INPUT_SIZE (DOMAIN_STR_LENGTH + 16 + BYTES_PER_BLOB + BYTES_PER_COMMITMENT)
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Constants
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -56,6 +56,22 @@ typedef struct {
     fr_t evals[FIELD_ELEMENTS_PER_BLOB];
 } Polynomial;
 
+/** The inputs and outputs of decoding a batch of blob proofs into KZG openings. */
+typedef struct {
+    g1_t *commitments_out;
+    fr_t *zs_out;
+    fr_t *ys_out;
+    g1_t *proofs_out;
+    /** Whether each element could be decoded, or NULL to fail on the first that cannot be. */
+    bool *decoded_out;
+    const Blob *blobs;
+    const Bytes48 *commitments_bytes;
+    const Bytes48 *proofs_bytes;
+    /** The challenges from compute_challenges(). */
+    const fr_t *zs;
+    const KZGSettings *s;
+} BlobOpenings;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper Functions
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -145,45 +161,67 @@ static void g2_sub(g2_t *out, const g2_t *a, const g2_t *b) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Return the Fiat-Shamir challenge required to verify `blob` and `commitment`.
+ * Return the Fiat-Shamir challenges required to verify several blobs and commitments.
  *
- * @param[out]  eval_challenge_out  The evaluation challenge
- * @param[in]   blob                A blob
- * @param[in]   commitment          A commitment
+ * @param[out]  eval_challenges_out The evaluation challenges, length `n`
+ * @param[in]   blobs               The blobs, length `n`
+ * @param[in]   commitments_bytes   The commitments, length `n`
+ * @param[in]   n                   The number of blobs/commitments
  *
- * @remark This function should compute challenges even if `n == 0`.
+ * @remark Valid commitments have a unique encoding, so the caller's bytes are hashed directly
+ *         rather than re-compressing the decoded point.
+ * @remark The blobs, which are almost all of the input, are hashed together in parallel lanes.
  */
-static void compute_challenge(fr_t *eval_challenge_out, const Blob *blob, const g1_t *commitment) {
+static void compute_challenges(
+    fr_t *eval_challenges_out, const Blob *blobs, const Bytes48 *commitments_bytes, size_t n
+) {
     Bytes32 eval_challenge;
-    uint8_t bytes[CHALLENGE_INPUT_SIZE];
+    Sha256 ctxs[SHA256_LANES];
+    const uint8_t *blobs_bytes[SHA256_LANES];
+    STATS_TIMER_START(timer);
 
-    /* Pointer tracking `bytes` for writing on top of it */
-    uint8_t *offset = bytes;
+    for (size_t start = 0; start < n; start += SHA256_LANES) {
+        size_t count = n - start < SHA256_LANES ? n - start : SHA256_LANES;
 
-    /* Copy domain separator */
-    memcpy(offset, FIAT_SHAMIR_PROTOCOL_DOMAIN, DOMAIN_STR_LENGTH);
-    offset += DOMAIN_STR_LENGTH;
+        for (size_t k = 0; k < count; k++) {
+            sha256_init(&ctxs[k]);
 
-    /* Copy polynomial degree (16-bytes, big-endian) */
-    bytes_from_uint64(offset, 0);
-    offset += sizeof(uint64_t);
-    bytes_from_uint64(offset, FIELD_ELEMENTS_PER_BLOB);
-    offset += sizeof(uint64_t);
+            /* Absorb domain separator */
+            sha256_update(&ctxs[k], FIAT_SHAMIR_PROTOCOL_DOMAIN, DOMAIN_STR_LENGTH);
 
-    /* Copy blob */
-    memcpy(offset, blob->bytes, BYTES_PER_BLOB);
-    offset += BYTES_PER_BLOB;
+            /* Absorb polynomial degree (16-bytes, big-endian) */
+            sha256_update_uint64(&ctxs[k], 0);
+            sha256_update_uint64(&ctxs[k], FIELD_ELEMENTS_PER_BLOB);
 
-    /* Copy commitment */
-    bytes_from_g1((Bytes48 *)offset, commitment);
-    offset += BYTES_PER_COMMITMENT;
+            blobs_bytes[k] = blobs[start + k].bytes;
+        }
 
-    /* Make sure we wrote the entire buffer */
-    assert(offset == bytes + CHALLENGE_INPUT_SIZE);
+        /* Absorb blobs, in place */
+        sha256_update_many(ctxs, blobs_bytes, BYTES_PER_BLOB, count);
 
-    /* Now let's create the challenge! */
-    blst_sha256(eval_challenge.bytes, bytes, CHALLENGE_INPUT_SIZE);
-    hash_to_bls_field(eval_challenge_out, &eval_challenge);
+        for (size_t k = 0; k < count; k++) {
+            /* Absorb commitment */
+            sha256_update(&ctxs[k], commitments_bytes[start + k].bytes, BYTES_PER_COMMITMENT);
+
+            /* Now let's create the challenge! */
+            sha256_final(eval_challenge.bytes, &ctxs[k]);
+            hash_to_bls_field(&eval_challenges_out[start + k], &eval_challenge);
+        }
+    }
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_CHALLENGE);
+}
+
+/**
+ * Return the Fiat-Shamir challenge required to verify `blob` and `commitment`.
+ *
+ * @param[out]  eval_challenge_out  The evaluation challenge
+ * @param[in]   blob                A blob
+ * @param[in]   commitment_bytes    A commitment, already validated with bytes_to_kzg_commitment()
+ */
+static void compute_challenge(
+    fr_t *eval_challenge_out, const Blob *blob, const Bytes48 *commitment_bytes
+) {
+    compute_challenges(eval_challenge_out, blob, commitment_bytes, 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -191,15 +229,19 @@ static void compute_challenge(fr_t *eval_challenge_out, const Blob *blob, const
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Evaluate a polynomial in evaluation form at a given point.
+ * Evaluate a polynomial in evaluation form at a given point and, optionally, compute the quotient
+ * `q(x) = (p(x) - p(z)) / (x - z)` in evaluation form.
  *
- * @param[out]  out The result of the evaluation
- * @param[in]   p   The polynomial in evaluation form
- * @param[in]   x   The point to evaluate the polynomial at
- * @param[in]   s   The trusted setup
+ * Both the evaluation and the quotient are derived from a single batch inversion of `z - ω_i`.
+ *
+ * @param[out]  y_out   The result of the evaluation
+ * @param[out]  q_out   The quotient polynomial in evaluation form, can be NULL
+ * @param[in]   p       The polynomial in evaluation form
+ * @param[in]   z       The point to evaluate the polynomial at
+ * @param[in]   s       The trusted setup
  */
-static C_KZG_RET evaluate_polynomial_in_evaluation_form(
-    fr_t *out, const Polynomial *p, const fr_t *x, const KZGSettings *s
+static C_KZG_RET evaluate_polynomial_and_quotient(
+    fr_t *y_out, Polynomial *q_out, const Polynomial *p, const fr_t *z, const KZGSettings *s
 ) {
     C_KZG_RET ret;
     fr_t tmp;
@@ -207,6 +249,8 @@ static C_KZG_RET evaluate_polynomial_in_evaluation_form(
     fr_t *inverses = NULL;
     uint64_t i;
     const fr_t *brp_roots_of_unity = s->brp_roots_of_unity;
+    /* m != 0 indicates that the evaluation point z equals root_of_unity[m-1] */
+    uint64_t m = 0;
 
     ret = new_fr_array(&inverses_in, FIELD_ELEMENTS_PER_BLOB);
     if (ret != C_KZG_OK) goto out;
@@ -219,28 +263,60 @@ static C_KZG_RET evaluate_polynomial_in_evaluation_form(
          * given, we can just return the result directly.  Note that special-casing this is
          * necessary, as the formula below would divide by zero otherwise.
          */
-        if (fr_equal(x, &brp_roots_of_unity[i])) {
-            *out = p->evals[i];
-            ret = C_KZG_OK;
-            goto out;
+        if (fr_equal(z, &brp_roots_of_unity[i])) {
+            if (q_out == NULL) {
+                *y_out = p->evals[i];
+                goto out;
+            }
+            /* Invert z itself in this slot, the quotient needs it below */
+            m = i + 1;
+            inverses_in[i] = *z;
+            continue;
         }
-        blst_fr_sub(&inverses_in[i], x, &brp_roots_of_unity[i]);
+        blst_fr_sub(&inverses_in[i], z, &brp_roots_of_unity[i]);
     }
 
     ret = fr_batch_inv(inverses, inverses_in, FIELD_ELEMENTS_PER_BLOB);
     if (ret != C_KZG_OK) goto out;
 
-    *out = FR_ZERO;
+    if (m != 0) {
+        *y_out = p->evals[m - 1];
+    } else {
+        *y_out = FR_ZERO;
+        for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
+            blst_fr_mul(&tmp, &inverses[i], &brp_roots_of_unity[i]);
+            blst_fr_mul(&tmp, &tmp, &p->evals[i]);
+            blst_fr_add(y_out, y_out, &tmp);
+        }
+        fr_from_uint64(&tmp, FIELD_ELEMENTS_PER_BLOB);
+        fr_div(y_out, y_out, &tmp);
+        fr_pow(&tmp, z, FIELD_ELEMENTS_PER_BLOB);
+        blst_fr_sub(&tmp, &tmp, &FR_ONE);
+        blst_fr_mul(y_out, y_out, &tmp);
+    }
+
+    if (q_out == NULL) goto out;
+
     for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-        blst_fr_mul(&tmp, &inverses[i], &brp_roots_of_unity[i]);
-        blst_fr_mul(&tmp, &tmp, &p->evals[i]);
-        blst_fr_add(out, out, &tmp);
+        /* (p_i - y) / (ω_i - z) == (y - p_i) / (z - ω_i) */
+        blst_fr_sub(&q_out->evals[i], y_out, &p->evals[i]);
+        blst_fr_mul(&q_out->evals[i], &q_out->evals[i], &inverses[i]);
+    }
+
+    if (m != 0) { /* ω_{m-1} == z */
+        /*
+         * The quotient at z is \sum_{i != m} (p_i - y) * ω_i / (z * (z - ω_i)). The terms of the
+         * sum are -q_i * ω_i / z, and 1/z is in the inverses where z was.
+         */
+        fr_t sum = FR_ZERO;
+        m--;
+        for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
+            if (i == m) continue;
+            blst_fr_mul(&tmp, &q_out->evals[i], &brp_roots_of_unity[i]);
+            blst_fr_sub(&sum, &sum, &tmp);
+        }
+        blst_fr_mul(&q_out->evals[m], &sum, &inverses[m]);
     }
-    fr_from_uint64(&tmp, FIELD_ELEMENTS_PER_BLOB);
-    fr_div(out, out, &tmp);
-    fr_pow(&tmp, x, FIELD_ELEMENTS_PER_BLOB);
-    blst_fr_sub(&tmp, &tmp, &FR_ONE);
-    blst_fr_mul(out, out, &tmp);
 
 out:
     c_kzg_free(inverses_in);
@@ -248,6 +324,20 @@ out:
     return ret;
 }
 
+/**
+ * Evaluate a polynomial in evaluation form at a given point.
+ *
+ * @param[out]  out The result of the evaluation
+ * @param[in]   p   The polynomial in evaluation form
+ * @param[in]   x   The point to evaluate the polynomial at
+ * @param[in]   s   The trusted setup
+ */
+static C_KZG_RET evaluate_polynomial_in_evaluation_form(
+    fr_t *out, const Polynomial *p, const fr_t *x, const KZGSettings *s
+) {
+    return evaluate_polynomial_and_quotient(out, NULL, p, x, s);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Functions for EIP-4844
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -260,7 +350,7 @@ out:
  * @param[in]   s   The trusted setup
  */
 static C_KZG_RET poly_to_kzg_commitment(g1_t *out, const Polynomial *p, const KZGSettings *s) {
-    return g1_lincomb_fast(
+    return g1_lincomb_affine(
         out, s->g1_values_lagrange_brp, (const fr_t *)(&p->evals), FIELD_ELEMENTS_PER_BLOB
     );
 }
@@ -429,78 +519,20 @@ static C_KZG_RET compute_kzg_proof_impl(
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
-    fr_t *inverses_in = NULL;
-    fr_t *inverses = NULL;
-
-    ret = evaluate_polynomial_in_evaluation_form(y_out, polynomial, z, s);
-    if (ret != C_KZG_OK) goto out;
-
-    fr_t tmp;
     Polynomial q;
-    const fr_t *brp_roots_of_unity = s->brp_roots_of_unity;
-    uint64_t i;
-    /* m != 0 indicates that the evaluation point z equals root_of_unity[m-1] */
-    uint64_t m = 0;
-
-    ret = new_fr_array(&inverses_in, FIELD_ELEMENTS_PER_BLOB);
-    if (ret != C_KZG_OK) goto out;
-    ret = new_fr_array(&inverses, FIELD_ELEMENTS_PER_BLOB);
-    if (ret != C_KZG_OK) goto out;
-
-    for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-        if (fr_equal(z, &brp_roots_of_unity[i])) {
-            /* We are asked to compute a KZG proof inside the domain */
-            m = i + 1;
-            inverses_in[i] = FR_ONE;
-            continue;
-        }
-        // (p_i - y) / (ω_i - z)
-        blst_fr_sub(&q.evals[i], &polynomial->evals[i], y_out);
-        blst_fr_sub(&inverses_in[i], &brp_roots_of_unity[i], z);
-    }
-
-    ret = fr_batch_inv(inverses, inverses_in, FIELD_ELEMENTS_PER_BLOB);
-    if (ret != C_KZG_OK) goto out;
-
-    for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-        blst_fr_mul(&q.evals[i], &q.evals[i], &inverses[i]);
-    }
-
-    if (m != 0) { /* ω_{m-1} == z */
-        q.evals[--m] = FR_ZERO;
-        for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-            if (i == m) continue;
-            /* Build denominator: z * (z - ω_i) */
-            blst_fr_sub(&tmp, z, &brp_roots_of_unity[i]);
-            blst_fr_mul(&inverses_in[i], &tmp, z);
-        }
-
-        ret = fr_batch_inv(inverses, inverses_in, FIELD_ELEMENTS_PER_BLOB);
-        if (ret != C_KZG_OK) goto out;
+    g1_t out_g1;
 
-        for (i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
-            if (i == m) continue;
-            /* Build numerator: ω_i * (p_i - y) */
-            blst_fr_sub(&tmp, &polynomial->evals[i], y_out);
-            blst_fr_mul(&tmp, &tmp, &brp_roots_of_unity[i]);
-            /* Do the division: (p_i - y) * ω_i / (z * (z - ω_i)) */
-            blst_fr_mul(&tmp, &tmp, &inverses[i]);
-            blst_fr_add(&q.evals[m], &q.evals[m], &tmp);
-        }
-    }
+    /* Get y and the quotient from one pass over the polynomial */
+    ret = evaluate_polynomial_and_quotient(y_out, &q, polynomial, z, s);
+    if (ret != C_KZG_OK) return ret;
 
-    g1_t out_g1;
-    ret = g1_lincomb_fast(
+    ret = g1_lincomb_affine(
         &out_g1, s->g1_values_lagrange_brp, (const fr_t *)(&q.evals), FIELD_ELEMENTS_PER_BLOB
     );
-    if (ret != C_KZG_OK) goto out;
+    if (ret != C_KZG_OK) return ret;
 
     bytes_from_g1(proof_out, &out_g1);
-
-out:
-    c_kzg_free(inverses_in);
-    c_kzg_free(inverses);
-    return ret;
+    return C_KZG_OK;
 }
 
 /**
@@ -529,7 +561,7 @@ C_KZG_RET compute_blob_kzg_proof(
     if (ret != C_KZG_OK) goto out;
 
     /* Compute the challenge for the given blob/commitment */
-    compute_challenge(&evaluation_challenge_fr, blob, &commitment_g1);
+    compute_challenge(&evaluation_challenge_fr, blob, commitment_bytes);
 
     /* Call helper function to compute proof and y */
     ret = compute_kzg_proof_impl(out, &y, &polynomial, &evaluation_challenge_fr, s);
@@ -540,41 +572,200 @@ out:
 }
 
 /**
- * Given a blob and its proof, verify that it corresponds to the provided commitment.
+ * Helper function: Compute the commitment to an already-decoded blob and the KZG proof that is used
+ * to verify the blob against that commitment.
  *
- * @param[out]  ok                  True if the proofs are valid, otherwise false
+ * @param[out]  commitment_out  The resulting commitment
+ * @param[out]  proof_out       The resulting proof
+ * @param[in]   blob            The blob, which is hashed into the evaluation challenge
+ * @param[in]   polynomial      The blob's polynomial, as decoded by blob_to_polynomial()
+ * @param[in]   s               The trusted setup
+ */
+static C_KZG_RET compute_blob_kzg_commitment_and_proof(
+    KZGCommitment *commitment_out,
+    KZGProof *proof_out,
+    const Blob *blob,
+    const Polynomial *polynomial,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    g1_t commitment_g1;
+    fr_t evaluation_challenge_fr;
+    fr_t y;
+
+    ret = poly_to_kzg_commitment(&commitment_g1, polynomial, s);
+    if (ret != C_KZG_OK) return ret;
+    bytes_from_g1(commitment_out, &commitment_g1);
+
+    /* The commitment was just encoded, so the challenge can use those bytes */
+    compute_challenge(&evaluation_challenge_fr, blob, commitment_out);
+
+    return compute_kzg_proof_impl(proof_out, &y, polynomial, &evaluation_challenge_fr, s);
+}
+
+/**
+ * Helper function: Decode a blob, its commitment, and its proof, and derive the KZG opening that
+ * the proof claims, optionally with a challenge that was already computed.
+ *
+ * @param[out]  commitment_out      The decoded commitment
+ * @param[out]  z_out               The evaluation challenge for the blob/commitment
+ * @param[out]  y_out               The evaluation of the blob at the challenge
+ * @param[out]  proof_out           The decoded proof
  * @param[in]   blob                Blob to verify
  * @param[in]   commitment_bytes    Commitment to verify
  * @param[in]   proof_bytes         Proof used for verification
+ * @param[in]   z                   The challenge from compute_challenges(), or NULL to compute it
  * @param[in]   s                   The trusted setup
  */
-C_KZG_RET verify_blob_kzg_proof(
-    bool *ok,
+static C_KZG_RET blob_kzg_proof_to_opening_impl(
+    g1_t *commitment_out,
+    fr_t *z_out,
+    fr_t *y_out,
+    g1_t *proof_out,
     const Blob *blob,
     const Bytes48 *commitment_bytes,
     const Bytes48 *proof_bytes,
+    const fr_t *z,
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
     Polynomial polynomial;
-    fr_t evaluation_challenge_fr, y_fr;
-    g1_t commitment_g1, proof_g1;
-
-    *ok = false;
 
     /* Do conversions first to fail fast, compute_challenge is expensive */
-    ret = bytes_to_kzg_commitment(&commitment_g1, commitment_bytes);
+    ret = bytes_to_kzg_commitment(commitment_out, commitment_bytes);
     if (ret != C_KZG_OK) return ret;
     ret = blob_to_polynomial(polynomial.evals, blob);
     if (ret != C_KZG_OK) return ret;
-    ret = bytes_to_kzg_proof(&proof_g1, proof_bytes);
+    ret = bytes_to_kzg_proof(proof_out, proof_bytes);
     if (ret != C_KZG_OK) return ret;
 
-    /* Compute challenge for the blob/commitment */
-    compute_challenge(&evaluation_challenge_fr, blob, &commitment_g1);
+    /* Compute challenge for the blob/commitment, unless the caller already did */
+    if (z != NULL) {
+        *z_out = *z;
+    } else {
+        compute_challenge(z_out, blob, commitment_bytes);
+    }
 
     /* Evaluate challenge to get y */
-    ret = evaluate_polynomial_in_evaluation_form(&y_fr, &polynomial, &evaluation_challenge_fr, s);
+    return evaluate_polynomial_in_evaluation_form(y_out, &polynomial, z_out, s);
+}
+
+/**
+ * Decode the commitment and proof of one element of a batch of blob proofs.
+ *
+ * @param[in,out]   ctx The BlobOpenings
+ * @param[in]       i   The index of the element
+ */
+static C_KZG_RET blob_points_task(void *ctx, size_t i) {
+    const BlobOpenings *o = (const BlobOpenings *)ctx;
+    C_KZG_RET ret = bytes_to_kzg_commitment(&o->commitments_out[i], &o->commitments_bytes[i]);
+    if (ret != C_KZG_OK) return ret;
+    return bytes_to_kzg_proof(&o->proofs_out[i], &o->proofs_bytes[i]);
+}
+
+/**
+ * Decode the blob of one element of a batch of blob proofs and evaluate it at its challenge.
+ *
+ * @param[in,out]   ctx The BlobOpenings
+ * @param[in]       i   The index of the element
+ */
+static C_KZG_RET blob_evaluations_task(void *ctx, size_t i) {
+    const BlobOpenings *o = (const BlobOpenings *)ctx;
+    Polynomial polynomial;
+    C_KZG_RET ret = blob_to_polynomial(polynomial.evals, &o->blobs[i]);
+    if (ret != C_KZG_OK) return ret;
+    return evaluate_polynomial_in_evaluation_form(&o->ys_out[i], &polynomial, &o->zs[i], o->s);
+}
+
+/**
+ * Decode one element of a batch of blob proofs into a KZG opening.
+ *
+ * @param[in,out]   ctx The BlobOpenings
+ * @param[in]       i   The index of the element
+ */
+static C_KZG_RET blob_openings_task(void *ctx, size_t i) {
+    const BlobOpenings *o = (const BlobOpenings *)ctx;
+    C_KZG_RET ret = blob_kzg_proof_to_opening_impl(
+        &o->commitments_out[i],
+        &o->zs_out[i],
+        &o->ys_out[i],
+        &o->proofs_out[i],
+        &o->blobs[i],
+        &o->commitments_bytes[i],
+        &o->proofs_bytes[i],
+        &o->zs[i],
+        o->s
+    );
+    if (o->decoded_out == NULL) return ret;
+
+    /* Record elements which cannot be decoded rather than failing */
+    o->decoded_out[i] = ret == C_KZG_OK;
+    return ret == C_KZG_BADARGS ? C_KZG_OK : ret;
+}
+
+/**
+ * Helper function: Decode a blob, its commitment, and its proof, and derive the KZG opening that
+ * the proof claims.
+ *
+ * This does everything verify_blob_kzg_proof() does except the final pairing check. The result is
+ * a claim that `p(z) == y` for the polynomial committed to by `commitment`.
+ *
+ * @param[out]  commitment_out      The decoded commitment
+ * @param[out]  z_out               The evaluation challenge for the blob/commitment
+ * @param[out]  y_out               The evaluation of the blob at the challenge
+ * @param[out]  proof_out           The decoded proof
+ * @param[in]   blob                Blob to verify
+ * @param[in]   commitment_bytes    Commitment to verify
+ * @param[in]   proof_bytes         Proof used for verification
+ * @param[in]   s                   The trusted setup
+ */
+static C_KZG_RET blob_kzg_proof_to_opening(
+    g1_t *commitment_out,
+    fr_t *z_out,
+    fr_t *y_out,
+    g1_t *proof_out,
+    const Blob *blob,
+    const Bytes48 *commitment_bytes,
+    const Bytes48 *proof_bytes,
+    const KZGSettings *s
+) {
+    return blob_kzg_proof_to_opening_impl(
+        commitment_out, z_out, y_out, proof_out, blob, commitment_bytes, proof_bytes, NULL, s
+    );
+}
+
+/**
+ * Given a blob and its proof, verify that it corresponds to the provided commitment.
+ *
+ * @param[out]  ok                  True if the proofs are valid, otherwise false
+ * @param[in]   blob                Blob to verify
+ * @param[in]   commitment_bytes    Commitment to verify
+ * @param[in]   proof_bytes         Proof used for verification
+ * @param[in]   s                   The trusted setup
+ */
+C_KZG_RET verify_blob_kzg_proof(
+    bool *ok,
+    const Blob *blob,
+    const Bytes48 *commitment_bytes,
+    const Bytes48 *proof_bytes,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t evaluation_challenge_fr, y_fr;
+    g1_t commitment_g1, proof_g1;
+
+    *ok = false;
+
+    ret = blob_kzg_proof_to_opening(
+        &commitment_g1,
+        &evaluation_challenge_fr,
+        &y_fr,
+        &proof_g1,
+        blob,
+        commitment_bytes,
+        proof_bytes,
+        s
+    );
     if (ret != C_KZG_OK) return ret;
 
     /* Call helper to do pairings check */
@@ -584,108 +775,100 @@ C_KZG_RET verify_blob_kzg_proof(
 /**
  * Compute random linear combination challenge scalars for batch verification.
  *
- * @param[out]  r_powers_out    The output challenges
- * @param[in]   commitments_g1  The input commitments
- * @param[in]   zs_fr           The input evaluation points
- * @param[in]   ys_fr           The input evaluation results
- * @param[in]   proofs_g1       The input proofs
+ * @param[out]  r_powers_out        The output challenges, length `n`
+ * @param[in]   commitments_bytes   The input commitments, as given by the caller
+ * @param[in]   zs_fr               The input evaluation points, length `n`
+ * @param[in]   ys_fr               The input evaluation results, length `n`
+ * @param[in]   proofs_bytes        The input proofs, as given by the caller
+ * @param[in]   positions           The index of each element in the byte arrays, or NULL if they
+ *                                  are in order
+ * @param[in]   n                   The number of elements
+ *
+ * @remark The commitments and proofs must have been validated. Valid points have a unique encoding,
+ *         so the caller's bytes are hashed directly rather than re-compressing the decoded points.
  */
-static C_KZG_RET compute_r_powers_for_verify_kzg_proof_batch(
+static void compute_r_powers_for_verify_kzg_proof_batch(
     fr_t *r_powers_out,
-    const g1_t *commitments_g1,
+    const Bytes48 *commitments_bytes,
     const fr_t *zs_fr,
     const fr_t *ys_fr,
-    const g1_t *proofs_g1,
+    const Bytes48 *proofs_bytes,
+    const size_t *positions,
     size_t n
 ) {
-    C_KZG_RET ret;
-    uint8_t *bytes = NULL;
-    Bytes32 r_bytes;
+    Sha256 ctx;
+    Bytes32 r_bytes, field_bytes;
     fr_t r;
-
-    size_t input_size = DOMAIN_STR_LENGTH + sizeof(uint64_t) + sizeof(uint64_t) +
-                        (n * (BYTES_PER_COMMITMENT + 2 * BYTES_PER_FIELD_ELEMENT + BYTES_PER_PROOF)
-                        );
-    ret = c_kzg_malloc((void **)&bytes, input_size);
-    if (ret != C_KZG_OK) goto out;
-
-    /* Pointer tracking `bytes` for writing on top of it */
-    uint8_t *offset = bytes;
+    STATS_TIMER_START(timer);
 
     /* Ensure that the domain string is the correct length */
     assert(strlen(RANDOM_CHALLENGE_DOMAIN_VERIFY_BLOB_KZG_PROOF_BATCH) == DOMAIN_STR_LENGTH);
 
-    /* Copy domain separator */
-    memcpy(offset, RANDOM_CHALLENGE_DOMAIN_VERIFY_BLOB_KZG_PROOF_BATCH, DOMAIN_STR_LENGTH);
-    offset += DOMAIN_STR_LENGTH;
+    sha256_init(&ctx);
+
+    /* Absorb domain separator */
+    sha256_update(&ctx, RANDOM_CHALLENGE_DOMAIN_VERIFY_BLOB_KZG_PROOF_BATCH, DOMAIN_STR_LENGTH);
 
-    /* Copy degree of the polynomial */
-    bytes_from_uint64(offset, FIELD_ELEMENTS_PER_BLOB);
-    offset += sizeof(uint64_t);
+    /* Absorb degree of the polynomial */
+    sha256_update_uint64(&ctx, FIELD_ELEMENTS_PER_BLOB);
 
-    /* Copy number of commitments */
-    bytes_from_uint64(offset, n);
-    offset += sizeof(uint64_t);
+    /* Absorb number of commitments */
+    sha256_update_uint64(&ctx, n);
 
     for (size_t i = 0; i < n; i++) {
-        /* Copy commitment */
-        bytes_from_g1((Bytes48 *)offset, &commitments_g1[i]);
-        offset += BYTES_PER_COMMITMENT;
+        size_t position = positions != NULL ? positions[i] : i;
+
+        /* Absorb commitment */
+        sha256_update(&ctx, commitments_bytes[position].bytes, BYTES_PER_COMMITMENT);
 
-        /* Copy z */
-        bytes_from_bls_field((Bytes32 *)offset, &zs_fr[i]);
-        offset += BYTES_PER_FIELD_ELEMENT;
+        /* Absorb z */
+        bytes_from_bls_field(&field_bytes, &zs_fr[i]);
+        sha256_update(&ctx, field_bytes.bytes, BYTES_PER_FIELD_ELEMENT);
 
-        /* Copy y */
-        bytes_from_bls_field((Bytes32 *)offset, &ys_fr[i]);
-        offset += BYTES_PER_FIELD_ELEMENT;
+        /* Absorb y */
+        bytes_from_bls_field(&field_bytes, &ys_fr[i]);
+        sha256_update(&ctx, field_bytes.bytes, BYTES_PER_FIELD_ELEMENT);
 
-        /* Copy proof */
-        bytes_from_g1((Bytes48 *)offset, &proofs_g1[i]);
-        offset += BYTES_PER_PROOF;
+        /* Absorb proof */
+        sha256_update(&ctx, proofs_bytes[position].bytes, BYTES_PER_PROOF);
     }
 
     /* Now let's create the challenge! */
-    blst_sha256(r_bytes.bytes, bytes, input_size);
+    sha256_final(r_bytes.bytes, &ctx);
     hash_to_bls_field(&r, &r_bytes);
 
     compute_powers(r_powers_out, &r, n);
-
-    /* Make sure we wrote the entire buffer */
-    assert(offset == bytes + input_size);
-
-out:
-    c_kzg_free(bytes);
-    return ret;
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_CHALLENGE);
 }
 
 /**
- * Helper function for verify_blob_kzg_proof_batch(): actually perform the verification.
+ * Helper function: Check a batch of KZG openings with precomputed random challenge scalars.
+ *
+ * Tests whether `e(\sum r^i * Proof_i, [s]) == e(\sum r^i (C_i - [y_i] + z_i * Proof_i), [1])`.
  *
  * @param[out]  ok              True if the proofs are valid, otherwise false
  * @param[in]   commitments_g1  Array of commitments to verify
  * @param[in]   zs_fr           Array of evaluation points for the KZG proofs
  * @param[in]   ys_fr           Array of evaluation results for the KZG proofs
  * @param[in]   proofs_g1       Array of proofs used for verification
+ * @param[in]   r_powers        Array of random challenge scalars, one per proof
  * @param[in]   n               The number of blobs/commitments/proofs
  * @param[in]   s               The trusted setup
  *
  * @remark This function only works for `n > 0`.
- * @remark This function assumes that `n` is trusted and that all input arrays contain `n` elements.
- * `n` should be the actual size of the arrays and not read off a length field in the protocol.
  */
-static C_KZG_RET verify_kzg_proof_batch(
+static C_KZG_RET verify_kzg_proof_batch_with_r_powers(
     bool *ok,
     const g1_t *commitments_g1,
     const fr_t *zs_fr,
     const fr_t *ys_fr,
     const g1_t *proofs_g1,
+    const fr_t *r_powers,
     size_t n,
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
     g1_t proof_lincomb, proof_z_lincomb, C_minus_y_lincomb, rhs_g1;
-    fr_t *r_powers = NULL;
     g1_t *C_minus_y = NULL;
     fr_t *r_times_z = NULL;
 
@@ -694,19 +877,11 @@ static C_KZG_RET verify_kzg_proof_batch(
     *ok = false;
 
     /* First let's allocate our arrays */
-    ret = new_fr_array(&r_powers, n);
-    if (ret != C_KZG_OK) goto out;
     ret = new_g1_array(&C_minus_y, n);
     if (ret != C_KZG_OK) goto out;
     ret = new_fr_array(&r_times_z, n);
     if (ret != C_KZG_OK) goto out;
 
-    /* Compute the random lincomb challenges */
-    ret = compute_r_powers_for_verify_kzg_proof_batch(
-        r_powers, commitments_g1, zs_fr, ys_fr, proofs_g1, n
-    );
-    if (ret != C_KZG_OK) goto out;
-
     /* Compute \sum r^i * Proof_i */
     g1_lincomb_naive(&proof_lincomb, proofs_g1, r_powers, n);
 
@@ -731,12 +906,145 @@ static C_KZG_RET verify_kzg_proof_batch(
     *ok = pairings_verify(&proof_lincomb, &s->g2_values_monomial[1], &rhs_g1, blst_p2_generator());
 
 out:
-    c_kzg_free(r_powers);
     c_kzg_free(C_minus_y);
     c_kzg_free(r_times_z);
     return ret;
 }
 
+/**
+ * Helper function for verify_blob_kzg_proof_batch(): actually perform the verification.
+ *
+ * @param[out]  ok                  True if the proofs are valid, otherwise false
+ * @param[in]   commitments_bytes   Array of commitments as given by the caller
+ * @param[in]   commitments_g1      Array of commitments to verify
+ * @param[in]   zs_fr               Array of evaluation points for the KZG proofs
+ * @param[in]   ys_fr               Array of evaluation results for the KZG proofs
+ * @param[in]   proofs_bytes        Array of proofs as given by the caller
+ * @param[in]   proofs_g1           Array of proofs used for verification
+ * @param[in]   n                   The number of blobs/commitments/proofs
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark This function only works for `n > 0`.
+ * @remark This function assumes that `n` is trusted and that all input arrays contain `n` elements.
+ * `n` should be the actual size of the arrays and not read off a length field in the protocol.
+ */
+static C_KZG_RET verify_kzg_proof_batch(
+    bool *ok,
+    const Bytes48 *commitments_bytes,
+    const g1_t *commitments_g1,
+    const fr_t *zs_fr,
+    const fr_t *ys_fr,
+    const Bytes48 *proofs_bytes,
+    const g1_t *proofs_g1,
+    size_t n,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *r_powers = NULL;
+
+    assert(n > 0);
+
+    *ok = false;
+    TRACE_PROBE1(batch__start, n);
+
+    ret = new_fr_array(&r_powers, n);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Compute the random lincomb challenges */
+    compute_r_powers_for_verify_kzg_proof_batch(
+        r_powers, commitments_bytes, zs_fr, ys_fr, proofs_bytes, NULL, n
+    );
+    TRACE_PROBE1(batch__challenge_done, n);
+
+    ret = verify_kzg_proof_batch_with_r_powers(
+        ok, commitments_g1, zs_fr, ys_fr, proofs_g1, r_powers, n, s
+    );
+
+out:
+    c_kzg_free(r_powers);
+    TRACE_PROBE2(batch__done, (int)ret, (int)*ok);
+    return ret;
+}
+
+/**
+ * Helper function: Find the invalid proofs in a batch by recursive bisection.
+ *
+ * A range that passes is entirely valid. A range that fails is split in half and both halves are
+ * searched. Because the check of a range is the product of the checks of its halves, a failing
+ * range whose left half passes must have a failing right half, so that check is skipped. Finding
+ * `k` invalid proofs among `n` takes about `k * log2(n)` checks.
+ *
+ * @param[out]  valid_out       Whether each proof is valid, length `n`
+ * @param[out]  all_valid_out   True if every proof in the range is valid
+ * @param[in]   commitments_g1  Array of commitments to verify
+ * @param[in]   zs_fr           Array of evaluation points for the KZG proofs
+ * @param[in]   ys_fr           Array of evaluation results for the KZG proofs
+ * @param[in]   proofs_g1       Array of proofs used for verification
+ * @param[in]   r_powers        Array of random challenge scalars, one per proof
+ * @param[in]   n               The number of proofs in the range
+ * @param[in]   known_invalid   True if the range is already known to fail
+ * @param[in]   s               The trusted setup
+ */
+static C_KZG_RET bisect_kzg_proof_batch(
+    bool *valid_out,
+    bool *all_valid_out,
+    const g1_t *commitments_g1,
+    const fr_t *zs_fr,
+    const fr_t *ys_fr,
+    const g1_t *proofs_g1,
+    const fr_t *r_powers,
+    size_t n,
+    bool known_invalid,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    bool ok, left_valid, right_valid;
+    size_t half = n / 2;
+
+    assert(n > 0);
+
+    *all_valid_out = false;
+
+    if (!known_invalid) {
+        ret = verify_kzg_proof_batch_with_r_powers(
+            &ok, commitments_g1, zs_fr, ys_fr, proofs_g1, r_powers, n, s
+        );
+        if (ret != C_KZG_OK) return ret;
+        if (ok) {
+            for (size_t i = 0; i < n; i++) {
+                valid_out[i] = true;
+            }
+            *all_valid_out = true;
+            return C_KZG_OK;
+        }
+    }
+
+    /* A single failing proof is invalid */
+    if (n == 1) {
+        valid_out[0] = false;
+        return C_KZG_OK;
+    }
+
+    ret = bisect_kzg_proof_batch(
+        valid_out, &left_valid, commitments_g1, zs_fr, ys_fr, proofs_g1, r_powers, half, false, s
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    /* If the left half is valid, the right half must be invalid */
+    return bisect_kzg_proof_batch(
+        &valid_out[half],
+        &right_valid,
+        &commitments_g1[half],
+        &zs_fr[half],
+        &ys_fr[half],
+        &proofs_g1[half],
+        &r_powers[half],
+        n - half,
+        left_valid,
+        s
+    );
+}
+
 /**
  * Given a list of blobs and blob KZG proofs, verify that they correspond to the provided
  * commitments.
@@ -765,6 +1073,7 @@ C_KZG_RET verify_blob_kzg_proof_batch(
     g1_t *proofs_g1 = NULL;
     fr_t *evaluation_challenges_fr = NULL;
     fr_t *ys_fr = NULL;
+    BlobOpenings openings;
 
     /* Exit early if we are given zero blobs */
     if (n == 0) {
@@ -787,36 +1096,180 @@ C_KZG_RET verify_blob_kzg_proof_batch(
     ret = new_fr_array(&ys_fr, n);
     if (ret != C_KZG_OK) goto out;
 
-    for (size_t i = 0; i < n; i++) {
-        Polynomial polynomial;
+    openings.commitments_out = commitments_g1;
+    openings.zs_out = evaluation_challenges_fr;
+    openings.ys_out = ys_fr;
+    openings.proofs_out = proofs_g1;
+    openings.decoded_out = NULL;
+    openings.blobs = blobs;
+    openings.commitments_bytes = commitments_bytes;
+    openings.proofs_bytes = proofs_bytes;
+    openings.zs = evaluation_challenges_fr;
+    openings.s = s;
+
+    /* Decode the commitments and proofs first to fail fast, hashing every blob is expensive */
+    ret = run_parallel_for(&s->executor, blob_points_task, &openings, n);
+    if (ret != C_KZG_OK) goto out;
 
-        /* Convert each commitment to a g1 point */
-        ret = bytes_to_kzg_commitment(&commitments_g1[i], &commitments_bytes[i]);
-        if (ret != C_KZG_OK) goto out;
+    /* Hash all of the blobs together, which is faster than one at a time */
+    compute_challenges(evaluation_challenges_fr, blobs, commitments_bytes, n);
 
-        /* Convert each blob from bytes to a poly */
-        ret = blob_to_polynomial(polynomial.evals, &blobs[i]);
-        if (ret != C_KZG_OK) goto out;
+    /* Decode and evaluate the blobs, which are independent of each other */
+    ret = run_parallel_for(&s->executor, blob_evaluations_task, &openings, n);
+    if (ret != C_KZG_OK) goto out;
 
-        compute_challenge(&evaluation_challenges_fr[i], &blobs[i], &commitments_g1[i]);
+    ret = verify_kzg_proof_batch(
+        ok,
+        commitments_bytes,
+        commitments_g1,
+        evaluation_challenges_fr,
+        ys_fr,
+        proofs_bytes,
+        proofs_g1,
+        n,
+        s
+    );
 
-        ret = evaluate_polynomial_in_evaluation_form(
-            &ys_fr[i], &polynomial, &evaluation_challenges_fr[i], s
-        );
-        if (ret != C_KZG_OK) goto out;
+out:
+    c_kzg_free(commitments_g1);
+    c_kzg_free(proofs_g1);
+    c_kzg_free(evaluation_challenges_fr);
+    c_kzg_free(ys_fr);
+    return ret;
+}
 
-        ret = bytes_to_kzg_proof(&proofs_g1[i], &proofs_bytes[i]);
-        if (ret != C_KZG_OK) goto out;
+/**
+ * Given a list of blobs and blob KZG proofs, find out which ones correspond to the provided
+ * commitments.
+ *
+ * The whole batch is checked first, exactly like verify_blob_kzg_proof_batch(). Only if that fails
+ * is the batch bisected, reusing the decoded inputs and the random challenge scalars, to find the
+ * invalid proofs.
+ *
+ * @param[out]  ok                  True if all of the proofs are valid, otherwise false
+ * @param[out]  valid_out           Whether each proof is valid, length `n`
+ * @param[in]   blobs               Array of blobs to verify
+ * @param[in]   commitments_bytes   Array of commitments to verify
+ * @param[in]   proofs_bytes        Array of proofs used for verification
+ * @param[in]   n                   The number of blobs/commitments/proofs
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark Unlike verify_blob_kzg_proof_batch(), a blob, commitment, or proof that cannot be decoded
+ * does not fail the call. The element is reported as invalid instead.
+ * @remark This function accepts if called with `n==0`.
+ */
+C_KZG_RET verify_blob_kzg_proof_batch_with_report(
+    bool *ok,
+    bool *valid_out,
+    const Blob *blobs,
+    const Bytes48 *commitments_bytes,
+    const Bytes48 *proofs_bytes,
+    uint64_t n,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret = C_KZG_OK;
+    bool all_valid;
+    size_t num_decoded = 0;
+    g1_t *commitments_g1 = NULL;
+    g1_t *proofs_g1 = NULL;
+    fr_t *evaluation_challenges_fr = NULL;
+    fr_t *ys_fr = NULL;
+    fr_t *r_powers = NULL;
+    bool *decoded_valid = NULL;
+    size_t *positions = NULL;
+    BlobOpenings openings;
+
+    *ok = false;
+
+    /* Exit early if we are given zero blobs */
+    if (n == 0) {
+        *ok = true;
+        return C_KZG_OK;
     }
 
-    ret = verify_kzg_proof_batch(
-        ok, commitments_g1, evaluation_challenges_fr, ys_fr, proofs_g1, n, s
+    /* We will need a bunch of arrays to store our objects... */
+    ret = new_g1_array(&commitments_g1, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&proofs_g1, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&evaluation_challenges_fr, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&ys_fr, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&r_powers, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_bool_array(&decoded_valid, n);
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&positions, n, sizeof(size_t));
+    if (ret != C_KZG_OK) goto out;
+
+    /* Hash all of the blobs together, which is faster than one at a time */
+    compute_challenges(evaluation_challenges_fr, blobs, commitments_bytes, n);
+
+    /* Decode and evaluate the blobs, noting in valid_out which ones could be decoded */
+    openings.commitments_out = commitments_g1;
+    openings.zs_out = evaluation_challenges_fr;
+    openings.ys_out = ys_fr;
+    openings.proofs_out = proofs_g1;
+    openings.decoded_out = valid_out;
+    openings.blobs = blobs;
+    openings.commitments_bytes = commitments_bytes;
+    openings.proofs_bytes = proofs_bytes;
+    openings.zs = evaluation_challenges_fr;
+    openings.s = s;
+    ret = run_parallel_for(&s->executor, blob_openings_task, &openings, n);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Pack the elements that decoded at the front of the arrays */
+    for (size_t i = 0; i < n; i++) {
+        if (!valid_out[i]) continue;
+        commitments_g1[num_decoded] = commitments_g1[i];
+        evaluation_challenges_fr[num_decoded] = evaluation_challenges_fr[i];
+        ys_fr[num_decoded] = ys_fr[i];
+        proofs_g1[num_decoded] = proofs_g1[i];
+        positions[num_decoded++] = i;
+    }
+
+    /* Exit early if nothing could be decoded */
+    if (num_decoded == 0) goto out;
+
+    /* Compute the random lincomb challenges */
+    compute_r_powers_for_verify_kzg_proof_batch(
+        r_powers,
+        commitments_bytes,
+        evaluation_challenges_fr,
+        ys_fr,
+        proofs_bytes,
+        positions,
+        num_decoded
     );
 
+    ret = bisect_kzg_proof_batch(
+        decoded_valid,
+        &all_valid,
+        commitments_g1,
+        evaluation_challenges_fr,
+        ys_fr,
+        proofs_g1,
+        r_powers,
+        num_decoded,
+        false,
+        s
+    );
+    if (ret != C_KZG_OK) goto out;
+
+    for (size_t i = 0; i < num_decoded; i++) {
+        valid_out[positions[i]] = decoded_valid[i];
+    }
+    *ok = all_valid && num_decoded == n;
+
 out:
     c_kzg_free(commitments_g1);
     c_kzg_free(proofs_g1);
     c_kzg_free(evaluation_challenges_fr);
     c_kzg_free(ys_fr);
+    c_kzg_free(r_powers);
+    c_kzg_free(decoded_valid);
+    c_kzg_free(positions);
     return ret;
 }
@@ -78,6 +78,16 @@ C_KZG_RET verify_blob_kzg_proof_batch(
     const KZGSettings *s
 );
 
+C_KZG_RET verify_blob_kzg_proof_batch_with_report(
+    bool *ok,
+    bool *valid_out,
+    const Blob *blobs,
+    const Bytes48 *commitments_bytes,
+    const Bytes48 *proofs_bytes,
+    uint64_t n,
+    const KZGSettings *s
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,16 @@
 
 #include <stdio.h> /* For printf */
 
+/**
+ * Deserialize a cell (array of bytes) into an array of field elements.
+ *
+ * @param[out]  out     The output field elements, length `FIELD_ELEMENTS_PER_CELL`
+ * @param[in]   cell    The cell (an array of bytes)
+ */
+C_KZG_RET cell_to_field_elements(fr_t *out, const Cell *cell) {
+    return bytes_to_bls_field_array(out, NULL, cell->bytes, FIELD_ELEMENTS_PER_CELL);
+}
+
 /**
  * Print Cell to the console.
  *
@@ -63,6 +63,7 @@ typedef struct {
 extern "C" {
 #endif
 
+C_KZG_RET cell_to_field_elements(fr_t *out, const Cell *cell);
 void print_cell(const Cell *cell);
 
 #ifdef __cplusplus
@@ -18,6 +18,9 @@
 #include "common/alloc.h"
 #include "common/fr.h"
 #include "common/lincomb.h"
+#include "common/sha256.h"
+#include "common/stats.h"
+#include "common/trace.h"
 #include "common/utils.h"
 #include "eip7594/fft.h"
 #include "eip7594/fk20.h"
@@ -34,6 +37,13 @@
 /** Length of the domain string. */
 #define DOMAIN_STR_LENGTH 16
 
+/**
+ * The largest number of wanted cells for which proofs are computed one at a time. Each direct proof
+ * costs an MSM over the setup, so past this point a single FK20 run for every cell is cheaper. See
+ * compute_cells_and_kzg_proofs_for_indices_from_monomial() for the measurements behind it.
+ */
+#define MAX_CELLS_FOR_DIRECT_PROOFS 5
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Constants
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,79 +72,75 @@ static const uint64_t CELL_INDICES_RBL[CELLS_PER_EXT_BLOB] = {
     0x07, 0x47, 0x27, 0x67, 0x17, 0x57, 0x37, 0x77, 0x0f, 0x4f, 0x2f, 0x6f, 0x1f, 0x5f, 0x3f, 0x7f,
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Untrusted points which are to be decoded, one per task. */
+typedef struct {
+    g1_t *out;
+    const Bytes48 *in;
+} G1Decoding;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Compute
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Given a blob, compute all of its cells and proofs.
+ * Helper function: Given a blob and its polynomial in monomial form, compute all of its cells and
+ * proofs.
  *
- * @param[out]  cells   An array of CELLS_PER_EXT_BLOB cells
- * @param[out]  proofs  An array of CELLS_PER_EXT_BLOB proofs
- * @param[in]   blob    The blob to get cells/proofs for
- * @param[in]   s       The trusted setup
+ * The extension is systematic: in bit-reversed order, the first CELLS_PER_BLOB cells are exactly
+ * the blob's own evaluations, so they are copied. Only the other half, the evaluations over the
+ * coset `w * H` where `w` is a primitive FIELD_ELEMENTS_PER_EXT_BLOB-th root of unity, is computed,
+ * with a FIELD_ELEMENTS_PER_BLOB-point FFT.
  *
- * @remark If cells is NULL, they won't be computed.
- * @remark If proofs is NULL, they won't be computed.
- * @remark Will return an error if both cells & proofs are NULL.
+ * @param[out]  cells           An array of CELLS_PER_EXT_BLOB cells, or NULL
+ * @param[out]  proofs          An array of CELLS_PER_EXT_BLOB proofs, or NULL
+ * @param[in]   blob            The blob, only needed for the cells
+ * @param[in]   poly_monomial   The blob's polynomial, FIELD_ELEMENTS_PER_BLOB coefficients long
+ * @param[in]   s               The trusted setup
  */
-C_KZG_RET compute_cells_and_kzg_proofs(
-    Cell *cells, KZGProof *proofs, const Blob *blob, const KZGSettings *s
+static C_KZG_RET compute_cells_and_kzg_proofs_from_monomial(
+    Cell *cells,
+    KZGProof *proofs,
+    const Blob *blob,
+    const fr_t *poly_monomial,
+    const KZGSettings *s
 ) {
-    C_KZG_RET ret;
-    fr_t *poly_monomial = NULL;
-    fr_t *poly_lagrange = NULL;
+    C_KZG_RET ret = C_KZG_OK;
+    fr_t *shifted_poly = NULL;
     fr_t *data_fr = NULL;
     g1_t *proofs_g1 = NULL;
 
-    /* If both of these are null, something is wrong */
-    if (cells == NULL && proofs == NULL) {
-        return C_KZG_BADARGS;
-    }
-
-    /* Allocate space fr-form arrays */
-    ret = new_fr_array(&poly_monomial, FIELD_ELEMENTS_PER_EXT_BLOB);
-    if (ret != C_KZG_OK) goto out;
-    ret = new_fr_array(&poly_lagrange, FIELD_ELEMENTS_PER_EXT_BLOB);
-    if (ret != C_KZG_OK) goto out;
-
-    /*
-     * Convert the blob to a polynomial in lagrange form. Note that only the first 4096 fields of
-     * the polynomial will be set. The upper 4096 fields will remain zero. The extra space is
-     * required because the polynomial will be evaluated to the extended domain (8192 roots of
-     * unity).
-     */
-    ret = blob_to_polynomial(poly_lagrange, blob);
-    if (ret != C_KZG_OK) goto out;
-
-    /* We need the polynomial to be in monomial form */
-    ret = poly_lagrange_to_monomial(poly_monomial, poly_lagrange, FIELD_ELEMENTS_PER_BLOB, s);
-    if (ret != C_KZG_OK) goto out;
-
-    /* Ensure that only the first FIELD_ELEMENTS_PER_BLOB elements can be non-zero */
-    for (size_t i = FIELD_ELEMENTS_PER_BLOB; i < FIELD_ELEMENTS_PER_EXT_BLOB; i++) {
-        assert(fr_equal(&poly_monomial[i], &FR_ZERO));
-    }
-
     if (cells != NULL) {
+        /* The first half of the cells is the blob itself */
+        memcpy(cells, blob->bytes, BYTES_PER_BLOB);
+
         /* Allocate space for our data points */
-        ret = new_fr_array(&data_fr, FIELD_ELEMENTS_PER_EXT_BLOB);
+        ret = new_fr_array(&shifted_poly, FIELD_ELEMENTS_PER_BLOB);
+        if (ret != C_KZG_OK) goto out;
+        ret = new_fr_array(&data_fr, FIELD_ELEMENTS_PER_BLOB);
         if (ret != C_KZG_OK) goto out;
 
-        /* Get the data points via forward transformation */
-        ret = fr_fft(data_fr, poly_monomial, FIELD_ELEMENTS_PER_EXT_BLOB, s);
+        /* Get the other half of the data points via a forward transformation over the coset */
+        memcpy(shifted_poly, poly_monomial, FIELD_ELEMENTS_PER_BLOB * sizeof(fr_t));
+        shift_poly(shifted_poly, FIELD_ELEMENTS_PER_BLOB, &s->roots_of_unity[1]);
+        ret = fr_fft(data_fr, shifted_poly, FIELD_ELEMENTS_PER_BLOB, s);
         if (ret != C_KZG_OK) goto out;
 
         /* Bit-reverse the data points */
-        ret = bit_reversal_permutation(data_fr, sizeof(fr_t), FIELD_ELEMENTS_PER_EXT_BLOB);
+        ret = bit_reversal_permutation(data_fr, sizeof(fr_t), FIELD_ELEMENTS_PER_BLOB);
         if (ret != C_KZG_OK) goto out;
 
-        /* Convert all of the cells to byte-form */
-        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        /* Convert the second half of the cells to byte-form */
+        for (size_t i = 0; i < CELLS_PER_BLOB; i++) {
             for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
                 size_t index = i * FIELD_ELEMENTS_PER_CELL + j;
                 size_t offset = j * BYTES_PER_FIELD_ELEMENT;
-                bytes_from_bls_field((Bytes32 *)&cells[i].bytes[offset], &data_fr[index]);
+                bytes_from_bls_field(
+                    (Bytes32 *)&cells[CELLS_PER_BLOB + i].bytes[offset], &data_fr[index]
+                );
             }
         }
     }
@@ -159,329 +165,756 @@ C_KZG_RET compute_cells_and_kzg_proofs(
     }
 
 out:
-    c_kzg_free(poly_monomial);
-    c_kzg_free(poly_lagrange);
+    c_kzg_free(shifted_poly);
     c_kzg_free(data_fr);
     c_kzg_free(proofs_g1);
     return ret;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// Recover
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 /**
- * Given some cells for a blob, recover all cells/proofs.
+ * Helper function: Given a polynomial in monomial form, compute one of its cells and that cell's
+ * proof directly.
  *
- * @param[out]  recovered_cells     An array of CELLS_PER_EXT_BLOB cells
- * @param[out]  recovered_proofs    An array of CELLS_PER_EXT_BLOB proofs
- * @param[in]   cell_indices        The cell indices for the available cells, length `num_cells`
- * @param[in]   cells               The available cells we recover from, length `num_cells`
- * @param[in]   num_cells           The number of available cells provided
- * @param[in]   s                   The trusted setup
+ * The polynomial is divided by the vanishing polynomial of the cell's coset. The remainder agrees
+ * with the polynomial on the coset, so it gives the cell, and the quotient is what the proof
+ * commits to.
  *
- * @remark At least CELLS_PER_BLOB cells must be provided.
- * @remark Recovery is faster if there are fewer missing cells.
- * @remark If recovered_proofs is NULL, they will not be recomputed.
+ * @param[out]  cell            The cell, or NULL
+ * @param[out]  proof           The cell's proof, or NULL
+ * @param[out]  quotient        Scratch space, FIELD_ELEMENTS_PER_BLOB - FIELD_ELEMENTS_PER_CELL
+ *                              field elements
+ * @param[in]   cell_index      The index of the cell
+ * @param[in]   poly_monomial   The polynomial, FIELD_ELEMENTS_PER_BLOB coefficients long
+ * @param[in]   s               The trusted setup
  */
-C_KZG_RET recover_cells_and_kzg_proofs(
-    Cell *recovered_cells,
-    KZGProof *recovered_proofs,
-    const uint64_t *cell_indices,
-    const Cell *cells,
-    uint64_t num_cells,
+static C_KZG_RET compute_cell_and_kzg_proof_direct(
+    Cell *cell,
+    KZGProof *proof,
+    fr_t *quotient,
+    uint64_t cell_index,
+    const fr_t *poly_monomial,
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
-    fr_t *recovered_cells_fr = NULL;
-    g1_t *recovered_proofs_g1 = NULL;
-
-    /* Ensure only one blob's worth of cells was provided */
-    if (num_cells > CELLS_PER_EXT_BLOB) {
-        ret = C_KZG_BADARGS;
-        goto out;
-    }
-
-    /* Check if it's possible to recover */
-    if (num_cells < CELLS_PER_BLOB) {
-        ret = C_KZG_BADARGS;
-        goto out;
-    }
+    fr_t remainder[FIELD_ELEMENTS_PER_CELL];
+    fr_t evals[FIELD_ELEMENTS_PER_CELL];
+    g1_t proof_g1;
 
-    /* Check that cell indices are valid */
-    for (size_t i = 0; i < num_cells; i++) {
-        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) {
-            ret = C_KZG_BADARGS;
-            goto out;
-        }
-    }
+    /* The cell's coset is h_k * H, on which x^n - h_k^n vanishes */
+    uint64_t cell_idx_rbl = CELL_INDICES_RBL[cell_index];
+    const fr_t *coset_factor = &s->roots_of_unity[cell_idx_rbl];
+    const fr_t *coset_factor_pow = &s->roots_of_unity[cell_idx_rbl * FIELD_ELEMENTS_PER_CELL];
+
+    poly_divide_by_coset_vanishing(
+        quotient,
+        remainder,
+        poly_monomial,
+        FIELD_ELEMENTS_PER_BLOB,
+        FIELD_ELEMENTS_PER_CELL,
+        coset_factor_pow
+    );
 
-    /* Do allocations */
-    ret = new_fr_array(&recovered_cells_fr, FIELD_ELEMENTS_PER_EXT_BLOB);
-    if (ret != C_KZG_OK) goto out;
-    ret = new_g1_array(&recovered_proofs_g1, CELLS_PER_EXT_BLOB);
-    if (ret != C_KZG_OK) goto out;
+    if (cell != NULL) {
+        /* Evaluate the remainder over the coset */
+        shift_poly(remainder, FIELD_ELEMENTS_PER_CELL, coset_factor);
+        ret = fr_fft(evals, remainder, FIELD_ELEMENTS_PER_CELL, s);
+        if (ret != C_KZG_OK) return ret;
 
-    /* Initialize all cells as missing */
-    for (size_t i = 0; i < FIELD_ELEMENTS_PER_EXT_BLOB; i++) {
-        recovered_cells_fr[i] = FR_NULL;
-    }
+        /* Cells hold their evaluations in bit-reversed order */
+        ret = bit_reversal_permutation(evals, sizeof(fr_t), FIELD_ELEMENTS_PER_CELL);
+        if (ret != C_KZG_OK) return ret;
 
-    /* Populate recovered_cells_fr with available cells at the right places */
-    for (size_t i = 0; i < num_cells; i++) {
-        size_t index = cell_indices[i] * FIELD_ELEMENTS_PER_CELL;
         for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
-            fr_t *ptr = &recovered_cells_fr[index + j];
-
-            /*
-             * Check if the field has already been set. If it has, there was a duplicate cell index
-             * and we can return an error. The compiler will optimize this and the overhead is
-             * practically zero.
-             */
-            if (!fr_is_null(ptr)) {
-                ret = C_KZG_BADARGS;
-                goto out;
-            }
-
-            /* Convert the untrusted input bytes to a field element */
             size_t offset = j * BYTES_PER_FIELD_ELEMENT;
-            ret = bytes_to_bls_field(ptr, (const Bytes32 *)&cells[i].bytes[offset]);
-            if (ret != C_KZG_OK) goto out;
-        }
-    }
-
-    if (num_cells == CELLS_PER_EXT_BLOB) {
-        /* Nothing to recover, copy the cells */
-        memcpy(recovered_cells, cells, CELLS_PER_EXT_BLOB * sizeof(Cell));
-    } else {
-        /* Perform cell recovery */
-        ret = recover_cells(recovered_cells_fr, cell_indices, num_cells, recovered_cells_fr, s);
-        if (ret != C_KZG_OK) goto out;
-
-        /* Convert the recovered data points to byte-form */
-        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
-            for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
-                size_t index = i * FIELD_ELEMENTS_PER_CELL + j;
-                size_t offset = j * BYTES_PER_FIELD_ELEMENT;
-                bytes_from_bls_field(
-                    (Bytes32 *)&recovered_cells[i].bytes[offset], &recovered_cells_fr[index]
-                );
-            }
+            bytes_from_bls_field((Bytes32 *)&cell->bytes[offset], &evals[j]);
         }
     }
 
-    if (recovered_proofs != NULL) {
-        /*
-         * Instead of converting the cells to a blob and back, we can just treat the cells as a
-         * polynomial. We are done with the fr-form recovered cells and we can safely mutate the
-         * array.
-         */
-        ret = poly_lagrange_to_monomial(
-            recovered_cells_fr, recovered_cells_fr, FIELD_ELEMENTS_PER_EXT_BLOB, s
+    if (proof != NULL) {
+        /* Commit to the quotient */
+        ret = g1_lincomb_affine(
+            &proof_g1,
+            s->g1_values_monomial,
+            quotient,
+            FIELD_ELEMENTS_PER_BLOB - FIELD_ELEMENTS_PER_CELL
         );
-        if (ret != C_KZG_OK) goto out;
-
-        /* Compute the proofs, only uses the first half of the polynomial */
-        ret = compute_fk20_cell_proofs(recovered_proofs_g1, recovered_cells_fr, s);
-        if (ret != C_KZG_OK) goto out;
-
-        /* Bit-reverse the proofs */
-        ret = bit_reversal_permutation(recovered_proofs_g1, sizeof(g1_t), CELLS_PER_EXT_BLOB);
-        if (ret != C_KZG_OK) goto out;
-
-        /* Convert all of the proofs to byte-form */
-        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
-            bytes_from_g1(&recovered_proofs[i], &recovered_proofs_g1[i]);
-        }
+        if (ret != C_KZG_OK) return ret;
+        bytes_from_g1(proof, &proof_g1);
     }
 
-out:
-    c_kzg_free(recovered_cells_fr);
-    c_kzg_free(recovered_proofs_g1);
-    return ret;
+    return C_KZG_OK;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// Verify
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 /**
- * Helper function to compare two commitments.
+ * Helper function: Given a blob and its polynomial in monomial form, compute some of its cells and
+ * proofs.
  *
- * @param[in]   a   The first commitment
- * @param[in]   b   The second commitment
+ * Up to MAX_CELLS_FOR_DIRECT_PROOFS cells are computed directly, one at a time. For more than that,
+ * every cell is computed with FK20 and the wanted ones are picked out. Either way, cells in the
+ * first half are copied from the blob.
  *
- * @return True if the commitments are the same, otherwise false.
- */
-static bool commitments_equal(const Bytes48 *a, const Bytes48 *b) {
-    return memcmp(a->bytes, b->bytes, BYTES_PER_COMMITMENT) == 0;
-}
-
-/**
- * Helper function to copy one commitment's bytes to another.
+ * The threshold was measured with the compute_cells_and_kzg_proofs_for_indices benchmark, forcing
+ * each path in turn, on a single x86-64 core:
  *
- * @param[in]   dst The destination commitment
- * @param[in]   src The source commitment
- */
-static void commitments_copy(Bytes48 *dst, const Bytes48 *src) {
-    memcpy(dst->bytes, src->bytes, BYTES_PER_COMMITMENT);
-}
-
-/**
- * Convert a list of commitments with potential duplicates to a list of unique commitments. Also
- * returns a list of indices which point to those new unique commitments.
+ *   precompute  direct proofs   FK20     crossover
+ *   0           ~80 ms/cell     ~560 ms  between 6 and 7 cells
+ *   8           ~80 ms/cell     ~380 ms  between 4 and 5 cells
  *
- * @param[in,out]   commitments_out Updated to only contain unique commitments
- * @param[out]      indices_out     Used as map between old/new commitments
- * @param[in,out]   count_out       Number of commitments before and after
+ * The precomputed tables only speed up FK20, so the crossover depends on the setup. Five cells is
+ * within ~6% of the faster path for both. The benchmark's cell counts straddle the threshold, so
+ * it can be checked again on other machines.
  *
- * @remark The input arrays are re-used.
- * @remark The number of commitments/indices must be the same.
- * @remark The length of `indices_out` is unchanged.
- * @remark `count_out` is updated to be the number of unique commitments.
+ * @param[out]  cells           An array of `num_cells` cells, or NULL
+ * @param[out]  proofs          An array of `num_cells` proofs, or NULL
+ * @param[in]   cell_indices    The indices of the wanted cells, length `num_cells`
+ * @param[in]   num_cells       The number of wanted cells
+ * @param[in]   blob            The blob, only needed for the cells
+ * @param[in]   poly_monomial   The blob's polynomial, FIELD_ELEMENTS_PER_BLOB coefficients long
+ * @param[in]   s               The trusted setup
  */
-static void deduplicate_commitments(
-    Bytes48 *commitments_out, uint64_t *indices_out, size_t *count_out
+static C_KZG_RET compute_cells_and_kzg_proofs_for_indices_from_monomial(
+    Cell *cells,
+    KZGProof *proofs,
+    const uint64_t *cell_indices,
+    uint64_t num_cells,
+    const Blob *blob,
+    const fr_t *poly_monomial,
+    const KZGSettings *s
 ) {
-    /* Bail early if there are no commitments */
-    if (*count_out == 0) return;
+    C_KZG_RET ret = C_KZG_OK;
+    fr_t *quotient = NULL;
+    Cell *all_cells = NULL;
+    KZGProof *all_proofs = NULL;
 
-    /* The first commitment is always new */
-    indices_out[0] = 0;
-    size_t new_count = 1;
+    if (num_cells <= MAX_CELLS_FOR_DIRECT_PROOFS) {
+        ret = new_fr_array(&quotient, FIELD_ELEMENTS_PER_BLOB - FIELD_ELEMENTS_PER_CELL);
+        if (ret != C_KZG_OK) goto out;
 
-    /* Create list of unique commitments & indices to them */
-    for (size_t i = 1; i < *count_out; i++) {
-        bool exist = false;
-        for (size_t j = 0; j < new_count; j++) {
-            if (commitments_equal(&commitments_out[i], &commitments_out[j])) {
-                /* This commitment already exists */
-                indices_out[i] = j;
-                exist = true;
-                break;
+        for (size_t i = 0; i < num_cells; i++) {
+            Cell *cell = cells != NULL ? &cells[i] : NULL;
+            KZGProof *proof = proofs != NULL ? &proofs[i] : NULL;
+
+            /* Cells in the first half are the blob itself */
+            if (cell != NULL && cell_indices[i] < CELLS_PER_BLOB) {
+                memcpy(cell, &blob->bytes[cell_indices[i] * BYTES_PER_CELL], BYTES_PER_CELL);
+                cell = NULL;
             }
+            if (cell == NULL && proof == NULL) continue;
+
+            ret = compute_cell_and_kzg_proof_direct(
+                cell,
+                proof,
+                quotient,
+                cell_indices[i],
+                poly_monomial,
+                s
+            );
+            if (ret != C_KZG_OK) goto out;
         }
-        if (!exist) {
-            /* This is a new commitment */
-            commitments_copy(&commitments_out[new_count], &commitments_out[i]);
-            indices_out[i] = new_count;
-            new_count++;
+    } else {
+        if (cells != NULL) {
+            ret = c_kzg_malloc((void **)&all_cells, CELLS_PER_EXT_BLOB * sizeof(Cell));
+            if (ret != C_KZG_OK) goto out;
+        }
+        if (proofs != NULL) {
+            ret = c_kzg_malloc((void **)&all_proofs, CELLS_PER_EXT_BLOB * sizeof(KZGProof));
+            if (ret != C_KZG_OK) goto out;
+        }
+
+        ret = compute_cells_and_kzg_proofs_from_monomial(
+            all_cells, all_proofs, blob, poly_monomial, s
+        );
+        if (ret != C_KZG_OK) goto out;
+
+        for (size_t i = 0; i < num_cells; i++) {
+            if (cells != NULL) cells[i] = all_cells[cell_indices[i]];
+            if (proofs != NULL) proofs[i] = all_proofs[cell_indices[i]];
         }
     }
 
-    /* Update the count */
-    *count_out = new_count;
+out:
+    c_kzg_free(quotient);
+    c_kzg_free(all_cells);
+    c_kzg_free(all_proofs);
+    return ret;
 }
 
 /**
- * Compute random linear combination challenge scalars for verify_cell_kzg_proof_batch. In this, we
- * must hash EVERYTHING that the prover can control.
+ * Given a blob, compute all of its cells and proofs.
  *
- * @param[out]  r_powers_out        The output challenges, length `num_cells`
- * @param[in]   commitments_bytes   The input commitments, length `num_commitments`
- * @param[in]   num_commitments     The number of commitments
- * @param[in]   commitment_indices  The cell commitment indices, length `num_cells`
- * @param[in]   cell_indices        The cell indices, length `num_cells`
- * @param[in]   cells               The cell, length `num_cells`
- * @param[in]   proofs_bytes        The cell proof, length `num_cells`
- * @param[in]   num_cells           The number of cells
+ * @param[out]  cells   An array of CELLS_PER_EXT_BLOB cells
+ * @param[out]  proofs  An array of CELLS_PER_EXT_BLOB proofs
+ * @param[in]   blob    The blob to get cells/proofs for
+ * @param[in]   s       The trusted setup
+ *
+ * @remark If cells is NULL, they won't be computed.
+ * @remark If proofs is NULL, they won't be computed.
+ * @remark Will return an error if both cells & proofs are NULL.
  */
-static C_KZG_RET compute_r_powers_for_verify_cell_kzg_proof_batch(
-    fr_t *r_powers_out,
-    const Bytes48 *commitments_bytes,
-    size_t num_commitments,
-    const uint64_t *commitment_indices,
-    const uint64_t *cell_indices,
-    const Cell *cells,
-    const Bytes48 *proofs_bytes,
-    uint64_t num_cells
+C_KZG_RET compute_cells_and_kzg_proofs(
+    Cell *cells, KZGProof *proofs, const Blob *blob, const KZGSettings *s
 ) {
     C_KZG_RET ret;
-    uint8_t *bytes = NULL;
-    Bytes32 r_bytes;
-    fr_t r;
+    fr_t *poly_monomial = NULL;
+    fr_t *poly_lagrange = NULL;
 
-    /* Calculate the size of the data we're going to hash */
-    size_t input_size = DOMAIN_STR_LENGTH                          /* The domain separator */
-                        + sizeof(uint64_t)                         /* FIELD_ELEMENTS_PER_CELL */
-                        + sizeof(uint64_t)                         /* num_commitments */
-                        + sizeof(uint64_t)                         /* num_cells */
-                        + (num_commitments * BYTES_PER_COMMITMENT) /* commitment_bytes */
-                        + (num_cells * sizeof(uint64_t))           /* commitment_indices */
-                        + (num_cells * sizeof(uint64_t))           /* cell_indices */
-                        + (num_cells * BYTES_PER_CELL)             /* cells */
-                        + (num_cells * BYTES_PER_PROOF);           /* proofs_bytes */
+    /* If both of these are null, something is wrong */
+    if (cells == NULL && proofs == NULL) {
+        return C_KZG_BADARGS;
+    }
 
-    /* Allocate space to copy this data into */
-    ret = c_kzg_malloc((void **)&bytes, input_size);
+    /* Allocate space fr-form arrays */
+    ret = new_fr_array(&poly_monomial, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&poly_lagrange, FIELD_ELEMENTS_PER_BLOB);
     if (ret != C_KZG_OK) goto out;
 
-    /* Pointer tracking `bytes` for writing on top of it */
-    uint8_t *offset = bytes;
-
-    /* Ensure that the domain string is the correct length */
-    assert(strlen(RANDOM_CHALLENGE_DOMAIN_VERIFY_CELL_KZG_PROOF_BATCH) == DOMAIN_STR_LENGTH);
+    /* Convert the blob to a polynomial in lagrange form */
+    ret = blob_to_polynomial(poly_lagrange, blob);
+    if (ret != C_KZG_OK) goto out;
 
-    /* Copy domain separator */
-    memcpy(offset, RANDOM_CHALLENGE_DOMAIN_VERIFY_CELL_KZG_PROOF_BATCH, DOMAIN_STR_LENGTH);
-    offset += DOMAIN_STR_LENGTH;
+    /* We need the polynomial to be in monomial form */
+    ret = poly_lagrange_to_monomial(poly_monomial, poly_lagrange, FIELD_ELEMENTS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+
+    ret = compute_cells_and_kzg_proofs_from_monomial(cells, proofs, blob, poly_monomial, s);
+
+out:
+    c_kzg_free(poly_monomial);
+    c_kzg_free(poly_lagrange);
+    return ret;
+}
+
+/**
+ * Given a blob, compute only some of its cells and proofs.
+ *
+ * This is for nodes that only custody some of the columns. Small sets of cells are computed
+ * directly, which is much cheaper than computing every cell and proof.
+ *
+ * @param[out]  cells           An array of `num_cells` cells
+ * @param[out]  proofs          An array of `num_cells` proofs
+ * @param[in]   cell_indices    The indices of the wanted cells, length `num_cells`
+ * @param[in]   num_cells       The number of wanted cells
+ * @param[in]   blob            The blob to get cells/proofs for
+ * @param[in]   s               The trusted setup
+ *
+ * @remark If cells is NULL, they won't be computed.
+ * @remark If proofs is NULL, they won't be computed.
+ * @remark Will return an error if both cells & proofs are NULL.
+ * @remark The outputs are in the same order as `cell_indices`.
+ */
+C_KZG_RET compute_cells_and_kzg_proofs_for_indices(
+    Cell *cells,
+    KZGProof *proofs,
+    const uint64_t *cell_indices,
+    uint64_t num_cells,
+    const Blob *blob,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *poly_monomial = NULL;
+    fr_t *poly_lagrange = NULL;
+
+    /* If both of these are null, something is wrong */
+    if (cells == NULL && proofs == NULL) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Ensure at most one blob's worth of cells was requested */
+    if (num_cells > CELLS_PER_EXT_BLOB) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Check that cell indices are valid */
+    for (size_t i = 0; i < num_cells; i++) {
+        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) {
+            return C_KZG_BADARGS;
+        }
+    }
+
+    /* Allocate space fr-form arrays */
+    ret = new_fr_array(&poly_monomial, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&poly_lagrange, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+
+    ret = blob_to_polynomial(poly_lagrange, blob);
+    if (ret != C_KZG_OK) goto out;
+    ret = poly_lagrange_to_monomial(poly_monomial, poly_lagrange, FIELD_ELEMENTS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+
+    ret = compute_cells_and_kzg_proofs_for_indices_from_monomial(
+        cells, proofs, cell_indices, num_cells, blob, poly_monomial, s
+    );
+
+out:
+    c_kzg_free(poly_monomial);
+    c_kzg_free(poly_lagrange);
+    return ret;
+}
+
+/**
+ * Given a blob, compute everything needed to publish it: its commitment, its EIP-4844 blob proof,
+ * and all of its cells and cell proofs.
+ *
+ * This is equivalent to calling blob_to_kzg_commitment(), compute_blob_kzg_proof() and
+ * compute_cells_and_kzg_proofs(), but the blob is only decoded once, the commitment is never
+ * decompressed, and the monomial form is shared by the cells and the cell proofs.
+ *
+ * @param[out]  commitment_out  The commitment to the blob
+ * @param[out]  proof_out       The proof used to verify the blob against its commitment
+ * @param[out]  cells           An array of CELLS_PER_EXT_BLOB cells
+ * @param[out]  cell_proofs     An array of CELLS_PER_EXT_BLOB proofs
+ * @param[in]   blob            The blob to compute the sidecar for
+ * @param[in]   s               The trusted setup
+ *
+ * @remark If cells is NULL, they won't be computed.
+ * @remark If cell_proofs is NULL, they won't be computed.
+ */
+C_KZG_RET compute_blob_sidecar(
+    KZGCommitment *commitment_out,
+    KZGProof *proof_out,
+    Cell *cells,
+    KZGProof *cell_proofs,
+    const Blob *blob,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    Polynomial poly_lagrange;
+    fr_t *poly_monomial = NULL;
+
+    /* Allocate space fr-form arrays */
+    ret = new_fr_array(&poly_monomial, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Decode the blob, this is the only time it happens */
+    ret = blob_to_polynomial(poly_lagrange.evals, blob);
+    if (ret != C_KZG_OK) goto out;
+
+    /* The commitment and blob proof work on the lagrange form */
+    ret = compute_blob_kzg_commitment_and_proof(commitment_out, proof_out, blob, &poly_lagrange, s);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Nothing else to do if the caller only wants the commitment and blob proof */
+    if (cells == NULL && cell_proofs == NULL) goto out;
+
+    /* The cells and cell proofs work on the monomial form */
+    ret = poly_lagrange_to_monomial(poly_monomial, poly_lagrange.evals, FIELD_ELEMENTS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+
+    ret = compute_cells_and_kzg_proofs_from_monomial(cells, cell_proofs, blob, poly_monomial, s);
+
+out:
+    c_kzg_free(poly_monomial);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Recover
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Helper function: Given some cells for a blob, recover all of the blob's extended data points.
+ *
+ * @param[out]  recovered_cells_fr  An array of FIELD_ELEMENTS_PER_EXT_BLOB field elements
+ * @param[out]  recovered_poly      An array of FIELD_ELEMENTS_PER_EXT_BLOB field elements for the
+ *                                  blob's polynomial in monomial form, or NULL
+ * @param[in]   cell_indices        The cell indices for the available cells, length `num_cells`
+ * @param[in]   cells               The available cells we recover from, length `num_cells`
+ * @param[in]   num_cells           The number of available cells provided
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark At least CELLS_PER_BLOB cells must be provided.
+ */
+static C_KZG_RET recover_cells_fr_from_cells(
+    fr_t *recovered_cells_fr,
+    fr_t *recovered_poly,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+
+    /* Ensure only one blob's worth of cells was provided */
+    if (num_cells > CELLS_PER_EXT_BLOB) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Check if it's possible to recover */
+    if (num_cells < CELLS_PER_BLOB) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Check that cell indices are valid */
+    for (size_t i = 0; i < num_cells; i++) {
+        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) {
+            return C_KZG_BADARGS;
+        }
+    }
+
+    /* Initialize all cells as missing */
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_EXT_BLOB; i++) {
+        recovered_cells_fr[i] = FR_NULL;
+    }
+
+    /* Populate recovered_cells_fr with available cells at the right places */
+    for (size_t i = 0; i < num_cells; i++) {
+        fr_t *ptr = &recovered_cells_fr[cell_indices[i] * FIELD_ELEMENTS_PER_CELL];
+
+        /*
+         * Check if the cell has already been set. If it has, there was a duplicate cell index and
+         * we can return an error. Cells are always set as a whole, so checking the first field
+         * element is enough.
+         */
+        if (!fr_is_null(ptr)) {
+            return C_KZG_BADARGS;
+        }
+
+        /* Convert the untrusted input bytes to field elements */
+        ret = cell_to_field_elements(ptr, &cells[i]);
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    if (num_cells < CELLS_PER_EXT_BLOB) {
+        /* Perform cell recovery, which also gives us the monomial form */
+        ret = recover_cells(
+            recovered_cells_fr, recovered_poly, cell_indices, num_cells, recovered_cells_fr, s
+        );
+        if (ret != C_KZG_OK) return ret;
+    } else if (recovered_poly != NULL) {
+        /* Nothing to recover, treat the cells as a polynomial */
+        ret = poly_lagrange_to_monomial(
+            recovered_poly, recovered_cells_fr, FIELD_ELEMENTS_PER_EXT_BLOB, s
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    return C_KZG_OK;
+}
+
+/**
+ * Given some cells for a blob, recover all cells/proofs.
+ *
+ * @param[out]  recovered_cells     An array of CELLS_PER_EXT_BLOB cells
+ * @param[out]  recovered_proofs    An array of CELLS_PER_EXT_BLOB proofs
+ * @param[in]   cell_indices        The cell indices for the available cells, length `num_cells`
+ * @param[in]   cells               The available cells we recover from, length `num_cells`
+ * @param[in]   num_cells           The number of available cells provided
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark At least CELLS_PER_BLOB cells must be provided.
+ * @remark Recovery is faster if there are fewer missing cells, and much faster if all of the first
+ * or all of the last CELLS_PER_BLOB cells are available.
+ * @remark If recovered_proofs is NULL, they will not be recomputed.
+ */
+C_KZG_RET recover_cells_and_kzg_proofs(
+    Cell *recovered_cells,
+    KZGProof *recovered_proofs,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *recovered_cells_fr = NULL;
+    fr_t *recovered_poly = NULL;
+    g1_t *recovered_proofs_g1 = NULL;
+
+    /* Do allocations */
+    ret = new_fr_array(&recovered_cells_fr, FIELD_ELEMENTS_PER_EXT_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    if (recovered_proofs != NULL) {
+        ret = new_fr_array(&recovered_poly, FIELD_ELEMENTS_PER_EXT_BLOB);
+        if (ret != C_KZG_OK) goto out;
+        ret = new_g1_array(&recovered_proofs_g1, CELLS_PER_EXT_BLOB);
+        if (ret != C_KZG_OK) goto out;
+    }
+
+    /* The monomial form is only needed for the proofs */
+    ret = recover_cells_fr_from_cells(
+        recovered_cells_fr, recovered_poly, cell_indices, cells, num_cells, s
+    );
+    if (ret != C_KZG_OK) goto out;
+
+    if (num_cells == CELLS_PER_EXT_BLOB) {
+        /* Nothing to recover, copy the cells */
+        memcpy(recovered_cells, cells, CELLS_PER_EXT_BLOB * sizeof(Cell));
+    } else {
+        /* Convert the recovered data points to byte-form */
+        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+            for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
+                size_t index = i * FIELD_ELEMENTS_PER_CELL + j;
+                size_t offset = j * BYTES_PER_FIELD_ELEMENT;
+                bytes_from_bls_field(
+                    (Bytes32 *)&recovered_cells[i].bytes[offset], &recovered_cells_fr[index]
+                );
+            }
+        }
+    }
+
+    if (recovered_proofs != NULL) {
+        /* Compute the proofs, only uses the first half of the polynomial */
+        ret = compute_fk20_cell_proofs(recovered_proofs_g1, recovered_poly, s);
+        if (ret != C_KZG_OK) goto out;
+
+        /* Bit-reverse the proofs */
+        ret = bit_reversal_permutation(recovered_proofs_g1, sizeof(g1_t), CELLS_PER_EXT_BLOB);
+        if (ret != C_KZG_OK) goto out;
+
+        /* Convert all of the proofs to byte-form */
+        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+            bytes_from_g1(&recovered_proofs[i], &recovered_proofs_g1[i]);
+        }
+    }
+
+out:
+    c_kzg_free(recovered_cells_fr);
+    c_kzg_free(recovered_poly);
+    c_kzg_free(recovered_proofs_g1);
+    return ret;
+}
+
+/**
+ * Given some cells for a blob, recover only some of the other cells and proofs.
+ *
+ * This is for nodes that only custody some of the columns. Small sets of proofs are computed
+ * directly, which is much cheaper than computing every proof.
+ *
+ * @param[out]  recovered_cells     An array of `num_wanted_cells` cells, or NULL
+ * @param[out]  recovered_proofs    An array of `num_wanted_cells` proofs, or NULL
+ * @param[in]   wanted_cell_indices The indices of the wanted cells, length `num_wanted_cells`
+ * @param[in]   num_wanted_cells    The number of wanted cells
+ * @param[in]   cell_indices        The cell indices for the available cells, length `num_cells`
+ * @param[in]   cells               The available cells we recover from, length `num_cells`
+ * @param[in]   num_cells           The number of available cells provided
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark At least CELLS_PER_BLOB cells must be provided.
+ * @remark Will return an error if both recovered_cells & recovered_proofs are NULL.
+ * @remark The outputs are in the same order as `wanted_cell_indices`.
+ */
+C_KZG_RET recover_cells_and_kzg_proofs_for_indices(
+    Cell *recovered_cells,
+    KZGProof *recovered_proofs,
+    const uint64_t *wanted_cell_indices,
+    uint64_t num_wanted_cells,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *recovered_cells_fr = NULL;
+    fr_t *recovered_poly = NULL;
+
+    /* If both of these are null, something is wrong */
+    if (recovered_cells == NULL && recovered_proofs == NULL) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Ensure at most one blob's worth of cells was requested */
+    if (num_wanted_cells > CELLS_PER_EXT_BLOB) {
+        return C_KZG_BADARGS;
+    }
+
+    /* Check that wanted cell indices are valid */
+    for (size_t i = 0; i < num_wanted_cells; i++) {
+        if (wanted_cell_indices[i] >= CELLS_PER_EXT_BLOB) {
+            return C_KZG_BADARGS;
+        }
+    }
+
+    ret = new_fr_array(&recovered_cells_fr, FIELD_ELEMENTS_PER_EXT_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    if (recovered_proofs != NULL) {
+        ret = new_fr_array(&recovered_poly, FIELD_ELEMENTS_PER_EXT_BLOB);
+        if (ret != C_KZG_OK) goto out;
+    }
+
+    /* The monomial form is only needed for the proofs */
+    ret = recover_cells_fr_from_cells(
+        recovered_cells_fr, recovered_poly, cell_indices, cells, num_cells, s
+    );
+    if (ret != C_KZG_OK) goto out;
+
+    if (recovered_cells != NULL) {
+        /* The wanted cells are already there, convert them to byte-form */
+        for (size_t i = 0; i < num_wanted_cells; i++) {
+            size_t start = wanted_cell_indices[i] * FIELD_ELEMENTS_PER_CELL;
+            for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
+                size_t offset = j * BYTES_PER_FIELD_ELEMENT;
+                bytes_from_bls_field(
+                    (Bytes32 *)&recovered_cells[i].bytes[offset], &recovered_cells_fr[start + j]
+                );
+            }
+        }
+    }
+
+    if (recovered_proofs != NULL) {
+        ret = compute_cells_and_kzg_proofs_for_indices_from_monomial(
+            NULL, recovered_proofs, wanted_cell_indices, num_wanted_cells, NULL, recovered_poly, s
+        );
+        if (ret != C_KZG_OK) goto out;
+    }
+
+out:
+    c_kzg_free(recovered_cells_fr);
+    c_kzg_free(recovered_poly);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Verify
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Helper function to compare two commitments.
+ *
+ * @param[in]   a   The first commitment
+ * @param[in]   b   The second commitment
+ *
+ * @return True if the commitments are the same, otherwise false.
+ */
+static bool commitments_equal(const Bytes48 *a, const Bytes48 *b) {
+    return memcmp(a->bytes, b->bytes, BYTES_PER_COMMITMENT) == 0;
+}
+
+/**
+ * Helper function to copy one commitment's bytes to another.
+ *
+ * @param[in]   dst The destination commitment
+ * @param[in]   src The source commitment
+ */
+static void commitments_copy(Bytes48 *dst, const Bytes48 *src) {
+    memcpy(dst->bytes, src->bytes, BYTES_PER_COMMITMENT);
+}
+
+/**
+ * Convert a list of commitments with potential duplicates to a list of unique commitments. Also
+ * returns a list of indices which point to those new unique commitments.
+ *
+ * @param[in,out]   commitments_out Updated to only contain unique commitments
+ * @param[out]      indices_out     Used as map between old/new commitments
+ * @param[in,out]   count_out       Number of commitments before and after
+ *
+ * @remark The input arrays are re-used.
+ * @remark The number of commitments/indices must be the same.
+ * @remark The length of `indices_out` is unchanged.
+ * @remark `count_out` is updated to be the number of unique commitments.
+ */
+static void deduplicate_commitments(
+    Bytes48 *commitments_out, uint64_t *indices_out, size_t *count_out
+) {
+    /* Bail early if there are no commitments */
+    if (*count_out == 0) return;
+
+    STATS_TIMER_START(timer);
+
+    /* The first commitment is always new */
+    indices_out[0] = 0;
+    size_t new_count = 1;
+
+    /* Create list of unique commitments & indices to them */
+    for (size_t i = 1; i < *count_out; i++) {
+        bool exist = false;
+        for (size_t j = 0; j < new_count; j++) {
+            if (commitments_equal(&commitments_out[i], &commitments_out[j])) {
+                /* This commitment already exists */
+                indices_out[i] = j;
+                exist = true;
+                break;
+            }
+        }
+        if (!exist) {
+            /* This is a new commitment */
+            commitments_copy(&commitments_out[new_count], &commitments_out[i]);
+            indices_out[i] = new_count;
+            new_count++;
+        }
+    }
+
+    /* Update the count */
+    *count_out = new_count;
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_DEDUPLICATE);
+}
+
+/**
+ * Compute random linear combination challenge scalars for verify_cell_kzg_proof_batch. In this, we
+ * must hash EVERYTHING that the prover can control.
+ *
+ * @param[out]  r_powers_out        The output challenges, length `num_cells`
+ * @param[in]   commitments_bytes   The input commitments, length `num_commitments`
+ * @param[in]   num_commitments     The number of commitments
+ * @param[in]   commitment_indices  The cell commitment indices, length `num_cells`
+ * @param[in]   cell_indices        The cell indices, length `num_cells`
+ * @param[in]   cells               The cell, length `num_cells`
+ * @param[in]   proofs_bytes        The cell proof, length `num_cells`
+ * @param[in]   num_cells           The number of cells
+ */
+static void compute_r_powers_for_verify_cell_kzg_proof_batch(
+    fr_t *r_powers_out,
+    const Bytes48 *commitments_bytes,
+    size_t num_commitments,
+    const uint64_t *commitment_indices,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells
+) {
+    Sha256 ctx;
+    Bytes32 r_bytes;
+    fr_t r;
+    STATS_TIMER_START(timer);
+
+    /* Ensure that the domain string is the correct length */
+    assert(strlen(RANDOM_CHALLENGE_DOMAIN_VERIFY_CELL_KZG_PROOF_BATCH) == DOMAIN_STR_LENGTH);
 
-    /* Copy field elements per cell */
-    bytes_from_uint64(offset, FIELD_ELEMENTS_PER_CELL);
-    offset += sizeof(uint64_t);
+    sha256_init(&ctx);
 
-    /* Copy number of commitments */
-    bytes_from_uint64(offset, num_commitments);
-    offset += sizeof(uint64_t);
+    /* Absorb domain separator */
+    sha256_update(&ctx, RANDOM_CHALLENGE_DOMAIN_VERIFY_CELL_KZG_PROOF_BATCH, DOMAIN_STR_LENGTH);
 
-    /* Copy number of cells */
-    bytes_from_uint64(offset, num_cells);
-    offset += sizeof(uint64_t);
+    /* Absorb field elements per cell */
+    sha256_update_uint64(&ctx, FIELD_ELEMENTS_PER_CELL);
 
-    for (size_t i = 0; i < num_commitments; i++) {
-        /* Copy commitment */
-        memcpy(offset, &commitments_bytes[i], BYTES_PER_COMMITMENT);
-        offset += BYTES_PER_COMMITMENT;
-    }
+    /* Absorb number of commitments */
+    sha256_update_uint64(&ctx, num_commitments);
+
+    /* Absorb number of cells */
+    sha256_update_uint64(&ctx, num_cells);
+
+    /* Absorb commitments, which are contiguous */
+    sha256_update(&ctx, commitments_bytes, num_commitments * BYTES_PER_COMMITMENT);
 
     for (size_t i = 0; i < num_cells; i++) {
-        /* Copy row id */
-        bytes_from_uint64(offset, commitment_indices[i]);
-        offset += sizeof(uint64_t);
+        /* Absorb row id */
+        sha256_update_uint64(&ctx, commitment_indices[i]);
 
-        /* Copy column id */
-        bytes_from_uint64(offset, cell_indices[i]);
-        offset += sizeof(uint64_t);
+        /* Absorb column id */
+        sha256_update_uint64(&ctx, cell_indices[i]);
 
-        /* Copy cell */
-        memcpy(offset, &cells[i], BYTES_PER_CELL);
-        offset += BYTES_PER_CELL;
+        /* Absorb cell, in place */
+        sha256_update(&ctx, &cells[i], BYTES_PER_CELL);
 
-        /* Copy proof */
-        memcpy(offset, &proofs_bytes[i], BYTES_PER_PROOF);
-        offset += BYTES_PER_PROOF;
+        /* Absorb proof */
+        sha256_update(&ctx, &proofs_bytes[i], BYTES_PER_PROOF);
     }
 
     /* Now let's create the challenge! */
-    blst_sha256(r_bytes.bytes, bytes, input_size);
+    sha256_final(r_bytes.bytes, &ctx);
     hash_to_bls_field(&r, &r_bytes);
 
     /* Raise power of r for each cell */
     compute_powers(r_powers_out, &r, num_cells);
-
-    /* Make sure we wrote the entire buffer */
-    assert(offset == bytes + input_size);
-
-out:
-    c_kzg_free(bytes);
-    return ret;
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_CHALLENGE);
 }
 
 /**
  * Compute the sum of the commitments weighted by the powers of r.
  *
  * @param[out]  sum_of_commitments_out  The resulting G1 sum of the commitments
- * @param[in]   unique_commitments      Array of unique commitments, length `num_commitments`
+ * @param[in]   unique_commitments_g1   Array of unique commitments, length `num_commitments`
  * @param[in]   commitment_indices      Indices mapping to unique commitments, length `num_cells`
  * @param[in]   r_powers                Array of powers of r used for weighting, length `num_cells`
  * @param[in]   num_commitments         The number of unique commitments
@@ -489,27 +922,20 @@ out:
  */
 static C_KZG_RET compute_weighted_sum_of_commitments(
     g1_t *sum_of_commitments_out,
-    const Bytes48 *unique_commitments,
+    const g1_t *unique_commitments_g1,
     const uint64_t *commitment_indices,
     const fr_t *r_powers,
     size_t num_commitments,
     uint64_t num_cells
 ) {
     C_KZG_RET ret;
-    g1_t *commitments_g1 = NULL;
     fr_t *commitment_weights = NULL;
 
     ret = new_fr_array(&commitment_weights, num_commitments);
     if (ret != C_KZG_OK) goto out;
-    ret = new_g1_array(&commitments_g1, num_commitments);
-    if (ret != C_KZG_OK) goto out;
 
+    /* Initialize the weights to zero */
     for (size_t i = 0; i < num_commitments; i++) {
-        /* Convert & validate commitment */
-        ret = bytes_to_kzg_commitment(&commitments_g1[i], &unique_commitments[i]);
-        if (ret != C_KZG_OK) goto out;
-
-        /* Initialize the weight to zero */
         commitment_weights[i] = FR_ZERO;
     }
 
@@ -524,13 +950,12 @@ static C_KZG_RET compute_weighted_sum_of_commitments(
 
     /* Compute commitment sum */
     ret = g1_lincomb_fast(
-        sum_of_commitments_out, commitments_g1, commitment_weights, num_commitments
+        sum_of_commitments_out, unique_commitments_g1, commitment_weights, num_commitments
     );
     if (ret != C_KZG_OK) goto out;
 
 out:
     c_kzg_free(commitment_weights);
-    c_kzg_free(commitments_g1);
     return ret;
 }
 
@@ -604,7 +1029,7 @@ static void get_coset_shift_pow_for_cell(
  * @param[out]  commitment_out  Commitment to the aggregated interpolation poly
  * @param[in]   r_powers        Precomputed powers of the random challenge, length `num_cells`
  * @param[in]   cell_indices    Indices of the cells, length `num_cells`
- * @param[in]   cells           Array of cells, length `num_cells`
+ * @param[in]   cells_fr        The field elements of the cells, length `num_cells` cells
  * @param[in]   num_cells       Number of cells
  * @param[in]   s               The trusted setup
  */
@@ -612,7 +1037,7 @@ static C_KZG_RET compute_commitment_to_aggregated_interpolation_poly(
     g1_t *commitment_out,
     const fr_t *r_powers,
     const uint64_t *cell_indices,
-    const Cell *cells,
+    const fr_t *cells_fr,
     uint64_t num_cells,
     const KZGSettings *s
 ) {
@@ -621,6 +1046,7 @@ static C_KZG_RET compute_commitment_to_aggregated_interpolation_poly(
     fr_t *aggregated_column_cells = NULL;
     fr_t *column_interpolation_poly = NULL;
     fr_t *aggregated_interpolation_poly = NULL;
+    STATS_TIMER_START(timer);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Array allocations
@@ -659,17 +1085,13 @@ static C_KZG_RET compute_commitment_to_aggregated_interpolation_poly(
 
         /* Iterate over every field element of this cell: scale it and aggregate it */
         for (size_t fr_index = 0; fr_index < FIELD_ELEMENTS_PER_CELL; fr_index++) {
-            fr_t original_fr, scaled_fr;
+            fr_t scaled_fr;
 
             /* Get the field element at this offset */
-            size_t offset = fr_index * BYTES_PER_FIELD_ELEMENT;
-            ret = bytes_to_bls_field(
-                &original_fr, (const Bytes32 *)&cells[cell_index].bytes[offset]
-            );
-            if (ret != C_KZG_OK) goto out;
+            const fr_t *original_fr = &cells_fr[cell_index * FIELD_ELEMENTS_PER_CELL + fr_index];
 
             /* Scale the field element by the appropriate power of r */
-            blst_fr_mul(&scaled_fr, &original_fr, &r_powers[cell_index]);
+            blst_fr_mul(&scaled_fr, original_fr, &r_powers[cell_index]);
 
             /* Figure out the right index for this field element within the extended array */
             size_t array_index = column_index * FIELD_ELEMENTS_PER_CELL + fr_index;
@@ -697,129 +1119,561 @@ static C_KZG_RET compute_commitment_to_aggregated_interpolation_poly(
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Compute interpolation polynomials using the aggregated cells
+    // Compute interpolation polynomials using the aggregated cells
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /* Start with a zeroed out poly */
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+        aggregated_interpolation_poly[i] = FR_ZERO;
+    }
+
+    /* Interpolate each column */
+    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        /* We can skip columns without any cells */
+        if (!is_cell_used[i]) continue;
+
+        /* Offset to the first cell for this column */
+        size_t index = i * FIELD_ELEMENTS_PER_CELL;
+
+        /*
+         * Reach into the big array and permute the right column.
+         * No need to copy the data, we are not gonna use them again.
+         */
+        ret = bit_reversal_permutation(
+            &aggregated_column_cells[index], sizeof(fr_t), FIELD_ELEMENTS_PER_CELL
+        );
+        if (ret != C_KZG_OK) goto out;
+
+        /*
+         * Get interpolation polynomial for this column. To do so we first do an IDFT over the roots
+         * of unity and then we scale the coefficients by the coset factor. We can't do an IDFT
+         * directly over the coset because it's not a subgroup.
+         */
+        ret = fr_ifft(
+            column_interpolation_poly, &aggregated_column_cells[index], FIELD_ELEMENTS_PER_CELL, s
+        );
+        if (ret != C_KZG_OK) goto out;
+
+        /* Shift the poly by h_k^{-1} where h_k is the coset factor for this cell */
+        fr_t inv_coset_factor;
+        get_inv_coset_shift_for_cell(&inv_coset_factor, i, s);
+        shift_poly(column_interpolation_poly, FIELD_ELEMENTS_PER_CELL, &inv_coset_factor);
+
+        /* Update the aggregated poly */
+        for (size_t k = 0; k < FIELD_ELEMENTS_PER_CELL; k++) {
+            blst_fr_add(
+                &aggregated_interpolation_poly[k],
+                &aggregated_interpolation_poly[k],
+                &column_interpolation_poly[k]
+            );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Commit to the aggregated interpolation polynomial
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = g1_lincomb_affine(
+        commitment_out,
+        s->g1_values_monomial,
+        aggregated_interpolation_poly,
+        FIELD_ELEMENTS_PER_CELL
+    );
+    if (ret != C_KZG_OK) goto out;
+
+out:
+    c_kzg_free(is_cell_used);
+    c_kzg_free(aggregated_column_cells);
+    c_kzg_free(column_interpolation_poly);
+    c_kzg_free(aggregated_interpolation_poly);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_INTERPOLATE);
+    return ret;
+}
+
+/**
+ * Compute weighted sum of proofs.
+ *
+ * @param[out]  weighted_proof_lincomb  The resulting G1 sum of the proofs scaled by coset factors
+ * @param[in]   proofs_g1               Array of proofs, length `num_cells`
+ * @param[in]   r_powers                Array of powers of r used for weighting, length `num_cells`
+ * @param[in]   cell_indices            Array of cell indices, length `num_cells`
+ * @param[in]   num_cells               The number of cells
+ * @param[in]   s                       The trusted setup
+ */
+static C_KZG_RET computed_weighted_sum_of_proofs(
+    g1_t *weighted_proof_sum_out,
+    const g1_t *proofs_g1,
+    const fr_t *r_powers,
+    const uint64_t *cell_indices,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *weighted_powers_of_r = NULL;
+
+    ret = new_fr_array(&weighted_powers_of_r, num_cells);
+    if (ret != C_KZG_OK) goto out;
+
+    for (uint64_t i = 0; i < num_cells; i++) {
+        /* Get scaling factor h_k^n where h_k is the coset factor for this cell */
+        fr_t h_k_pow;
+        get_coset_shift_pow_for_cell(&h_k_pow, cell_indices[i], s);
+
+        /* Scale the power of r by h_k^n */
+        blst_fr_mul(&weighted_powers_of_r[i], &r_powers[i], &h_k_pow);
+    }
+
+    ret = g1_lincomb_fast(weighted_proof_sum_out, proofs_g1, weighted_powers_of_r, num_cells);
+
+out:
+    c_kzg_free(weighted_powers_of_r);
+    return ret;
+}
+
+/**
+ * Helper function: Reduce decoded cells and proofs to a single pairing equation, using precomputed
+ * random challenge scalars.
+ *
+ * The cells are valid if `e(final_g1_sum, [1]) == e(proof_lincomb, [s^n])` where `n` is the number
+ * of field elements per cell.
+ *
+ * @param[out]  final_g1_sum_out        The G1 point to be paired with the G2 generator
+ * @param[out]  proof_lincomb_out       The G1 point to be paired with `[s^n]`
+ * @param[in]   unique_commitments_g1   Array of unique commitments, length `num_commitments`
+ * @param[in]   num_commitments         The number of unique commitments
+ * @param[in]   commitment_indices      Indices mapping to unique commitments, length `num_cells`
+ * @param[in]   cell_indices            The indices for the cells, length `num_cells`
+ * @param[in]   cells_fr                The field elements of the cells, length `num_cells` cells
+ * @param[in]   proofs_g1               The proofs for the cells, length `num_cells`
+ * @param[in]   r_powers                The random challenge scalars, length `num_cells`
+ * @param[in]   num_cells               The number of cells
+ * @param[in]   s                       The trusted setup
+ */
+static C_KZG_RET compute_cell_kzg_proof_batch_equation_with_r_powers(
+    g1_t *final_g1_sum_out,
+    g1_t *proof_lincomb_out,
+    const g1_t *unique_commitments_g1,
+    size_t num_commitments,
+    const uint64_t *commitment_indices,
+    const uint64_t *cell_indices,
+    const fr_t *cells_fr,
+    const g1_t *proofs_g1,
+    const fr_t *r_powers,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    g1_t interpolation_poly_commit;
+    g1_t weighted_sum_of_proofs;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compute random linear combination of the proofs
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = g1_lincomb_fast(proof_lincomb_out, proofs_g1, r_powers, num_cells);
+    if (ret != C_KZG_OK) return ret;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compute sum of the commitments
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = compute_weighted_sum_of_commitments(
+        final_g1_sum_out,
+        unique_commitments_g1,
+        commitment_indices,
+        r_powers,
+        num_commitments,
+        num_cells
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Commit to aggregated interpolation polynomial
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /* Aggregate cells from same columns, sum interpolation polynomials, and commit */
+    ret = compute_commitment_to_aggregated_interpolation_poly(
+        &interpolation_poly_commit, r_powers, cell_indices, cells_fr, num_cells, s
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    /* Subtract commitment from sum by adding the negated commitment */
+    blst_p1_cneg(&interpolation_poly_commit, true);
+    blst_p1_add(final_g1_sum_out, final_g1_sum_out, &interpolation_poly_commit);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compute sum of the proofs scaled by the coset factors
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = computed_weighted_sum_of_proofs(
+        &weighted_sum_of_proofs, proofs_g1, r_powers, cell_indices, num_cells, s
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    blst_p1_add(final_g1_sum_out, final_g1_sum_out, &weighted_sum_of_proofs);
+
+    return C_KZG_OK;
+}
+
+/**
+ * Decode one of a list of proofs.
+ *
+ * @param[in,out]   ctx The G1Decoding
+ * @param[in]       i   The index of the proof
+ */
+static C_KZG_RET decode_proof_task(void *ctx, size_t i) {
+    const G1Decoding *d = (const G1Decoding *)ctx;
+    return bytes_to_kzg_proof(&d->out[i], &d->in[i]);
+}
+
+/**
+ * Decode one of a list of commitments.
+ *
+ * @param[in,out]   ctx The G1Decoding
+ * @param[in]       i   The index of the commitment
+ */
+static C_KZG_RET decode_commitment_task(void *ctx, size_t i) {
+    const G1Decoding *d = (const G1Decoding *)ctx;
+    return bytes_to_kzg_commitment(&d->out[i], &d->in[i]);
+}
+
+/**
+ * Helper function: Reduce a batch of cell proofs to a single pairing equation.
+ *
+ * This does everything verify_cell_kzg_proof_batch() does except the final pairing check. The cells
+ * are valid if `e(final_g1_sum, [1]) == e(proof_lincomb, [s^n])` where `n` is the number of field
+ * elements per cell.
+ *
+ * @param[out]  final_g1_sum_out    The G1 point to be paired with the G2 generator
+ * @param[out]  proof_lincomb_out   The G1 point to be paired with `[s^n]`
+ * @param[in]   commitments_bytes   The commitments for the cells, length `num_cells`
+ * @param[in]   cell_indices        The indices for the cells, length `num_cells`
+ * @param[in]   cells               The cells to check, length `num_cells`
+ * @param[in]   proofs_bytes        The proofs for the cells, length `num_cells`
+ * @param[in]   num_cells           The number of cells provided
+ * @param[in]   s                   The trusted setup
+ *
+ * @remark This function only works for `num_cells > 0`.
+ */
+static C_KZG_RET compute_cell_kzg_proof_batch_equation(
+    g1_t *final_g1_sum_out,
+    g1_t *proof_lincomb_out,
+    const Bytes48 *commitments_bytes,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    size_t num_commitments;
+    G1Decoding proofs, commitments;
+
+    /* Arrays */
+    Bytes48 *unique_commitments = NULL;
+    uint64_t *commitment_indices = NULL;
+    fr_t *r_powers = NULL;
+    g1_t *commitments_g1 = NULL;
+    g1_t *proofs_g1 = NULL;
+    fr_t *cells_fr = NULL;
+
+    assert(num_cells > 0);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Sanity checks
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    for (size_t i = 0; i < num_cells; i++) {
+        /* Make sure column index is valid */
+        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) return C_KZG_BADARGS;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Deduplicate commitments
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = c_kzg_calloc((void **)&unique_commitments, num_cells, sizeof(Bytes48));
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&commitment_indices, num_cells, sizeof(uint64_t));
+    if (ret != C_KZG_OK) goto out;
+
+    /*
+     * Convert the array of cell commitments to an array of unique commitments and an array of
+     * indices to those unique commitments. We do this before the array allocations section below
+     * because we need to know how many commitment weights there will be.
+     */
+    num_commitments = num_cells;
+    memcpy(unique_commitments, commitments_bytes, num_cells * sizeof(Bytes48));
+    deduplicate_commitments(unique_commitments, commitment_indices, &num_commitments);
+    TRACE_PROBE2(cell_batch__start, num_cells, num_commitments);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Array allocations
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = new_fr_array(&r_powers, num_cells);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&commitments_g1, num_commitments);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&proofs_g1, num_cells);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&cells_fr, num_cells * FIELD_ELEMENTS_PER_CELL);
+    if (ret != C_KZG_OK) goto out;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compute powers of r, and extract points and field elements out of input bytes
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    /* Start with a zeroed out poly */
-    for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
-        aggregated_interpolation_poly[i] = FR_ZERO;
-    }
+    /*
+     * Derive random factors for the linear combination. The exponents start with 0. That is, they
+     * are r^0, r^1, r^2, r^3, and so on.
+     */
+    compute_r_powers_for_verify_cell_kzg_proof_batch(
+        r_powers,
+        unique_commitments,
+        num_commitments,
+        commitment_indices,
+        cell_indices,
+        cells,
+        proofs_bytes,
+        num_cells
+    );
+    TRACE_PROBE1(cell_batch__challenge_done, num_cells);
 
-    /* Interpolate each column */
-    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
-        /* We can skip columns without any cells */
-        if (!is_cell_used[i]) continue;
+    /* There should be a proof for each cell, decompressing them is independent */
+    proofs.out = proofs_g1;
+    proofs.in = proofs_bytes;
+    ret = run_parallel_for(&s->executor, decode_proof_task, &proofs, num_cells);
+    if (ret != C_KZG_OK) goto out;
 
-        /* Offset to the first cell for this column */
-        size_t index = i * FIELD_ELEMENTS_PER_CELL;
+    /* Convert & validate the unique commitments */
+    commitments.out = commitments_g1;
+    commitments.in = unique_commitments;
+    ret = run_parallel_for(&s->executor, decode_commitment_task, &commitments, num_commitments);
+    if (ret != C_KZG_OK) goto out;
 
-        /*
-         * Reach into the big array and permute the right column.
-         * No need to copy the data, we are not gonna use them again.
-         */
-        ret = bit_reversal_permutation(
-            &aggregated_column_cells[index], sizeof(fr_t), FIELD_ELEMENTS_PER_CELL
-        );
-        if (ret != C_KZG_OK) goto out;
+    /* Convert all of the cells to field elements at once, cells are contiguous */
+    ret = bytes_to_bls_field_array(
+        cells_fr, NULL, (const uint8_t *)cells, num_cells * FIELD_ELEMENTS_PER_CELL
+    );
+    if (ret != C_KZG_OK) goto out;
+    TRACE_PROBE1(cell_batch__decode_done, num_cells);
 
-        /*
-         * Get interpolation polynomial for this column. To do so we first do an IDFT over the roots
-         * of unity and then we scale the coefficients by the coset factor. We can't do an IDFT
-         * directly over the coset because it's not a subgroup.
-         */
-        ret = fr_ifft(
-            column_interpolation_poly, &aggregated_column_cells[index], FIELD_ELEMENTS_PER_CELL, s
-        );
-        if (ret != C_KZG_OK) goto out;
+    ret = compute_cell_kzg_proof_batch_equation_with_r_powers(
+        final_g1_sum_out,
+        proof_lincomb_out,
+        commitments_g1,
+        num_commitments,
+        commitment_indices,
+        cell_indices,
+        cells_fr,
+        proofs_g1,
+        r_powers,
+        num_cells,
+        s
+    );
 
-        /* Shift the poly by h_k^{-1} where h_k is the coset factor for this cell */
-        fr_t inv_coset_factor;
-        get_inv_coset_shift_for_cell(&inv_coset_factor, i, s);
-        shift_poly(column_interpolation_poly, FIELD_ELEMENTS_PER_CELL, &inv_coset_factor);
+out:
+    c_kzg_free(unique_commitments);
+    c_kzg_free(commitment_indices);
+    c_kzg_free(r_powers);
+    c_kzg_free(commitments_g1);
+    c_kzg_free(proofs_g1);
+    c_kzg_free(cells_fr);
+    TRACE_PROBE1(cell_batch__done, (int)ret);
+    return ret;
+}
 
-        /* Update the aggregated poly */
-        for (size_t k = 0; k < FIELD_ELEMENTS_PER_CELL; k++) {
-            blst_fr_add(
-                &aggregated_interpolation_poly[k],
-                &aggregated_interpolation_poly[k],
-                &column_interpolation_poly[k]
-            );
-        }
+/**
+ * Given some cells, verify that their proofs are valid.
+ *
+ * @param[out]  ok                  True if the proofs are valid
+ * @param[in]   commitments_bytes   The commitments for the cells, length `num_cells`
+ * @param[in]   cell_indices        The indices for the cells, length `num_cells`
+ * @param[in]   cells               The cells to check, length `num_cells`
+ * @param[in]   proofs_bytes        The proofs for the cells, length `num_cells`
+ * @param[in]   num_cells           The number of cells provided
+ * @param[in]   s                   The trusted setup
+ */
+C_KZG_RET verify_cell_kzg_proof_batch(
+    bool *ok,
+    const Bytes48 *commitments_bytes,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    g1_t final_g1_sum;
+    g1_t proof_lincomb;
+    g2_t power_of_s = s->g2_values_monomial[FIELD_ELEMENTS_PER_CELL];
+
+    *ok = false;
+
+    /* Exit early if we are given zero cells */
+    if (num_cells == 0) {
+        *ok = true;
+        return C_KZG_OK;
     }
 
+    /* Reduce the cells to a single pairing equation */
+    ret = compute_cell_kzg_proof_batch_equation(
+        &final_g1_sum,
+        &proof_lincomb,
+        commitments_bytes,
+        cell_indices,
+        cells,
+        proofs_bytes,
+        num_cells,
+        s
+    );
+    if (ret != C_KZG_OK) return ret;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Commit to the aggregated interpolation polynomial
+    // Do the final pairing check
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    ret = g1_lincomb_fast(
-        commitment_out,
-        s->g1_values_monomial,
-        aggregated_interpolation_poly,
-        FIELD_ELEMENTS_PER_CELL
-    );
-    if (ret != C_KZG_OK) goto out;
+    *ok = pairings_verify(&final_g1_sum, blst_p2_generator(), &proof_lincomb, &power_of_s);
 
-out:
-    c_kzg_free(is_cell_used);
-    c_kzg_free(aggregated_column_cells);
-    c_kzg_free(column_interpolation_poly);
-    c_kzg_free(aggregated_interpolation_poly);
-    return ret;
+    return C_KZG_OK;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Verify With Report
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /**
- * Compute weighted sum of proofs.
+ * Helper function: Find the invalid cell proofs in a batch by recursive bisection.
  *
- * @param[out]  weighted_proof_lincomb  The resulting G1 sum of the proofs scaled by coset factors
- * @param[in]   proofs_g1               Array of proofs, length `num_cells`
- * @param[in]   r_powers                Array of powers of r used for weighting, length `num_cells`
- * @param[in]   cell_indices            Array of cell indices, length `num_cells`
- * @param[in]   num_cells               The number of cells
+ * A range that passes is entirely valid. A range that fails is split in half and both halves are
+ * searched. Because the check of a range is the product of the checks of its halves, a failing
+ * range whose left half passes must have a failing right half, so that check is skipped.
+ *
+ * @param[out]  valid_out               Whether each cell is valid, length `num_cells`
+ * @param[out]  all_valid_out           True if every cell in the range is valid
+ * @param[in]   unique_commitments_g1   Array of unique commitments, length `num_commitments`
+ * @param[in]   num_commitments         The number of unique commitments
+ * @param[in]   commitment_indices      Indices mapping to unique commitments, length `num_cells`
+ * @param[in]   cell_indices            The indices for the cells, length `num_cells`
+ * @param[in]   cells_fr                The field elements of the cells, length `num_cells` cells
+ * @param[in]   proofs_g1               The proofs for the cells, length `num_cells`
+ * @param[in]   r_powers                The random challenge scalars, length `num_cells`
+ * @param[in]   num_cells               The number of cells in the range
+ * @param[in]   known_invalid           True if the range is already known to fail
  * @param[in]   s                       The trusted setup
  */
-static C_KZG_RET computed_weighted_sum_of_proofs(
-    g1_t *weighted_proof_sum_out,
+static C_KZG_RET bisect_cell_kzg_proof_batch(
+    bool *valid_out,
+    bool *all_valid_out,
+    const g1_t *unique_commitments_g1,
+    size_t num_commitments,
+    const uint64_t *commitment_indices,
+    const uint64_t *cell_indices,
+    const fr_t *cells_fr,
     const g1_t *proofs_g1,
     const fr_t *r_powers,
-    const uint64_t *cell_indices,
     uint64_t num_cells,
+    bool known_invalid,
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
-    fr_t *weighted_powers_of_r = NULL;
-
-    ret = new_fr_array(&weighted_powers_of_r, num_cells);
-    if (ret != C_KZG_OK) goto out;
+    g1_t final_g1_sum, proof_lincomb;
+    g2_t power_of_s = s->g2_values_monomial[FIELD_ELEMENTS_PER_CELL];
+    bool left_valid, right_valid;
+    uint64_t half = num_cells / 2;
+
+    assert(num_cells > 0);
+
+    *all_valid_out = false;
+
+    if (!known_invalid) {
+        ret = compute_cell_kzg_proof_batch_equation_with_r_powers(
+            &final_g1_sum,
+            &proof_lincomb,
+            unique_commitments_g1,
+            num_commitments,
+            commitment_indices,
+            cell_indices,
+            cells_fr,
+            proofs_g1,
+            r_powers,
+            num_cells,
+            s
+        );
+        if (ret != C_KZG_OK) return ret;
 
-    for (uint64_t i = 0; i < num_cells; i++) {
-        /* Get scaling factor h_k^n where h_k is the coset factor for this cell */
-        fr_t h_k_pow;
-        get_coset_shift_pow_for_cell(&h_k_pow, cell_indices[i], s);
+        if (pairings_verify(&final_g1_sum, blst_p2_generator(), &proof_lincomb, &power_of_s)) {
+            for (uint64_t i = 0; i < num_cells; i++) {
+                valid_out[i] = true;
+            }
+            *all_valid_out = true;
+            return C_KZG_OK;
+        }
+    }
 
-        /* Scale the power of r by h_k^n */
-        blst_fr_mul(&weighted_powers_of_r[i], &r_powers[i], &h_k_pow);
+    /* A single failing cell is invalid */
+    if (num_cells == 1) {
+        valid_out[0] = false;
+        return C_KZG_OK;
     }
 
-    ret = g1_lincomb_fast(weighted_proof_sum_out, proofs_g1, weighted_powers_of_r, num_cells);
+    ret = bisect_cell_kzg_proof_batch(
+        valid_out,
+        &left_valid,
+        unique_commitments_g1,
+        num_commitments,
+        commitment_indices,
+        cell_indices,
+        cells_fr,
+        proofs_g1,
+        r_powers,
+        half,
+        false,
+        s
+    );
+    if (ret != C_KZG_OK) return ret;
 
-out:
-    c_kzg_free(weighted_powers_of_r);
-    return ret;
+    /* If the left half is valid, the right half must be invalid */
+    return bisect_cell_kzg_proof_batch(
+        &valid_out[half],
+        &right_valid,
+        unique_commitments_g1,
+        num_commitments,
+        &commitment_indices[half],
+        &cell_indices[half],
+        &cells_fr[half * FIELD_ELEMENTS_PER_CELL],
+        &proofs_g1[half],
+        &r_powers[half],
+        num_cells - half,
+        left_valid,
+        s
+    );
 }
 
 /**
- * Given some cells, verify that their proofs are valid.
+ * Given some cells, find out which of their proofs are valid.
  *
- * @param[out]  ok                  True if the proofs are valid
+ * The whole batch is checked first, exactly like verify_cell_kzg_proof_batch(). Only if that fails
+ * is the batch bisected, reusing the decoded inputs and the random challenge scalars, to find the
+ * invalid cells.
+ *
+ * @param[out]  ok                  True if all of the proofs are valid, otherwise false
+ * @param[out]  valid_out           Whether each cell is valid, length `num_cells`
  * @param[in]   commitments_bytes   The commitments for the cells, length `num_cells`
  * @param[in]   cell_indices        The indices for the cells, length `num_cells`
  * @param[in]   cells               The cells to check, length `num_cells`
  * @param[in]   proofs_bytes        The proofs for the cells, length `num_cells`
  * @param[in]   num_cells           The number of cells provided
  * @param[in]   s                   The trusted setup
+ *
+ * @remark Unlike verify_cell_kzg_proof_batch(), a commitment, cell index, cell, or proof that
+ * cannot be decoded does not fail the call. The cells that depend on it are reported as invalid
+ * instead.
  */
-C_KZG_RET verify_cell_kzg_proof_batch(
+C_KZG_RET verify_cell_kzg_proof_batch_with_report(
     bool *ok,
+    bool *valid_out,
     const Bytes48 *commitments_bytes,
     const uint64_t *cell_indices,
     const Cell *cells,
@@ -828,18 +1682,21 @@ C_KZG_RET verify_cell_kzg_proof_batch(
     const KZGSettings *s
 ) {
     C_KZG_RET ret;
-    g1_t interpolation_poly_commit;
-    g1_t final_g1_sum;
-    g1_t proof_lincomb;
-    g1_t weighted_sum_of_proofs;
-    g2_t power_of_s = s->g2_values_monomial[FIELD_ELEMENTS_PER_CELL];
+    bool all_valid;
     size_t num_commitments;
+    size_t num_decoded = 0;
 
     /* Arrays */
     Bytes48 *unique_commitments = NULL;
     uint64_t *commitment_indices = NULL;
     fr_t *r_powers = NULL;
+    g1_t *commitments_g1 = NULL;
+    bool *is_commitment_valid = NULL;
     g1_t *proofs_g1 = NULL;
+    fr_t *cells_fr = NULL;
+    uint64_t *decoded_cell_indices = NULL;
+    bool *decoded_valid = NULL;
+    size_t *positions = NULL;
 
     *ok = false;
 
@@ -849,15 +1706,6 @@ C_KZG_RET verify_cell_kzg_proof_batch(
         return C_KZG_OK;
     }
 
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Sanity checks
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-
-    for (size_t i = 0; i < num_cells; i++) {
-        /* Make sure column index is valid */
-        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) return C_KZG_BADARGS;
-    }
-
     ////////////////////////////////////////////////////////////////////////////////////////////////
     // Deduplicate commitments
     ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -867,11 +1715,6 @@ C_KZG_RET verify_cell_kzg_proof_batch(
     ret = c_kzg_calloc((void **)&commitment_indices, num_cells, sizeof(uint64_t));
     if (ret != C_KZG_OK) goto out;
 
-    /*
-     * Convert the array of cell commitments to an array of unique commitments and an array of
-     * indices to those unique commitments. We do this before the array allocations section below
-     * because we need to know how many commitment weights there will be.
-     */
     num_commitments = num_cells;
     memcpy(unique_commitments, commitments_bytes, num_cells * sizeof(Bytes48));
     deduplicate_commitments(unique_commitments, commitment_indices, &num_commitments);
@@ -882,18 +1725,26 @@ C_KZG_RET verify_cell_kzg_proof_batch(
 
     ret = new_fr_array(&r_powers, num_cells);
     if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&commitments_g1, num_commitments);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_bool_array(&is_commitment_valid, num_commitments);
+    if (ret != C_KZG_OK) goto out;
     ret = new_g1_array(&proofs_g1, num_cells);
     if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&cells_fr, num_cells * FIELD_ELEMENTS_PER_CELL);
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&decoded_cell_indices, num_cells, sizeof(uint64_t));
+    if (ret != C_KZG_OK) goto out;
+    ret = new_bool_array(&decoded_valid, num_cells);
+    if (ret != C_KZG_OK) goto out;
+    ret = c_kzg_calloc((void **)&positions, num_cells, sizeof(size_t));
+    if (ret != C_KZG_OK) goto out;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Compute powers of r, and extract KZG proofs out of input bytes
+    // Compute powers of r over all of the inputs, valid or not
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    /*
-     * Derive random factors for the linear combination. The exponents start with 0. That is, they
-     * are r^0, r^1, r^2, r^3, and so on.
-     */
-    ret = compute_r_powers_for_verify_cell_kzg_proof_batch(
+    compute_r_powers_for_verify_cell_kzg_proof_batch(
         r_powers,
         unique_commitments,
         num_commitments,
@@ -903,65 +1754,74 @@ C_KZG_RET verify_cell_kzg_proof_batch(
         proofs_bytes,
         num_cells
     );
-    if (ret != C_KZG_OK) goto out;
-
-    /* There should be a proof for each cell */
-    for (size_t i = 0; i < num_cells; i++) {
-        ret = bytes_to_kzg_proof(&proofs_g1[i], &proofs_bytes[i]);
-        if (ret != C_KZG_OK) goto out;
-    }
-
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Compute random linear combination of the proofs
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-
-    ret = g1_lincomb_fast(&proof_lincomb, proofs_g1, r_powers, num_cells);
-    if (ret != C_KZG_OK) goto out;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Compute sum of the commitments
+    // Decode everything, packing the cells that decode at the front of the arrays
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    ret = compute_weighted_sum_of_commitments(
-        &final_g1_sum, unique_commitments, commitment_indices, r_powers, num_commitments, num_cells
-    );
-    if (ret != C_KZG_OK) goto out;
-
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Commit to aggregated interpolation polynomial
-    ////////////////////////////////////////////////////////////////////////////////////////////////
+    for (size_t i = 0; i < num_commitments; i++) {
+        ret = bytes_to_kzg_commitment(&commitments_g1[i], &unique_commitments[i]);
+        is_commitment_valid[i] = ret == C_KZG_OK;
+        /* An invalid commitment is never given a weight, but keep the point well-defined */
+        if (!is_commitment_valid[i]) commitments_g1[i] = G1_IDENTITY;
+    }
 
-    /* Aggregate cells from same columns, sum interpolation polynomials, and commit */
-    ret = compute_commitment_to_aggregated_interpolation_poly(
-        &interpolation_poly_commit, r_powers, cell_indices, cells, num_cells, s
-    );
-    if (ret != C_KZG_OK) goto out;
+    for (size_t i = 0; i < num_cells; i++) {
+        valid_out[i] = false;
+        if (cell_indices[i] >= CELLS_PER_EXT_BLOB) continue;
+        if (!is_commitment_valid[commitment_indices[i]]) continue;
+        ret = bytes_to_kzg_proof(&proofs_g1[num_decoded], &proofs_bytes[i]);
+        if (ret != C_KZG_OK) continue;
+        ret = cell_to_field_elements(&cells_fr[num_decoded * FIELD_ELEMENTS_PER_CELL], &cells[i]);
+        if (ret != C_KZG_OK) continue;
+
+        /* The packed arrays never get ahead of the input arrays */
+        commitment_indices[num_decoded] = commitment_indices[i];
+        decoded_cell_indices[num_decoded] = cell_indices[i];
+        r_powers[num_decoded] = r_powers[i];
+        positions[num_decoded] = i;
+        num_decoded++;
+    }
+    ret = C_KZG_OK;
 
-    /* Subtract commitment from sum by adding the negated commitment */
-    blst_p1_cneg(&interpolation_poly_commit, true);
-    blst_p1_add(&final_g1_sum, &final_g1_sum, &interpolation_poly_commit);
+    /* Exit early if nothing could be decoded */
+    if (num_decoded == 0) goto out;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Compute sum of the proofs scaled by the coset factors
+    // Check the whole batch, and bisect if it fails
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
-    ret = computed_weighted_sum_of_proofs(
-        &weighted_sum_of_proofs, proofs_g1, r_powers, cell_indices, num_cells, s
+    ret = bisect_cell_kzg_proof_batch(
+        decoded_valid,
+        &all_valid,
+        commitments_g1,
+        num_commitments,
+        commitment_indices,
+        decoded_cell_indices,
+        cells_fr,
+        proofs_g1,
+        r_powers,
+        num_decoded,
+        false,
+        s
     );
     if (ret != C_KZG_OK) goto out;
 
-    blst_p1_add(&final_g1_sum, &final_g1_sum, &weighted_sum_of_proofs);
-
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-    // Do the final pairing check
-    ////////////////////////////////////////////////////////////////////////////////////////////////
-
-    *ok = pairings_verify(&final_g1_sum, blst_p2_generator(), &proof_lincomb, &power_of_s);
+    for (size_t i = 0; i < num_decoded; i++) {
+        valid_out[positions[i]] = decoded_valid[i];
+    }
+    *ok = all_valid && num_decoded == num_cells;
 
 out:
     c_kzg_free(unique_commitments);
     c_kzg_free(commitment_indices);
     c_kzg_free(r_powers);
+    c_kzg_free(commitments_g1);
+    c_kzg_free(is_commitment_valid);
     c_kzg_free(proofs_g1);
+    c_kzg_free(cells_fr);
+    c_kzg_free(decoded_cell_indices);
+    c_kzg_free(decoded_valid);
+    c_kzg_free(positions);
     return ret;
 }
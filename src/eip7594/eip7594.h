@@ -35,6 +35,24 @@ C_KZG_RET compute_cells_and_kzg_proofs(
     Cell *cells, KZGProof *proofs, const Blob *blob, const KZGSettings *s
 );
 
+C_KZG_RET compute_cells_and_kzg_proofs_for_indices(
+    Cell *cells,
+    KZGProof *proofs,
+    const uint64_t *cell_indices,
+    uint64_t num_cells,
+    const Blob *blob,
+    const KZGSettings *s
+);
+
+C_KZG_RET compute_blob_sidecar(
+    KZGCommitment *commitment_out,
+    KZGProof *proof_out,
+    Cell *cells,
+    KZGProof *cell_proofs,
+    const Blob *blob,
+    const KZGSettings *s
+);
+
 C_KZG_RET recover_cells_and_kzg_proofs(
     Cell *recovered_cells,
     KZGProof *recovered_proofs,
@@ -44,6 +62,17 @@ C_KZG_RET recover_cells_and_kzg_proofs(
     const KZGSettings *s
 );
 
+C_KZG_RET recover_cells_and_kzg_proofs_for_indices(
+    Cell *recovered_cells,
+    KZGProof *recovered_proofs,
+    const uint64_t *wanted_cell_indices,
+    uint64_t num_wanted_cells,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    uint64_t num_cells,
+    const KZGSettings *s
+);
+
 C_KZG_RET verify_cell_kzg_proof_batch(
     bool *ok,
     const Bytes48 *commitments_bytes,
@@ -54,6 +83,17 @@ C_KZG_RET verify_cell_kzg_proof_batch(
     const KZGSettings *s
 );
 
+C_KZG_RET verify_cell_kzg_proof_batch_with_report(
+    bool *ok,
+    bool *valid_out,
+    const Bytes48 *commitments_bytes,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells,
+    const KZGSettings *s
+);
+
 #ifdef __cplusplus
 }
 #endif
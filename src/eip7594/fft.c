@@ -15,12 +15,9 @@
  */
 
 #include "eip7594/fft.h"
-#include "common/alloc.h"
+#include "common/stats.h"
 #include "common/utils.h"
 #include "eip7594/cell.h"
-#include "eip7594/poly.h"
-
-#include <string.h> /* For memcpy */
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Constants
@@ -66,20 +63,32 @@ static const fr_t INV_RECOVERY_SHIFT_FACTOR = {
  * @param[in]   roots           Roots of unity, length `n * roots_stride`
  * @param[in]   roots_stride    The stride interval among the roots of unity
  * @param[in]   n               Length of the FFT, must be a power of two
+ * @param[in]   shifts          Factors to scale the input by, length `n * stride`, or NULL
+ *
+ * @remark The input is scaled as it is read, so a coset FFT costs the same as a plain one.
  */
 static void fr_fft_fast(
-    fr_t *out, const fr_t *in, size_t stride, const fr_t *roots, size_t roots_stride, size_t n
+    fr_t *out,
+    const fr_t *in,
+    size_t stride,
+    const fr_t *roots,
+    size_t roots_stride,
+    size_t n,
+    const fr_t *shifts
 ) {
     size_t half = n / 2;
     if (half > 0) {
         fr_t y_times_root;
-        fr_fft_fast(out, in, stride * 2, roots, roots_stride * 2, half);
-        fr_fft_fast(out + half, in + stride, stride * 2, roots, roots_stride * 2, half);
+        const fr_t *odd_shifts = shifts != NULL ? shifts + stride : NULL;
+        fr_fft_fast(out, in, stride * 2, roots, roots_stride * 2, half, shifts);
+        fr_fft_fast(out + half, in + stride, stride * 2, roots, roots_stride * 2, half, odd_shifts);
         for (size_t i = 0; i < half; i++) {
             blst_fr_mul(&y_times_root, &out[i + half], &roots[i * roots_stride]);
             blst_fr_sub(&out[i + half], &out[i], &y_times_root);
             blst_fr_add(&out[i], &out[i], &y_times_root);
         }
+    } else if (shifts != NULL) {
+        blst_fr_mul(out, in, shifts);
     } else {
         *out = *in;
     }
@@ -106,9 +115,11 @@ C_KZG_RET fr_fft(fr_t *out, const fr_t *in, size_t n, const KZGSettings *s) {
         return C_KZG_BADARGS;
     }
 
+    STATS_TIMER_START(timer);
     size_t roots_stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
-    fr_fft_fast(out, in, 1, s->roots_of_unity, roots_stride, n);
+    fr_fft_fast(out, in, 1, s->roots_of_unity, roots_stride, n, NULL);
 
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
     return C_KZG_OK;
 }
 
@@ -133,8 +144,9 @@ C_KZG_RET fr_ifft(fr_t *out, const fr_t *in, size_t n, const KZGSettings *s) {
         return C_KZG_BADARGS;
     }
 
+    STATS_TIMER_START(timer);
     size_t stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
-    fr_fft_fast(out, in, 1, s->reverse_roots_of_unity, stride, n);
+    fr_fft_fast(out, in, 1, s->reverse_roots_of_unity, stride, n, NULL);
 
     fr_t inv_n;
     fr_from_uint64(&inv_n, n);
@@ -142,6 +154,7 @@ C_KZG_RET fr_ifft(fr_t *out, const fr_t *in, size_t n, const KZGSettings *s) {
     for (size_t i = 0; i < n; i++) {
         blst_fr_mul(&out[i], &out[i], &inv_n);
     }
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
     return C_KZG_OK;
 }
 
@@ -205,9 +218,11 @@ C_KZG_RET g1_fft(g1_t *out, const g1_t *in, size_t n, const KZGSettings *s) {
         return C_KZG_BADARGS;
     }
 
+    STATS_TIMER_START(timer);
     size_t roots_stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
     g1_fft_fast(out, in, 1, s->roots_of_unity, roots_stride, n);
 
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
     return C_KZG_OK;
 }
 
@@ -232,6 +247,7 @@ C_KZG_RET g1_ifft(g1_t *out, const g1_t *in, size_t n, const KZGSettings *s) {
         return C_KZG_BADARGS;
     }
 
+    STATS_TIMER_START(timer);
     size_t stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
     g1_fft_fast(out, in, 1, s->reverse_roots_of_unity, stride, n);
 
@@ -242,6 +258,7 @@ C_KZG_RET g1_ifft(g1_t *out, const g1_t *in, size_t n, const KZGSettings *s) {
         g1_mul(&out[i], &out[i], &inv_n);
     }
 
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
     return C_KZG_OK;
 }
 
@@ -249,6 +266,34 @@ C_KZG_RET g1_ifft(g1_t *out, const g1_t *in, size_t n, const KZGSettings *s) {
 // FFT Functions for Cosets
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Compute the powers of the coset shift factor and of its inverse.
+ *
+ * The inverse powers are divided by `n`, so that a coset IFFT of length `n` can undo the shift and
+ * scale its output with a single multiplication per element.
+ *
+ * @param[out]  shift_powers_out        The powers of RECOVERY_SHIFT_FACTOR, length `n`
+ * @param[out]  inv_shift_powers_out    The powers of INV_RECOVERY_SHIFT_FACTOR over `n`, length `n`
+ * @param[in]   n                       The number of powers
+ */
+void compute_coset_shift_powers(fr_t *shift_powers_out, fr_t *inv_shift_powers_out, size_t n) {
+    fr_t inv_n;
+
+    if (n == 0) return;
+
+    fr_from_uint64(&inv_n, n);
+    blst_fr_eucl_inverse(&inv_n, &inv_n);
+
+    shift_powers_out[0] = FR_ONE;
+    inv_shift_powers_out[0] = inv_n;
+    for (size_t i = 1; i < n; i++) {
+        blst_fr_mul(&shift_powers_out[i], &shift_powers_out[i - 1], &RECOVERY_SHIFT_FACTOR);
+        blst_fr_mul(
+            &inv_shift_powers_out[i], &inv_shift_powers_out[i - 1], &INV_RECOVERY_SHIFT_FACTOR
+        );
+    }
+}
+
 /**
  * Do an FFT over a coset of the roots of unity.
  *
@@ -258,27 +303,24 @@ C_KZG_RET g1_ifft(g1_t *out, const g1_t *in, size_t n, const KZGSettings *s) {
  * @param[in]   s   The trusted setup
  *
  * @remark Will do nothing if given a zero length array.
- * @remark The coset shift factor is RECOVERY_SHIFT_FACTOR.
+ * @remark The coset shift factor is RECOVERY_SHIFT_FACTOR. Its powers are precomputed in the
+ * trusted setup and applied as the input is read.
  */
 C_KZG_RET coset_fft(fr_t *out, const fr_t *in, size_t n, const KZGSettings *s) {
     /* Handle zero length input */
     if (n == 0) return C_KZG_OK;
 
-    /* Create some room to shift the polynomial */
-    fr_t *in_shifted = NULL;
-    C_KZG_RET ret = new_fr_array(&in_shifted, n);
-    if (ret != C_KZG_OK) goto out;
-
-    /* Shift the poly */
-    memcpy(in_shifted, in, n * sizeof(fr_t));
-    shift_poly(in_shifted, n, &RECOVERY_SHIFT_FACTOR);
+    /* Ensure the length is valid */
+    if (n > FIELD_ELEMENTS_PER_EXT_BLOB || !is_power_of_two(n)) {
+        return C_KZG_BADARGS;
+    }
 
-    ret = fr_fft(out, in_shifted, n, s);
-    if (ret != C_KZG_OK) goto out;
+    STATS_TIMER_START(timer);
+    size_t roots_stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
+    fr_fft_fast(out, in, 1, s->roots_of_unity, roots_stride, n, s->coset_shift_powers);
 
-out:
-    c_kzg_free(in_shifted);
-    return ret;
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
+    return C_KZG_OK;
 }
 
 /**
@@ -290,18 +332,36 @@ out:
  * @param[in]   s   The trusted setup
  *
  * @remark Will do nothing if given a zero length array.
- * @remark The coset shift factor is RECOVERY_SHIFT_FACTOR. In this function we use its inverse to
- * implement the IFFT.
+ * @remark The coset shift factor is RECOVERY_SHIFT_FACTOR. In this function we use the precomputed
+ * powers of its inverse, which already include the scaling by `1 / FIELD_ELEMENTS_PER_EXT_BLOB`.
+ * Shorter lengths need one more multiplication to correct that scaling to `1 / n`.
  */
 C_KZG_RET coset_ifft(fr_t *out, const fr_t *in, size_t n, const KZGSettings *s) {
     /* Handle zero length input */
     if (n == 0) return C_KZG_OK;
 
-    C_KZG_RET ret = fr_ifft(out, in, n, s);
-    if (ret != C_KZG_OK) goto out;
+    /* Ensure the length is valid */
+    if (n > FIELD_ELEMENTS_PER_EXT_BLOB || !is_power_of_two(n)) {
+        return C_KZG_BADARGS;
+    }
 
-    shift_poly(out, n, &INV_RECOVERY_SHIFT_FACTOR);
+    STATS_TIMER_START(timer);
+    size_t stride = FIELD_ELEMENTS_PER_EXT_BLOB / n;
+    fr_fft_fast(out, in, 1, s->reverse_roots_of_unity, stride, n, NULL);
+
+    for (size_t i = 0; i < n; i++) {
+        blst_fr_mul(&out[i], &out[i], &s->inv_coset_shift_powers[i]);
+    }
 
-out:
-    return ret;
+    /* The precomputed powers scale by 1 / FIELD_ELEMENTS_PER_EXT_BLOB, which is 1 / (n * stride) */
+    if (stride != 1) {
+        fr_t stride_fr;
+        fr_from_uint64(&stride_fr, stride);
+        for (size_t i = 0; i < n; i++) {
+            blst_fr_mul(&out[i], &out[i], &stride_fr);
+        }
+    }
+
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FFT);
+    return C_KZG_OK;
 }
@@ -17,35 +17,203 @@
 #include "eip7594/fk20.h"
 #include "common/alloc.h"
 #include "common/lincomb.h"
+#include "common/stats.h"
+#include "common/trace.h"
 #include "eip7594/cell.h"
 #include "eip7594/fft.h"
 
 #include <stdlib.h> /* For NULL */
+#include <string.h> /* For memcpy */
+
+/** The inputs and outputs of the per-column MSMs in FK20. */
+typedef struct {
+    /** The toeplitz coefficients, organized by column. */
+    fr_t *coeffs;
+    /** The result of each MSM. */
+    g1_t *h_ext_fft;
+    /** The trusted setup. */
+    const KZGSettings *s;
+} FK20Columns;
+
+/**
+ * Reorder and extend polynomial coefficients for the toeplitz method, for every offset at once.
+ *
+ * For each offset `i`, the circulant input is `CELLS_PER_EXT_BLOB` long. Its first element is
+ * `first_out[i]`, its elements 1 through `CELLS_PER_BLOB + 1` are zero, and its upper half is row
+ * `i` of the transposed `upper_out`. The results are stored by offset so that every row of
+ * `upper_out` can be transformed together.
+ *
+ * @param[out]  first_out   The first elements, length `FIELD_ELEMENTS_PER_CELL`
+ * @param[out]  upper_out   The upper halves, `CELLS_PER_BLOB` rows of `FIELD_ELEMENTS_PER_CELL`
+ * @param[in]   in          The input polynomial, length `FIELD_ELEMENTS_PER_BLOB`
+ */
+static void toeplitz_coeffs_batch(fr_t *first_out, fr_t *upper_out, const fr_t *in) {
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+        /* Set the first element */
+        first_out[i] = in[FIELD_ELEMENTS_PER_BLOB - 1 - i];
+
+        /* The first two elements of the upper half are zero */
+        upper_out[i] = FR_ZERO;
+        upper_out[FIELD_ELEMENTS_PER_CELL + i] = FR_ZERO;
+
+        /* Copy elements with a stride of one cell, starting at the end of the second cell */
+        for (size_t j = 2; j < CELLS_PER_BLOB; j++) {
+            upper_out[j * FIELD_ELEMENTS_PER_CELL + i] = in[j * FIELD_ELEMENTS_PER_CELL - i - 1];
+        }
+    }
+}
+
+/**
+ * Fast Fourier Transform over rows of field elements.
+ *
+ * Each element of the transform is a row of `FIELD_ELEMENTS_PER_CELL` field elements, and each
+ * butterfly is applied to every column of its rows with the same root of unity. This does one
+ * transform per column, with each root loaded once.
+ *
+ * @param[out]  out             The results, `n` rows
+ * @param[in]   in              The input data, `n * stride` rows
+ * @param[in]   stride          The input data stride, in rows
+ * @param[in]   roots           Roots of unity, length `n * roots_stride`
+ * @param[in]   roots_stride    The stride interval among the roots of unity
+ * @param[in]   n               Length of the FFT, must be a power of two
+ */
+static void fr_fft_rows(
+    fr_t *out, const fr_t *in, size_t stride, const fr_t *roots, size_t roots_stride, size_t n
+) {
+    size_t half = n / 2;
+    if (half > 0) {
+        fr_t y_times_root;
+        const fr_t *odd_in = in + stride * FIELD_ELEMENTS_PER_CELL;
+        fr_t *upper = out + half * FIELD_ELEMENTS_PER_CELL;
+        fr_fft_rows(out, in, stride * 2, roots, roots_stride * 2, half);
+        fr_fft_rows(upper, odd_in, stride * 2, roots, roots_stride * 2, half);
+        for (size_t i = 0; i < half; i++) {
+            const fr_t *root = &roots[i * roots_stride];
+            fr_t *lo = &out[i * FIELD_ELEMENTS_PER_CELL];
+            fr_t *hi = &upper[i * FIELD_ELEMENTS_PER_CELL];
+            for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
+                blst_fr_mul(&y_times_root, &hi[j], root);
+                blst_fr_sub(&hi[j], &lo[j], &y_times_root);
+                blst_fr_add(&lo[j], &lo[j], &y_times_root);
+            }
+        }
+    } else {
+        memcpy(out, in, FIELD_ELEMENTS_PER_CELL * sizeof(fr_t));
+    }
+}
 
 /**
- * Reorder and extend polynomial coefficients for the toeplitz method, strided version.
+ * Compute the FFTs of the toeplitz coefficients for every offset, organized by column.
+ *
+ * Each circulant input `x` has a single non-zero element `x_0` in its lower half, so with `u` its
+ * upper half and `w` a primitive `CELLS_PER_EXT_BLOB`-th root of unity:
+ *
+ *   X[2m]     = x_0 + FFT(u)[m]
+ *   X[2m + 1] = x_0 - FFT(u * w^j)[m]
+ *
+ * Both are transforms of half the size, done for all offsets together, and the results are written
+ * straight into the layout that the MSMs consume.
  *
- * @param[out]  out     The reordered polynomial, length `CELLS_PER_EXT_BLOB`
- * @param[in]   in      The input polynomial, length `FIELD_ELEMENTS_PER_BLOB`
- * @param[in]   offset  The offset
+ * @param[out]  coeffs_out  `CELLS_PER_EXT_BLOB` columns of `FIELD_ELEMENTS_PER_CELL` coefficients
+ * @param[in]   p           The polynomial, an array of FIELD_ELEMENTS_PER_BLOB coefficients
+ * @param[in]   s           The trusted setup
  */
-static void toeplitz_coeffs_stride(fr_t *out, const fr_t *in, size_t offset) {
-    /* Calculate starting indices */
-    size_t out_start = CELLS_PER_BLOB + 2;
-    size_t in_start = CELLS_PER_EXT_BLOB - offset - 1;
+static C_KZG_RET compute_toeplitz_coeffs_fft(
+    fr_t *coeffs_out, const fr_t *p, const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t first[FIELD_ELEMENTS_PER_CELL];
+    fr_t *upper = NULL;
+    fr_t *upper_fft = NULL;
+    size_t roots_stride = FIELD_ELEMENTS_PER_EXT_BLOB / CELLS_PER_BLOB;
+    size_t shift_stride = FIELD_ELEMENTS_PER_EXT_BLOB / CELLS_PER_EXT_BLOB;
+
+    /* Do allocations */
+    ret = new_fr_array(&upper, CELLS_PER_BLOB * FIELD_ELEMENTS_PER_CELL);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&upper_fft, CELLS_PER_BLOB * FIELD_ELEMENTS_PER_CELL);
+    if (ret != C_KZG_OK) goto out;
 
-    /* Set the first element */
-    out[0] = in[FIELD_ELEMENTS_PER_BLOB - 1 - offset];
+    toeplitz_coeffs_batch(first, upper, p);
 
-    /* Initialize these elements to zero */
-    for (size_t i = 1; i < out_start; i++) {
-        out[i] = FR_ZERO;
+    /* The even outputs */
+    fr_fft_rows(upper_fft, upper, 1, s->roots_of_unity, roots_stride, CELLS_PER_BLOB);
+    for (size_t m = 0; m < CELLS_PER_BLOB; m++) {
+        fr_t *column = &coeffs_out[2 * m * FIELD_ELEMENTS_PER_CELL];
+        for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+            blst_fr_add(&column[i], &first[i], &upper_fft[m * FIELD_ELEMENTS_PER_CELL + i]);
+        }
+    }
+
+    /* The odd outputs, the first two rows are zero and need no shift */
+    for (size_t j = 2; j < CELLS_PER_BLOB; j++) {
+        const fr_t *shift = &s->roots_of_unity[j * shift_stride];
+        for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+            fr_t *x = &upper[j * FIELD_ELEMENTS_PER_CELL + i];
+            blst_fr_mul(x, x, shift);
+        }
+    }
+    fr_fft_rows(upper_fft, upper, 1, s->roots_of_unity, roots_stride, CELLS_PER_BLOB);
+    for (size_t m = 0; m < CELLS_PER_BLOB; m++) {
+        fr_t *column = &coeffs_out[(2 * m + 1) * FIELD_ELEMENTS_PER_CELL];
+        for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
+            blst_fr_sub(&column[i], &first[i], &upper_fft[m * FIELD_ELEMENTS_PER_CELL + i]);
+        }
     }
 
-    /* Copy elements with a fixed stride */
-    for (size_t i = 0; i < CELLS_PER_EXT_BLOB - out_start; i++) {
-        out[out_start + i] = in[in_start + i * FIELD_ELEMENTS_PER_CELL];
+out:
+    c_kzg_free(upper);
+    c_kzg_free(upper_fft);
+    return ret;
+}
+
+/**
+ * Compute one element of h_ext_fft, the MSM of a column of toeplitz coefficients.
+ *
+ * @param[in,out]   ctx The FK20Columns
+ * @param[in]       i   The index of the column
+ */
+static C_KZG_RET compute_column_msm(void *ctx, size_t i) {
+    C_KZG_RET ret = C_KZG_OK;
+    const FK20Columns *columns = (const FK20Columns *)ctx;
+    const KZGSettings *s = columns->s;
+    const fr_t *column = &columns->coeffs[i * FIELD_ELEMENTS_PER_CELL];
+    blst_scalar scalars[FIELD_ELEMENTS_PER_CELL];
+    limb_t *scratch = NULL;
+
+    if (s->wbits != 0) {
+        /* Every column has its own scratch, so that columns can be done at the same time */
+        ret = c_kzg_malloc((void **)&scratch, s->scratch_size);
+        if (ret != C_KZG_OK) goto out;
+
+        /* Transform the field elements to 255-bit scalars */
+        for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
+            blst_scalar_from_fr(&scalars[j], &column[j]);
+        }
+        const byte *scalars_arg[2] = {(byte *)scalars, NULL};
+
+        /* A fixed-base MSM with precomputation */
+        STATS_TIMER_START(msm_timer);
+        blst_p1s_mult_wbits(
+            &columns->h_ext_fft[i],
+            s->tables[i],
+            s->wbits,
+            FIELD_ELEMENTS_PER_CELL,
+            scalars_arg,
+            BITS_PER_FIELD_ELEMENT,
+            scratch
+        );
+        STATS_TIMER_STOP(msm_timer, C_KZG_PHASE_MSM);
+    } else {
+        /* A pretty fast MSM without precomputation */
+        ret = g1_lincomb_affine(
+            &columns->h_ext_fft[i], s->x_ext_fft_columns[i], column, FIELD_ELEMENTS_PER_CELL
+        );
     }
+
+out:
+    c_kzg_free(scratch);
+    return ret;
 }
 
 /**
@@ -62,14 +230,10 @@ C_KZG_RET compute_fk20_cell_proofs(g1_t *out, const fr_t *p, const KZGSettings *
     C_KZG_RET ret;
     size_t circulant_domain_size;
 
-    blst_scalar *scalars = NULL;
-    fr_t **coeffs = NULL;
-    fr_t *toeplitz_coeffs = NULL;
-    fr_t *toeplitz_coeffs_fft = NULL;
+    FK20Columns columns = {NULL, NULL, s};
     g1_t *h = NULL;
-    g1_t *h_ext_fft = NULL;
-    limb_t *scratch = NULL;
-    bool precompute = s->wbits != 0;
+    STATS_TIMER_START(timer);
+    TRACE_PROBE(fk20__start);
 
     /*
      * Note: this constant 2 is not related to `LOG_EXPANSION_FACTOR`.
@@ -79,75 +243,29 @@ C_KZG_RET compute_fk20_cell_proofs(g1_t *out, const fr_t *p, const KZGSettings *
     circulant_domain_size = CELLS_PER_BLOB * 2;
 
     /* Do allocations */
-    ret = new_fr_array(&toeplitz_coeffs, circulant_domain_size);
+    ret = new_fr_array(&columns.coeffs, circulant_domain_size * FIELD_ELEMENTS_PER_CELL);
     if (ret != C_KZG_OK) goto out;
-    ret = new_fr_array(&toeplitz_coeffs_fft, circulant_domain_size);
-    if (ret != C_KZG_OK) goto out;
-    ret = new_g1_array(&h_ext_fft, circulant_domain_size);
+    ret = new_g1_array(&columns.h_ext_fft, circulant_domain_size);
     if (ret != C_KZG_OK) goto out;
     ret = new_g1_array(&h, circulant_domain_size);
     if (ret != C_KZG_OK) goto out;
 
-    if (precompute) {
-        /* Allocations for fixed-base MSM */
-        ret = c_kzg_malloc((void **)&scratch, s->scratch_size);
-        if (ret != C_KZG_OK) goto out;
-        ret = c_kzg_calloc((void **)&scalars, FIELD_ELEMENTS_PER_CELL, sizeof(blst_scalar));
-        if (ret != C_KZG_OK) goto out;
-    }
-
-    /* Allocate 2d array for coefficients by column */
-    ret = c_kzg_calloc((void **)&coeffs, circulant_domain_size, sizeof(void *));
-    if (ret != C_KZG_OK) goto out;
-    for (size_t i = 0; i < circulant_domain_size; i++) {
-        ret = new_fr_array(&coeffs[i], CELLS_PER_BLOB);
-        if (ret != C_KZG_OK) goto out;
-    }
-
     /* Initialize values to zero */
     for (size_t i = 0; i < circulant_domain_size; i++) {
-        h_ext_fft[i] = G1_IDENTITY;
+        columns.h_ext_fft[i] = G1_IDENTITY;
     }
 
-    /* Compute toeplitz coefficients and organize by column */
-    for (size_t i = 0; i < FIELD_ELEMENTS_PER_CELL; i++) {
-        toeplitz_coeffs_stride(toeplitz_coeffs, p, i);
-        ret = fr_fft(toeplitz_coeffs_fft, toeplitz_coeffs, circulant_domain_size, s);
-        if (ret != C_KZG_OK) goto out;
-        for (size_t j = 0; j < circulant_domain_size; j++) {
-            coeffs[j][i] = toeplitz_coeffs_fft[j];
-        }
-    }
+    /* Compute toeplitz coefficients, organized by column */
+    ret = compute_toeplitz_coeffs_fft(columns.coeffs, p, s);
+    if (ret != C_KZG_OK) goto out;
+    TRACE_PROBE(fk20__toeplitz_done);
 
-    /* Compute h_ext_fft via MSM */
-    for (size_t i = 0; i < circulant_domain_size; i++) {
-        if (precompute) {
-            /* Transform the field elements to 255-bit scalars */
-            for (size_t j = 0; j < FIELD_ELEMENTS_PER_CELL; j++) {
-                blst_scalar_from_fr(&scalars[j], &coeffs[i][j]);
-            }
-            const byte *scalars_arg[2] = {(byte *)scalars, NULL};
-
-            /* A fixed-base MSM with precomputation */
-            blst_p1s_mult_wbits(
-                &h_ext_fft[i],
-                s->tables[i],
-                s->wbits,
-                FIELD_ELEMENTS_PER_CELL,
-                scalars_arg,
-                BITS_PER_FIELD_ELEMENT,
-                scratch
-            );
-        } else {
-            /* A pretty fast MSM without precomputation */
-            ret = g1_lincomb_fast(
-                &h_ext_fft[i], s->x_ext_fft_columns[i], coeffs[i], FIELD_ELEMENTS_PER_CELL
-            );
-            if (ret != C_KZG_OK) goto out;
-        }
-    }
+    /* Compute h_ext_fft via MSM, the columns are independent */
+    ret = run_parallel_for(&s->executor, compute_column_msm, &columns, circulant_domain_size);
+    if (ret != C_KZG_OK) goto out;
+    TRACE_PROBE(fk20__msm_done);
 
-    ret = g1_ifft(h, h_ext_fft, circulant_domain_size, s);
+    ret = g1_ifft(h, columns.h_ext_fft, circulant_domain_size, s);
     if (ret != C_KZG_OK) goto out;
 
     /* Zero the second half of h */
@@ -159,17 +277,10 @@ C_KZG_RET compute_fk20_cell_proofs(g1_t *out, const fr_t *p, const KZGSettings *
     if (ret != C_KZG_OK) goto out;
 
 out:
-    c_kzg_free(scalars);
-    if (coeffs != NULL) {
-        for (size_t i = 0; i < circulant_domain_size; i++) {
-            c_kzg_free(coeffs[i]);
-        }
-        c_kzg_free(coeffs);
-    }
-    c_kzg_free(toeplitz_coeffs);
-    c_kzg_free(toeplitz_coeffs_fft);
+    c_kzg_free(columns.coeffs);
+    c_kzg_free(columns.h_ext_fft);
     c_kzg_free(h);
-    c_kzg_free(h_ext_fft);
-    c_kzg_free(scratch);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_FK20);
+    TRACE_PROBE1(fk20__done, (int)ret);
     return ret;
 }
@@ -22,6 +22,7 @@
 #include "eip7594/fft.h"
 #include "setup/settings.h"
 
+#include <assert.h> /* For assert */
 #include <stdlib.h> /* For NULL */
 #include <string.h> /* For memcpy */
 
@@ -78,3 +79,40 @@ out:
     c_kzg_free(lagrange_brp);
     return ret;
 }
+
+/**
+ * Divide a polynomial by `x^n - a`, the vanishing polynomial of a coset of size `n`.
+ *
+ * Computes `q` and `r` such that `p(x) = q(x) * (x^n - a) + r(x)`, with synthetic division.
+ *
+ * @param[out]  quotient_out    The quotient, an array of `len - n` fields
+ * @param[out]  remainder_out   The remainder, an array of `n` fields
+ * @param[in]   p               The polynomial to divide, an array of `len` fields
+ * @param[in]   len             The length of `p`, at least `2 * n`
+ * @param[in]   n               The size of the coset
+ * @param[in]   a               The constant term of the divisor, negated
+ */
+void poly_divide_by_coset_vanishing(
+    fr_t *quotient_out, fr_t *remainder_out, const fr_t *p, size_t len, size_t n, const fr_t *a
+) {
+    fr_t tmp;
+    size_t quotient_len = len - n;
+
+    assert(len >= 2 * n);
+
+    /* Working down from the top, each coefficient of p feeds the quotient n places below it */
+    for (size_t i = quotient_len; i > 0; i--) {
+        size_t k = i - 1;
+        quotient_out[k] = p[k + n];
+        if (k + n < quotient_len) {
+            blst_fr_mul(&tmp, a, &quotient_out[k + n]);
+            blst_fr_add(&quotient_out[k], &quotient_out[k], &tmp);
+        }
+    }
+
+    /* Whatever is left over at the bottom is the remainder */
+    for (size_t k = 0; k < n; k++) {
+        blst_fr_mul(&tmp, a, &quotient_out[k]);
+        blst_fr_add(&remainder_out[k], &p[k], &tmp);
+    }
+}
@@ -34,6 +34,10 @@ C_KZG_RET poly_lagrange_to_monomial(
     fr_t *monomial_out, const fr_t *lagrange, size_t len, const KZGSettings *s
 );
 
+void poly_divide_by_coset_vanishing(
+    fr_t *quotient_out, fr_t *remainder_out, const fr_t *p, size_t len, size_t n, const fr_t *a
+);
+
 #ifdef __cplusplus
 }
 #endif
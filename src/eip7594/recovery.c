@@ -17,9 +17,12 @@
 #include "eip7594/recovery.h"
 #include "common/alloc.h"
 #include "common/fr.h"
+#include "common/stats.h"
+#include "common/trace.h"
 #include "common/utils.h"
 #include "eip7594/cell.h"
 #include "eip7594/fft.h"
+#include "eip7594/poly.h"
 
 #include <assert.h> /* For assert */
 #include <stdlib.h> /* For NULL */
@@ -183,12 +186,99 @@ static bool is_in_array(const uint64_t *arr, size_t arr_size, uint64_t value) {
     return false;
 }
 
+/**
+ * Helper function: Recover every cell when one half of the extended data is available in full.
+ *
+ * In bit-reversed order, the first half of the extended data is the blob's polynomial evaluated
+ * over the FIELD_ELEMENTS_PER_BLOB roots of unity and the second half is the same polynomial
+ * evaluated over the coset `w * H`, where `w` is a primitive FIELD_ELEMENTS_PER_EXT_BLOB-th root of
+ * unity. Either half determines the polynomial with a half-size inverse FFT, and a half-size FFT
+ * then gives the other half. No vanishing polynomial is needed.
+ *
+ * @param[out]  reconstructed_data_out  Array of size FIELD_ELEMENTS_PER_EXT_BLOB to recover cells
+ * @param[out]  reconstructed_poly_out  Array of size FIELD_ELEMENTS_PER_EXT_BLOB for the recovered
+ *                                      polynomial in monomial form, or NULL
+ * @param[in]   cells                   An array of size FIELD_ELEMENTS_PER_EXT_BLOB with the cells
+ * @param[in]   from_second_half        Recover from the second half rather than the first
+ * @param[in]   s                       The trusted setup
+ *
+ * @remark `reconstructed_data_out` and `cells` can point to the same memory.
+ * @remark Available cells in the other half are kept as they are.
+ */
+static C_KZG_RET recover_cells_from_half(
+    fr_t *reconstructed_data_out,
+    fr_t *reconstructed_poly_out,
+    fr_t *cells,
+    bool from_second_half,
+    const KZGSettings *s
+) {
+    C_KZG_RET ret;
+    fr_t *evals = NULL;
+    fr_t *poly_coeff = NULL;
+    size_t from = from_second_half ? FIELD_ELEMENTS_PER_BLOB : 0;
+    size_t to = from_second_half ? 0 : FIELD_ELEMENTS_PER_BLOB;
+
+    /* Allocate space for arrays */
+    ret = new_fr_array(&evals, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&poly_coeff, FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Undo the bit-reversal of the available half and interpolate it */
+    memcpy(evals, &cells[from], FIELD_ELEMENTS_PER_BLOB * sizeof(fr_t));
+    ret = bit_reversal_permutation(evals, sizeof(fr_t), FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    ret = fr_ifft(poly_coeff, evals, FIELD_ELEMENTS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+
+    /* The second half was evaluated over the coset, so unshift the polynomial */
+    if (from_second_half) {
+        shift_poly(poly_coeff, FIELD_ELEMENTS_PER_BLOB, &s->reverse_roots_of_unity[1]);
+    }
+
+    /* The upper half of the monomial form is zero */
+    if (reconstructed_poly_out != NULL) {
+        memcpy(reconstructed_poly_out, poly_coeff, FIELD_ELEMENTS_PER_BLOB * sizeof(fr_t));
+        for (size_t i = FIELD_ELEMENTS_PER_BLOB; i < FIELD_ELEMENTS_PER_EXT_BLOB; i++) {
+            reconstructed_poly_out[i] = FR_ZERO;
+        }
+    }
+
+    /* Evaluate the polynomial over the other half's domain */
+    if (!from_second_half) {
+        shift_poly(poly_coeff, FIELD_ELEMENTS_PER_BLOB, &s->roots_of_unity[1]);
+    }
+    ret = fr_fft(evals, poly_coeff, FIELD_ELEMENTS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+    ret = bit_reversal_permutation(evals, sizeof(fr_t), FIELD_ELEMENTS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Fill in the missing cells of the other half */
+    if (reconstructed_data_out != cells) {
+        memcpy(reconstructed_data_out, cells, FIELD_ELEMENTS_PER_EXT_BLOB * sizeof(fr_t));
+    }
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_BLOB; i += FIELD_ELEMENTS_PER_CELL) {
+        if (fr_is_null(&cells[to + i])) {
+            memcpy(
+                &reconstructed_data_out[to + i], &evals[i], FIELD_ELEMENTS_PER_CELL * sizeof(fr_t)
+            );
+        }
+    }
+
+out:
+    c_kzg_free(evals);
+    c_kzg_free(poly_coeff);
+    return ret;
+}
+
 /**
  * Given a set of cells with up to half the entries missing, return the reconstructed
  * original. Assumes that the inverse FFT of the original data has the upper half of its values
  * equal to zero.
  *
  * @param[out]  reconstructed_data_out  Array of size FIELD_ELEMENTS_PER_EXT_BLOB to recover cells
+ * @param[out]  reconstructed_poly_out  Array of size FIELD_ELEMENTS_PER_EXT_BLOB for the recovered
+ *                                      polynomial in monomial form, or NULL
  * @param[in]   cell_indices            An array with the available cell indices, length `num_cells`
  * @param[in]   num_cells               The size of the `cell_indices` array
  * @param[in]   cells                   An array of size FIELD_ELEMENTS_PER_EXT_BLOB with the cells
@@ -197,9 +287,13 @@ static bool is_in_array(const uint64_t *arr, size_t arr_size, uint64_t value) {
  * @remark `reconstructed_data_out` and `cells` can point to the same memory.
  * @remark The array `cells` must be in the correct order (according to cell_indices).
  * @remark Missing cells in `cells` should be equal to FR_NULL.
+ * @remark If either half of the cells is complete, it is decoded directly instead.
+ * @remark The monomial form is computed along the way, so callers that need it (e.g., to compute
+ * proofs) should ask for it here rather than converting the recovered data back.
  */
 C_KZG_RET recover_cells(
     fr_t *reconstructed_data_out,
+    fr_t *reconstructed_poly_out,
     const uint64_t *cell_indices,
     size_t num_cells,
     fr_t *cells,
@@ -215,6 +309,27 @@ C_KZG_RET recover_cells(
     fr_t *vanishing_poly_over_coset = NULL;
     fr_t *reconstructed_poly_coeff = NULL;
     fr_t *cells_brp = NULL;
+    fr_t *poly_coeff;
+    STATS_TIMER_START(timer);
+    TRACE_PROBE2(recover__start, num_cells, CELLS_PER_EXT_BLOB - num_cells);
+
+    /*
+     * If either half of the extended data is complete, the blob can be decoded directly. These are
+     * the only cosets of the FIELD_ELEMENTS_PER_BLOB roots of unity in the extended domain.
+     */
+    bool have_first_half = true;
+    bool have_second_half = true;
+    for (uint64_t i = 0; i < CELLS_PER_BLOB; i++) {
+        if (!is_in_array(cell_indices, num_cells, i)) have_first_half = false;
+        if (!is_in_array(cell_indices, num_cells, CELLS_PER_BLOB + i)) have_second_half = false;
+    }
+    if (have_first_half || have_second_half) {
+        TRACE_PROBE1(recover__half, (int)!have_first_half);
+        ret = recover_cells_from_half(
+            reconstructed_data_out, reconstructed_poly_out, cells, !have_first_half, s
+        );
+        goto out;
+    }
 
     /* Allocate space for arrays */
     ret = c_kzg_calloc(
@@ -233,8 +348,10 @@ C_KZG_RET recover_cells(
     if (ret != C_KZG_OK) goto out;
     ret = new_fr_array(&vanishing_poly_over_coset, FIELD_ELEMENTS_PER_EXT_BLOB);
     if (ret != C_KZG_OK) goto out;
-    ret = new_fr_array(&reconstructed_poly_coeff, FIELD_ELEMENTS_PER_EXT_BLOB);
-    if (ret != C_KZG_OK) goto out;
+    if (reconstructed_poly_out == NULL) {
+        ret = new_fr_array(&reconstructed_poly_coeff, FIELD_ELEMENTS_PER_EXT_BLOB);
+        if (ret != C_KZG_OK) goto out;
+    }
     ret = new_fr_array(&cells_brp, FIELD_ELEMENTS_PER_EXT_BLOB);
     if (ret != C_KZG_OK) goto out;
 
@@ -343,17 +460,17 @@ C_KZG_RET recover_cells(
      * polynomial as reconstructed_poly_over_coset in the spec.
      */
 
-    /* Convert P(x) to coefficient form */
-    ret = coset_ifft(
-        reconstructed_poly_coeff, extended_evaluations_over_coset, FIELD_ELEMENTS_PER_EXT_BLOB, s
-    );
+    /* Convert P(x) to coefficient form, directly into the caller's array if there is one */
+    poly_coeff = reconstructed_poly_out != NULL ? reconstructed_poly_out
+                                                : reconstructed_poly_coeff;
+    ret = coset_ifft(poly_coeff, extended_evaluations_over_coset, FIELD_ELEMENTS_PER_EXT_BLOB, s);
     if (ret != C_KZG_OK) goto out;
 
     /*
      * After unscaling the reconstructed polynomial, we have P(x) which evaluates to our original
      * data at the roots of unity. Next, we evaluate the polynomial to get the original data.
      */
-    ret = fr_fft(reconstructed_data_out, reconstructed_poly_coeff, FIELD_ELEMENTS_PER_EXT_BLOB, s);
+    ret = fr_fft(reconstructed_data_out, poly_coeff, FIELD_ELEMENTS_PER_EXT_BLOB, s);
     if (ret != C_KZG_OK) goto out;
 
     /* Bit-reverse the recovered data points */
@@ -372,5 +489,7 @@ out:
     c_kzg_free(reconstructed_poly_coeff);
     c_kzg_free(vanishing_poly_coeff);
     c_kzg_free(cells_brp);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_RECOVERY);
+    TRACE_PROBE1(recover__done, (int)ret);
     return ret;
 }
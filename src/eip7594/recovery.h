@@ -30,6 +30,7 @@ extern "C" {
 
 C_KZG_RET recover_cells(
     fr_t *reconstructed_data_out,
+    fr_t *reconstructed_poly_out,
     const uint64_t *cell_indices,
     size_t num_cells,
     fr_t *cells,
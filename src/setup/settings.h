@@ -17,6 +17,7 @@
 #pragma once
 
 #include "common/ec.h"
+#include "common/executor.h"
 #include "common/fr.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,27 +54,46 @@ typedef struct {
      * The array starts and ends with Fr::one().
      */
     fr_t *reverse_roots_of_unity;
+    /**
+     * Powers of the coset shift factor used by coset FFTs during cell recovery.
+     *
+     * The array contains `FIELD_ELEMENTS_PER_EXT_BLOB` elements.
+     */
+    fr_t *coset_shift_powers;
+    /**
+     * Powers of the inverse of the coset shift factor used by coset IFFTs during cell recovery,
+     * each divided by `FIELD_ELEMENTS_PER_EXT_BLOB` so that they also do the IFFT's scaling.
+     *
+     * The array contains `FIELD_ELEMENTS_PER_EXT_BLOB` elements.
+     */
+    fr_t *inv_coset_shift_powers;
     /**
      * G1 group elements from the trusted setup in monomial form.
      * The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements.
+     *
+     * The elements are kept in affine form so that they can be used by MSMs directly.
      */
-    g1_t *g1_values_monomial;
+    blst_p1_affine *g1_values_monomial;
     /**
      * G1 group elements from the trusted setup in Lagrange form and bit-reversed order.
      * The array contains `NUM_G1_POINTS = FIELD_ELEMENTS_PER_BLOB` elements.
+     *
+     * The elements are kept in affine form so that they can be used by MSMs directly.
      */
-    g1_t *g1_values_lagrange_brp;
+    blst_p1_affine *g1_values_lagrange_brp;
     /**
      * G2 group elements from the trusted setup in monomial form.
      * The array contains `NUM_G2_POINTS` elements.
      */
     g2_t *g2_values_monomial;
-    /** Data used during FK20 proof generation. */
-    g1_t **x_ext_fft_columns;
+    /** Data used during FK20 proof generation, in affine form. */
+    blst_p1_affine **x_ext_fft_columns;
     /** The precomputed tables for fixed-base MSM. */
     blst_p1_affine **tables;
     /** The window size for the fixed-base MSM. */
     size_t wbits;
     /** The scratch size for the fixed-base MSM. */
     size_t scratch_size;
+    /** Where independent units of work are run, see set_kzg_executor(). */
+    KZGExecutor executor;
 } KZGSettings;
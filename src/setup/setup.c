@@ -26,6 +26,17 @@
 #include <stdlib.h>   /* For NULL */
 #include <string.h>   /* For memcpy */
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The G1 points of a trusted setup which are still to be decoded. */
+typedef struct {
+    KZGSettings *s;
+    const uint8_t *g1_monomial_bytes;
+    const uint8_t *g1_lagrange_bytes;
+} G1SetupBytes;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Macros
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -123,7 +134,7 @@ static C_KZG_RET expand_root_of_unity(fr_t *out, const fr_t *root, size_t width)
 }
 
 /**
- * Initialize the roots of unity.
+ * Initialize the roots of unity and the powers of the coset shift factor.
  *
  * @param[out]  s   Pointer to KZGSettings
  */
@@ -148,6 +159,11 @@ static C_KZG_RET compute_roots_of_unity(KZGSettings *s) {
         s->reverse_roots_of_unity[i] = s->roots_of_unity[FIELD_ELEMENTS_PER_EXT_BLOB - i];
     }
 
+    /* Populate the powers of the coset shift factor for recovery */
+    compute_coset_shift_powers(
+        s->coset_shift_powers, s->inv_coset_shift_powers, FIELD_ELEMENTS_PER_EXT_BLOB
+    );
+
 out:
     return ret;
 }
@@ -164,6 +180,8 @@ void free_trusted_setup(KZGSettings *s) {
     c_kzg_free(s->brp_roots_of_unity);
     c_kzg_free(s->roots_of_unity);
     c_kzg_free(s->reverse_roots_of_unity);
+    c_kzg_free(s->coset_shift_powers);
+    c_kzg_free(s->inv_coset_shift_powers);
     c_kzg_free(s->g1_values_monomial);
     c_kzg_free(s->g1_values_lagrange_brp);
     c_kzg_free(s->g2_values_monomial);
@@ -189,6 +207,23 @@ void free_trusted_setup(KZGSettings *s) {
     s->scratch_size = 0;
 }
 
+/**
+ * Register an executor on a trusted setup.
+ *
+ * Afterwards, FK20 proof computation (and so cell recovery) and batch verification with `s` hand
+ * independent units of work to `parallel_for`. The results are identical with or without one.
+ *
+ * @param[in,out]   s               The trusted setup
+ * @param[in]       parallel_for    The executor's parallel-for, or NULL to remove the executor
+ * @param[in]       executor_ctx    An opaque pointer which is passed to `parallel_for`
+ *
+ * @remark The executor must not be changed while other threads are using `s`.
+ */
+void set_kzg_executor(KZGSettings *s, kzg_parallel_for_fn parallel_for, void *executor_ctx) {
+    s->executor.parallel_for = parallel_for;
+    s->executor.ctx = executor_ctx;
+}
+
 /**
  * The first part of the Toeplitz matrix multiplication algorithm: the Fourier transform of the
  * vector x extended.
@@ -230,17 +265,98 @@ out:
     return ret;
 }
 
+/**
+ * Compute one row of the FK20 columns, the FFT of an extended section of the g1 values.
+ *
+ * @param[in,out]   ctx     The KZGSettings being initialized
+ * @param[in]       offset  The offset of the section, less than `FIELD_ELEMENTS_PER_CELL`
+ */
+static C_KZG_RET compute_x_ext_fft_row(void *ctx, size_t offset) {
+    C_KZG_RET ret;
+    KZGSettings *s = (KZGSettings *)ctx;
+    g1_t *x = NULL;
+    g1_t *points = NULL;
+    blst_p1_affine *points_affine = NULL;
+    const blst_p1 *p_arg[2];
+    size_t start;
+
+    /*
+     * Note: this constant 2 is not related to `LOG_EXPANSION_FACTOR`.
+     * Instead, it is related to circulant matrices used in FK20, see
+     * Section 2.2 and 3.2 in https://eprint.iacr.org/2023/033.pdf.
+     */
+    size_t circulant_domain_size = 2 * CELLS_PER_BLOB;
+
+    /* Allocate space for arrays */
+    ret = new_g1_array(&x, CELLS_PER_BLOB);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&points, circulant_domain_size);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_affine_array(&points_affine, circulant_domain_size);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Compute x, sections of the g1 values */
+    start = FIELD_ELEMENTS_PER_BLOB - FIELD_ELEMENTS_PER_CELL - 1 - offset;
+    for (size_t i = 0; i < CELLS_PER_BLOB - 1; i++) {
+        size_t j = start - i * FIELD_ELEMENTS_PER_CELL;
+        blst_p1_from_affine(&x[i], &s->g1_values_monomial[j]);
+    }
+    x[CELLS_PER_BLOB - 1] = G1_IDENTITY;
+
+    /* Compute points, the fft of an extended x */
+    ret = toeplitz_part_1(points, x, CELLS_PER_BLOB, s);
+    if (ret != C_KZG_OK) goto out;
+
+    /* Transform the points to affine representation */
+    p_arg[0] = points;
+    p_arg[1] = NULL;
+    blst_p1s_to_affine(points_affine, p_arg, circulant_domain_size);
+
+    /* Reorganize from rows into columns */
+    for (size_t row = 0; row < circulant_domain_size; row++) {
+        s->x_ext_fft_columns[row][offset] = points_affine[row];
+    }
+
+out:
+    c_kzg_free(x);
+    c_kzg_free(points);
+    c_kzg_free(points_affine);
+    return ret;
+}
+
+/**
+ * Compute the table for fixed-base MSM with one of the FK20 columns.
+ *
+ * @param[in,out]   ctx     The KZGSettings being initialized
+ * @param[in]       i       The index of the column
+ */
+static C_KZG_RET compute_fixed_base_table(void *ctx, size_t i) {
+    C_KZG_RET ret;
+    KZGSettings *s = (KZGSettings *)ctx;
+
+    /* The columns are already in affine representation */
+    const blst_p1_affine *points_arg[2] = {s->x_ext_fft_columns[i], NULL};
+
+    /* Allocate space for the table */
+    size_t table_size = blst_p1s_mult_wbits_precompute_sizeof(s->wbits, FIELD_ELEMENTS_PER_CELL);
+    ret = c_kzg_malloc((void **)&s->tables[i], table_size);
+    if (ret != C_KZG_OK) return ret;
+
+    /* Compute table for fixed-base MSM */
+    blst_p1s_mult_wbits_precompute(s->tables[i], s->wbits, points_arg, FIELD_ELEMENTS_PER_CELL);
+    return C_KZG_OK;
+}
+
 /**
  * Initialize fields for FK20 multi-proof computations.
  *
  * @param[out]  s   Pointer to KZGSettings to initialize
+ *
+ * @remark The rows and tables are computed on the executor of `s`, if it has one.
  */
 static C_KZG_RET init_fk20_multi_settings(KZGSettings *s) {
     C_KZG_RET ret;
     size_t circulant_domain_size;
-    g1_t *x = NULL;
-    g1_t *points = NULL;
-    blst_p1_affine *p_affine = NULL;
     bool precompute = s->wbits != 0;
 
     /*
@@ -255,77 +371,32 @@ static C_KZG_RET init_fk20_multi_settings(KZGSettings *s) {
         goto out;
     }
 
-    /* Allocate space for arrays */
-    ret = new_g1_array(&x, CELLS_PER_BLOB);
-    if (ret != C_KZG_OK) goto out;
-    ret = new_g1_array(&points, circulant_domain_size);
-    if (ret != C_KZG_OK) goto out;
-
     /* Allocate space for array of pointers, this is a 2D array */
     ret = c_kzg_calloc((void **)&s->x_ext_fft_columns, circulant_domain_size, sizeof(void *));
     if (ret != C_KZG_OK) goto out;
     for (size_t i = 0; i < circulant_domain_size; i++) {
-        ret = new_g1_array(&s->x_ext_fft_columns[i], FIELD_ELEMENTS_PER_CELL);
+        ret = new_g1_affine_array(&s->x_ext_fft_columns[i], FIELD_ELEMENTS_PER_CELL);
         if (ret != C_KZG_OK) goto out;
     }
 
-    for (size_t offset = 0; offset < FIELD_ELEMENTS_PER_CELL; offset++) {
-        /* Compute x, sections of the g1 values */
-        size_t start = FIELD_ELEMENTS_PER_BLOB - FIELD_ELEMENTS_PER_CELL - 1 - offset;
-        for (size_t i = 0; i < CELLS_PER_BLOB - 1; i++) {
-            size_t j = start - i * FIELD_ELEMENTS_PER_CELL;
-            x[i] = s->g1_values_monomial[j];
-        }
-        x[CELLS_PER_BLOB - 1] = G1_IDENTITY;
-
-        /* Compute points, the fft of an extended x */
-        ret = toeplitz_part_1(points, x, CELLS_PER_BLOB, s);
-        if (ret != C_KZG_OK) goto out;
-
-        /* Reorganize from rows into columns */
-        for (size_t row = 0; row < circulant_domain_size; row++) {
-            s->x_ext_fft_columns[row][offset] = points[row];
-        }
-    }
+    /* Each offset fills in its own row of every column */
+    ret = run_parallel_for(&s->executor, compute_x_ext_fft_row, s, FIELD_ELEMENTS_PER_CELL);
+    if (ret != C_KZG_OK) goto out;
 
     if (precompute) {
         /* Allocate space for precomputed tables */
         ret = c_kzg_calloc((void **)&s->tables, circulant_domain_size, sizeof(void *));
         if (ret != C_KZG_OK) goto out;
 
-        /* Allocate space for points in affine representation */
-        ret = c_kzg_calloc((void **)&p_affine, FIELD_ELEMENTS_PER_CELL, sizeof(blst_p1_affine));
+        /* Compute a table for each column */
+        ret = run_parallel_for(&s->executor, compute_fixed_base_table, s, circulant_domain_size);
         if (ret != C_KZG_OK) goto out;
 
-        /* Calculate the size of each table, this can be re-used */
-        size_t table_size = blst_p1s_mult_wbits_precompute_sizeof(
-            s->wbits, FIELD_ELEMENTS_PER_CELL
-        );
-
-        for (size_t i = 0; i < circulant_domain_size; i++) {
-            /* Transform the points to affine representation */
-            const blst_p1 *p_arg[2] = {s->x_ext_fft_columns[i], NULL};
-            blst_p1s_to_affine(p_affine, p_arg, FIELD_ELEMENTS_PER_CELL);
-            const blst_p1_affine *points_arg[2] = {p_affine, NULL};
-
-            /* Allocate space for the table */
-            ret = c_kzg_malloc((void **)&s->tables[i], table_size);
-            if (ret != C_KZG_OK) goto out;
-
-            /* Compute table for fixed-base MSM */
-            blst_p1s_mult_wbits_precompute(
-                s->tables[i], s->wbits, points_arg, FIELD_ELEMENTS_PER_CELL
-            );
-        }
-
         /* Calculate the size of the scratch */
         s->scratch_size = blst_p1s_mult_wbits_scratch_sizeof(FIELD_ELEMENTS_PER_CELL);
     }
 
 out:
-    c_kzg_free(x);
-    c_kzg_free(points);
-    c_kzg_free(p_affine);
     return ret;
 }
 
@@ -348,15 +419,38 @@ static C_KZG_RET is_trusted_setup_in_lagrange_form(const KZGSettings *s, size_t
      * then the trusted setup was loaded in monomial form.
      * If so, error out since we want the trusted setup in Lagrange form.
      */
+    g1_t g1_setup_0, g1_setup_1;
+    blst_p1_from_affine(&g1_setup_0, &s->g1_values_lagrange_brp[0]);
+    blst_p1_from_affine(&g1_setup_1, &s->g1_values_lagrange_brp[1]);
     bool is_monomial_form = pairings_verify(
-        &s->g1_values_lagrange_brp[1],
-        &s->g2_values_monomial[0],
-        &s->g1_values_lagrange_brp[0],
-        &s->g2_values_monomial[1]
+        &g1_setup_1, &s->g2_values_monomial[0], &g1_setup_0, &s->g2_values_monomial[1]
     );
     return is_monomial_form ? C_KZG_BADARGS : C_KZG_OK;
 }
 
+/**
+ * Decode one of the G1 points of a trusted setup.
+ *
+ * @param[in,out]   ctx The G1SetupBytes
+ * @param[in]       i   The index of the point, monomial points first and then Lagrange points
+ */
+static C_KZG_RET decode_g1_setup_point(void *ctx, size_t i) {
+    const G1SetupBytes *setup = (const G1SetupBytes *)ctx;
+    blst_p1_affine *out;
+    const uint8_t *in;
+
+    if (i < NUM_G1_POINTS) {
+        out = &setup->s->g1_values_monomial[i];
+        in = &setup->g1_monomial_bytes[BYTES_PER_G1 * i];
+    } else {
+        out = &setup->s->g1_values_lagrange_brp[i - NUM_G1_POINTS];
+        in = &setup->g1_lagrange_bytes[BYTES_PER_G1 * (i - NUM_G1_POINTS)];
+    }
+
+    BLST_ERROR err = blst_p1_uncompress(out, in);
+    return err == BLST_SUCCESS ? C_KZG_OK : C_KZG_BADARGS;
+}
+
 /**
  * Load trusted setup into a KZGSettings.
  *
@@ -370,6 +464,7 @@ static C_KZG_RET is_trusted_setup_in_lagrange_form(const KZGSettings *s, size_t
  * @param[in]   precompute              Configurable value between 0-15
  *
  * @remark Free afterwards use with free_trusted_setup().
+ * @remark See also load_trusted_setup_with_executor().
  */
 C_KZG_RET load_trusted_setup(
     KZGSettings *out,
@@ -380,17 +475,65 @@ C_KZG_RET load_trusted_setup(
     const uint8_t *g2_monomial_bytes,
     uint64_t num_g2_monomial_bytes,
     uint64_t precompute
+) {
+    return load_trusted_setup_with_executor(
+        out,
+        g1_monomial_bytes,
+        num_g1_monomial_bytes,
+        g1_lagrange_bytes,
+        num_g1_lagrange_bytes,
+        g2_monomial_bytes,
+        num_g2_monomial_bytes,
+        precompute,
+        NULL,
+        NULL
+    );
+}
+
+/**
+ * Load trusted setup into a KZGSettings, using an executor for the expensive parts.
+ *
+ * @param[out]  out                     Pointer to the stored trusted setup
+ * @param[in]   g1_monomial_bytes       Array of G1 points in monomial form
+ * @param[in]   num_g1_monomial_bytes   Number of g1 monomial bytes
+ * @param[in]   g1_lagrange_bytes       Array of G1 points in Lagrange form
+ * @param[in]   num_g1_lagrange_bytes   Number of g1 Lagrange bytes
+ * @param[in]   g2_monomial_bytes       Array of G2 points in monomial form
+ * @param[in]   num_g2_monomial_bytes   Number of g2 monomial bytes
+ * @param[in]   precompute              Configurable value between 0-15
+ * @param[in]   parallel_for            The executor's parallel-for, may be NULL
+ * @param[in]   executor_ctx            An opaque pointer which is passed to `parallel_for`
+ *
+ * @remark Free afterwards use with free_trusted_setup().
+ * @remark The executor stays registered on `out` afterwards, see set_kzg_executor().
+ */
+C_KZG_RET load_trusted_setup_with_executor(
+    KZGSettings *out,
+    const uint8_t *g1_monomial_bytes,
+    uint64_t num_g1_monomial_bytes,
+    const uint8_t *g1_lagrange_bytes,
+    uint64_t num_g1_lagrange_bytes,
+    const uint8_t *g2_monomial_bytes,
+    uint64_t num_g2_monomial_bytes,
+    uint64_t precompute,
+    kzg_parallel_for_fn parallel_for,
+    void *executor_ctx
 ) {
     C_KZG_RET ret;
+    G1SetupBytes g1_setup_bytes = {out, g1_monomial_bytes, g1_lagrange_bytes};
 
     out->brp_roots_of_unity = NULL;
     out->roots_of_unity = NULL;
     out->reverse_roots_of_unity = NULL;
+    out->coset_shift_powers = NULL;
+    out->inv_coset_shift_powers = NULL;
     out->g1_values_monomial = NULL;
     out->g1_values_lagrange_brp = NULL;
     out->g2_values_monomial = NULL;
     out->x_ext_fft_columns = NULL;
     out->tables = NULL;
+    out->executor.parallel_for = parallel_for;
+    out->executor.ctx = executor_ctx;
 
     /* It seems that blst limits the input to 15 */
     if (precompute > 15) {
@@ -421,34 +564,22 @@ C_KZG_RET load_trusted_setup(
     if (ret != C_KZG_OK) goto out_error;
     ret = new_fr_array(&out->reverse_roots_of_unity, FIELD_ELEMENTS_PER_EXT_BLOB + 1);
     if (ret != C_KZG_OK) goto out_error;
-    ret = new_g1_array(&out->g1_values_monomial, NUM_G1_POINTS);
+    ret = new_fr_array(&out->coset_shift_powers, FIELD_ELEMENTS_PER_EXT_BLOB);
+    if (ret != C_KZG_OK) goto out_error;
+    ret = new_fr_array(&out->inv_coset_shift_powers, FIELD_ELEMENTS_PER_EXT_BLOB);
     if (ret != C_KZG_OK) goto out_error;
-    ret = new_g1_array(&out->g1_values_lagrange_brp, NUM_G1_POINTS);
+    ret = new_g1_affine_array(&out->g1_values_monomial, NUM_G1_POINTS);
+    if (ret != C_KZG_OK) goto out_error;
+    ret = new_g1_affine_array(&out->g1_values_lagrange_brp, NUM_G1_POINTS);
     if (ret != C_KZG_OK) goto out_error;
     ret = new_g2_array(&out->g2_values_monomial, NUM_G2_POINTS);
     if (ret != C_KZG_OK) goto out_error;
 
-    /* Convert all g1 monomial bytes to g1 points */
-    for (size_t i = 0; i < NUM_G1_POINTS; i++) {
-        blst_p1_affine g1_affine;
-        BLST_ERROR err = blst_p1_uncompress(&g1_affine, &g1_monomial_bytes[BYTES_PER_G1 * i]);
-        if (err != BLST_SUCCESS) {
-            ret = C_KZG_BADARGS;
-            goto out_error;
-        }
-        blst_p1_from_affine(&out->g1_values_monomial[i], &g1_affine);
-    }
-
-    /* Convert all g1 Lagrange bytes to g1 points */
-    for (size_t i = 0; i < NUM_G1_POINTS; i++) {
-        blst_p1_affine g1_affine;
-        BLST_ERROR err = blst_p1_uncompress(&g1_affine, &g1_lagrange_bytes[BYTES_PER_G1 * i]);
-        if (err != BLST_SUCCESS) {
-            ret = C_KZG_BADARGS;
-            goto out_error;
-        }
-        blst_p1_from_affine(&out->g1_values_lagrange_brp[i], &g1_affine);
-    }
+    /* Convert all g1 monomial and Lagrange bytes to g1 points */
+    ret = run_parallel_for(
+        &out->executor, decode_g1_setup_point, &g1_setup_bytes, 2 * NUM_G1_POINTS
+    );
+    if (ret != C_KZG_OK) goto out_error;
 
     /* Convert all g2 bytes to g2 points */
     for (size_t i = 0; i < NUM_G2_POINTS; i++) {
@@ -470,7 +601,9 @@ C_KZG_RET load_trusted_setup(
     if (ret != C_KZG_OK) goto out_error;
 
     /* Bit reverse the Lagrange form points */
-    ret = bit_reversal_permutation(out->g1_values_lagrange_brp, sizeof(g1_t), NUM_G1_POINTS);
+    ret = bit_reversal_permutation(
+        out->g1_values_lagrange_brp, sizeof(blst_p1_affine), NUM_G1_POINTS
+    );
     if (ret != C_KZG_OK) goto out_error;
 
     /* Setup for FK20 proof computation */
@@ -39,10 +39,25 @@ C_KZG_RET load_trusted_setup(
     uint64_t precompute
 );
 
+C_KZG_RET load_trusted_setup_with_executor(
+    KZGSettings *out,
+    const uint8_t *g1_monomial_bytes,
+    uint64_t num_g1_monomial_bytes,
+    const uint8_t *g1_lagrange_bytes,
+    uint64_t num_g1_lagrange_bytes,
+    const uint8_t *g2_monomial_bytes,
+    uint64_t num_g2_monomial_bytes,
+    uint64_t precompute,
+    kzg_parallel_for_fn parallel_for,
+    void *executor_ctx
+);
+
 C_KZG_RET load_trusted_setup_file(KZGSettings *out, FILE *in, uint64_t precompute);
 
 void free_trusted_setup(KZGSettings *s);
 
+void set_kzg_executor(KZGSettings *s, kzg_parallel_for_fn parallel_for, void *executor_ctx);
+
 #ifdef __cplusplus
 }
 #endif
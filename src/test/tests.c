@@ -404,6 +404,189 @@ static void test_pairings_verify__bad_pairing(void) {
     ASSERT("pairings fail", !pairings_verify(&g1, &s1g2, &sg1, &g2));
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for bytes_to_bls_field_array
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_bytes_to_bls_field_array__succeeds_matches_single(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    fr_t fields[FIELD_ELEMENTS_PER_BLOB];
+    fr_t expected;
+    bool ok;
+
+    get_rand_blob(&blob);
+
+    ret = bytes_to_bls_field_array(fields, NULL, blob.bytes, FIELD_ELEMENTS_PER_BLOB);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    for (size_t i = 0; i < FIELD_ELEMENTS_PER_BLOB; i++) {
+        ret = bytes_to_bls_field(
+            &expected, (const Bytes32 *)&blob.bytes[i * BYTES_PER_FIELD_ELEMENT]
+        );
+        ASSERT_EQUALS(ret, C_KZG_OK);
+        ok = fr_equal(&fields[i], &expected);
+        ASSERT_EQUALS(ok, true);
+    }
+}
+
+static void test_bytes_to_bls_field_array__succeeds_lower_limb_greater_than_modulus(void) {
+    C_KZG_RET ret;
+    Bytes32 field_element;
+    fr_t field;
+
+    /* The top limb is less than the modulus, so the larger lower limbs don't matter */
+    bytes32_from_hex(
+        &field_element, "73eda753299d7d473339d80809a1d80553bda402fffe5bfeffffffffffffffff"
+    );
+
+    ret = bytes_to_bls_field_array(&field, NULL, field_element.bytes, 1);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+}
+
+static void test_bytes_to_bls_field_array__fails_reports_first_invalid(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    fr_t fields[FIELD_ELEMENTS_PER_BLOB];
+    Bytes32 modulus;
+    size_t invalid_index = 0;
+
+    bytes32_from_hex(&modulus, "73eda753299d7d483339d80809a1d80553bda402fffe5bfeffffffff00000001");
+
+    /* Make two elements invalid, only the first one should be reported */
+    get_rand_blob(&blob);
+    memcpy(&blob.bytes[1234 * BYTES_PER_FIELD_ELEMENT], modulus.bytes, BYTES_PER_FIELD_ELEMENT);
+    memset(&blob.bytes[2345 * BYTES_PER_FIELD_ELEMENT], 0xff, BYTES_PER_FIELD_ELEMENT);
+
+    ret = bytes_to_bls_field_array(fields, &invalid_index, blob.bytes, FIELD_ELEMENTS_PER_BLOB);
+    ASSERT_EQUALS(ret, C_KZG_BADARGS);
+    ASSERT_EQUALS(invalid_index, 1234);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for sha256
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_sha256__succeeds_expected_digest(void) {
+    Sha256 ctx;
+    Bytes32 digest, expected;
+
+    bytes32_from_hex(&expected, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, "abc", 3);
+    sha256_final(digest.bytes, &ctx);
+    ASSERT_EQUALS(memcmp(digest.bytes, expected.bytes, sizeof(Bytes32)), 0);
+}
+
+static void test_sha256__succeeds_matches_one_shot(void) {
+    Sha256 ctx;
+    Blob blob;
+    Bytes32 digest, expected;
+    const size_t sizes[] = {0, 1, 55, 56, 63, 64, 65, 119, 128, 1000, BYTES_PER_BLOB};
+    const size_t chunks[] = {1, 7, 64, 100};
+
+    get_rand_blob(&blob);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        blst_sha256(expected.bytes, blob.bytes, sizes[i]);
+        for (size_t j = 0; j < sizeof(chunks) / sizeof(chunks[0]); j++) {
+            /* Absorb the data in pieces, which must not change the digest */
+            sha256_init(&ctx);
+            for (size_t offset = 0; offset < sizes[i]; offset += chunks[j]) {
+                size_t size = sizes[i] - offset < chunks[j] ? sizes[i] - offset : chunks[j];
+                sha256_update(&ctx, &blob.bytes[offset], size);
+            }
+            sha256_final(digest.bytes, &ctx);
+            ASSERT_EQUALS(memcmp(digest.bytes, expected.bytes, sizeof(Bytes32)), 0);
+        }
+    }
+}
+
+static void test_sha256_update_many__succeeds_matches_single(void) {
+    Sha256 ctxs[SHA256_LANES + 3];
+    Sha256 ctx;
+    Blob blob;
+    const uint8_t *data[SHA256_LANES + 3];
+    Bytes32 digest, expected;
+
+    /* Each lane gets a different message */
+    get_rand_blob(&blob);
+    for (size_t i = 0; i < SHA256_LANES + 3; i++) {
+        data[i] = &blob.bytes[i * 1031];
+    }
+
+    /* Try every number of lanes, including more than fit in one group */
+    for (size_t n = 1; n <= SHA256_LANES + 3; n++) {
+        /* Start from a partial block, absorb many blocks, and then a partial block again */
+        for (size_t i = 0; i < n; i++) {
+            sha256_init(&ctxs[i]);
+            sha256_update(&ctxs[i], "prefix", 6);
+        }
+        sha256_update_many(ctxs, data, 1000, n);
+        sha256_update_many(ctxs, data, 30, n);
+
+        for (size_t i = 0; i < n; i++) {
+            sha256_init(&ctx);
+            sha256_update(&ctx, "prefix", 6);
+            sha256_update(&ctx, data[i], 1000);
+            sha256_update(&ctx, data[i], 30);
+            sha256_final(expected.bytes, &ctx);
+            sha256_final(digest.bytes, &ctxs[i]);
+            ASSERT_EQUALS(memcmp(digest.bytes, expected.bytes, sizeof(Bytes32)), 0);
+        }
+    }
+}
+
+static void test_sha256__succeeds_every_compressor(void) {
+    Sha256 ctxs[SHA256_LANES + 1];
+    Sha256 ctx;
+    Blob blob;
+    uint8_t message[6 + 1000];
+    const uint8_t *data[SHA256_LANES + 1];
+    Bytes32 digest, expected;
+    const bool sha_ni[] = {false, true, false, true};
+    const bool avx2[] = {false, false, true, true};
+    const size_t sizes[] = {0, 1, 55, 58, 64, 65, 122, 1000};
+
+    get_rand_blob(&blob);
+    for (size_t i = 0; i < SHA256_LANES + 1; i++) {
+        data[i] = &blob.bytes[i * 1031];
+    }
+
+    for (size_t c = 0; c < sizeof(sha_ni) / sizeof(sha_ni[0]); c++) {
+        /* Skip the compressors this CPU does not have */
+        if (!sha256_use_compressors(sha_ni[c], avx2[c])) continue;
+
+        /* Try fewer lanes than a full group, a full group, and one more */
+        for (size_t n = 1; n <= SHA256_LANES + 1; n++) {
+            for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+                /* The prefix makes the data straddle a block boundary */
+                for (size_t i = 0; i < n; i++) {
+                    sha256_init(&ctxs[i]);
+                    sha256_update(&ctxs[i], "prefix", 6);
+                }
+                sha256_update_many(ctxs, data, sizes[j], n);
+
+                for (size_t i = 0; i < n; i++) {
+                    memcpy(message, "prefix", 6);
+                    memcpy(&message[6], data[i], sizes[j]);
+                    blst_sha256(expected.bytes, message, 6 + sizes[j]);
+                    sha256_final(digest.bytes, &ctxs[i]);
+                    ASSERT_EQUALS(memcmp(digest.bytes, expected.bytes, sizeof(Bytes32)), 0);
+
+                    sha256_init(&ctx);
+                    sha256_update(&ctx, message, 6 + sizes[j]);
+                    sha256_final(digest.bytes, &ctx);
+                    ASSERT_EQUALS(memcmp(digest.bytes, expected.bytes, sizeof(Bytes32)), 0);
+                }
+            }
+        }
+    }
+
+    /* Go back to the fastest compressors this CPU has */
+    sha256_use_compressors(true, true);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests for blob_to_kzg_commitment
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -939,6 +1122,67 @@ static void test_g1_lincomb__verify_consistent(void) {
     ASSERT("pippenger matches naive MSM", blst_p1_is_equal(&out, &check));
 }
 
+static void test_g1_lincomb__affine_consistent(void) {
+    C_KZG_RET ret;
+    g1_t points[128], out, check;
+    blst_p1_affine points_affine[128];
+    fr_t scalars[128];
+
+    for (size_t i = 0; i < 128; i++) {
+        get_rand_fr(&scalars[i]);
+        get_rand_g1(&points[i]);
+        blst_p1_to_affine(&points_affine[i], &points[i]);
+    }
+
+    g1_lincomb_naive(&check, points, scalars, 128);
+
+    ret = g1_lincomb_affine(&out, points_affine, scalars, 128);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("affine pippenger matches naive MSM", blst_p1_is_equal(&out, &check));
+
+    /* Also check the naive path for short inputs */
+    g1_lincomb_naive(&check, points, scalars, 4);
+    ret = g1_lincomb_affine(&out, points_affine, scalars, 4);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("affine naive matches naive MSM", blst_p1_is_equal(&out, &check));
+}
+
+static void test_g1_lincomb__sparse_small_scalars(void) {
+    C_KZG_RET ret;
+    g1_t points[128], out, check;
+    blst_p1_affine points_affine[128];
+    fr_t scalars[128];
+
+    /* Every other scalar is zero and the rest are small, like a zero-padded blob */
+    for (size_t i = 0; i < 128; i++) {
+        if (i % 2 == 0) {
+            scalars[i] = FR_ZERO;
+        } else {
+            fr_from_uint64(&scalars[i], (uint64_t)(i * 1000003 + 17));
+        }
+        get_rand_g1(&points[i]);
+        blst_p1_to_affine(&points_affine[i], &points[i]);
+    }
+
+    g1_lincomb_naive(&check, points, scalars, 128);
+
+    ret = g1_lincomb_fast(&out, points, scalars, 128);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("sparse pippenger matches naive MSM", blst_p1_is_equal(&out, &check));
+
+    ret = g1_lincomb_affine(&out, points_affine, scalars, 128);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("sparse affine pippenger matches naive MSM", blst_p1_is_equal(&out, &check));
+
+    /* All of the scalars are zero */
+    for (size_t i = 0; i < 128; i++) {
+        scalars[i] = FR_ZERO;
+    }
+    ret = g1_lincomb_affine(&out, points_affine, scalars, 128);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("zero scalars give the identity", blst_p1_is_inf(&out));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests for evaluate_polynomial_in_evaluation_form
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1607,6 +1851,65 @@ static void test_verify_kzg_proof_batch__fails_invalid_blob(void) {
     ASSERT_EQUALS(ret, C_KZG_BADARGS);
 }
 
+static void test_verify_blob_kzg_proof_batch_with_report__succeeds_all_valid(void) {
+    C_KZG_RET ret;
+    const size_t n = 5;
+    Blob blobs[n];
+    KZGCommitment commitments[n];
+    KZGProof proofs[n];
+    bool valid[n];
+    bool ok;
+
+    for (size_t i = 0; i < n; i++) {
+        get_rand_blob(&blobs[i]);
+        ret = blob_to_kzg_commitment(&commitments[i], &blobs[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+        ret = compute_blob_kzg_proof(&proofs[i], &blobs[i], &commitments[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+    }
+
+    ret = verify_blob_kzg_proof_batch_with_report(&ok, valid, blobs, commitments, proofs, n, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQUALS(valid[i], true);
+    }
+}
+
+static void test_verify_blob_kzg_proof_batch_with_report__finds_invalid_proofs(void) {
+    C_KZG_RET ret;
+    const size_t n = 7;
+    Blob blobs[n];
+    KZGCommitment commitments[n];
+    KZGProof proofs[n];
+    bool valid[n];
+    bool ok;
+
+    for (size_t i = 0; i < n; i++) {
+        get_rand_blob(&blobs[i]);
+        ret = blob_to_kzg_commitment(&commitments[i], &blobs[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+        ret = compute_blob_kzg_proof(&proofs[i], &blobs[i], &commitments[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+    }
+
+    /* Break two proofs, and make a third one undecodable */
+    proofs[1] = proofs[0];
+    proofs[4] = proofs[5];
+    bytes48_from_hex(
+        &proofs[6],
+        "8123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef0123456789abcdef"
+    );
+
+    ret = verify_blob_kzg_proof_batch_with_report(&ok, valid, blobs, commitments, proofs, n, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, false);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQUALS(valid[i], i != 1 && i != 4 && i != 6);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests for expand_root_of_unity
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1754,6 +2057,29 @@ static void test_coset_fft(void) {
     }
 }
 
+static void test_coset_ifft_shorter_lengths(void) {
+    const size_t lengths[] = {2, 64, 4096};
+    fr_t poly_eval[4096];
+    fr_t poly_coeff[4096];
+    fr_t recovered_poly_coeff[4096];
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t n = lengths[l];
+        for (size_t i = 0; i < n; i++) {
+            get_rand_fr(&poly_coeff[i]);
+        }
+
+        /* The inverse powers are scaled for the full length, check shorter ones still round-trip */
+        coset_fft(poly_eval, poly_coeff, n, &s);
+        coset_ifft(recovered_poly_coeff, poly_eval, n, &s);
+
+        for (size_t i = 0; i < n; i++) {
+            bool ok = fr_equal(&poly_coeff[i], &recovered_poly_coeff[i]);
+            ASSERT_EQUALS(ok, true);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests for deduplicate_commitments
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1884,6 +2210,138 @@ static void test_shift_factors__succeeds(void) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for compute_cells_and_kzg_proofs_for_indices
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void check_compute_cells_and_kzg_proofs_for_indices(
+    const uint64_t *cell_indices, size_t num_cells
+) {
+    C_KZG_RET ret;
+    Blob blob;
+    Cell cells[CELLS_PER_EXT_BLOB], expected_cells[CELLS_PER_EXT_BLOB];
+    KZGProof proofs[CELLS_PER_EXT_BLOB], expected_proofs[CELLS_PER_EXT_BLOB];
+    int diff;
+
+    get_rand_blob(&blob);
+
+    ret = compute_cells_and_kzg_proofs(expected_cells, expected_proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    ret = compute_cells_and_kzg_proofs_for_indices(
+        cells, proofs, cell_indices, num_cells, &blob, &s
+    );
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    for (size_t i = 0; i < num_cells; i++) {
+        diff = memcmp(&cells[i], &expected_cells[cell_indices[i]], sizeof(Cell));
+        ASSERT_EQUALS(diff, 0);
+        diff = memcmp(&proofs[i], &expected_proofs[cell_indices[i]], sizeof(KZGProof));
+        ASSERT_EQUALS(diff, 0);
+    }
+}
+
+static void test_compute_cells_and_kzg_proofs_for_indices__succeeds_few_cells(void) {
+    /* Few enough cells to be computed directly */
+    const uint64_t cell_indices[] = {0, 5, 64, 127, 31};
+    check_compute_cells_and_kzg_proofs_for_indices(cell_indices, 5);
+}
+
+static void test_compute_cells_and_kzg_proofs_for_indices__succeeds_many_cells(void) {
+    /* Enough cells to switch to FK20 */
+    uint64_t cell_indices[40];
+    for (size_t i = 0; i < 40; i++) {
+        cell_indices[i] = (i * 3) % CELLS_PER_EXT_BLOB;
+    }
+    check_compute_cells_and_kzg_proofs_for_indices(cell_indices, 40);
+}
+
+static void test_compute_cells_and_kzg_proofs_for_indices__fails_invalid_index(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    Cell cells[2];
+    KZGProof proofs[2];
+    const uint64_t cell_indices[] = {1, CELLS_PER_EXT_BLOB};
+
+    get_rand_blob(&blob);
+
+    ret = compute_cells_and_kzg_proofs_for_indices(cells, proofs, cell_indices, 2, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_BADARGS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for compute_blob_sidecar
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_compute_blob_sidecar__succeeds_matches_separate_calls(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    KZGCommitment commitment, expected_commitment;
+    KZGProof proof, expected_proof;
+    Cell cells[CELLS_PER_EXT_BLOB], expected_cells[CELLS_PER_EXT_BLOB];
+    KZGProof cell_proofs[CELLS_PER_EXT_BLOB], expected_cell_proofs[CELLS_PER_EXT_BLOB];
+    int diff;
+
+    get_rand_blob(&blob);
+
+    ret = compute_blob_sidecar(&commitment, &proof, cells, cell_proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Compute everything again with the separate functions */
+    ret = blob_to_kzg_commitment(&expected_commitment, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = compute_blob_kzg_proof(&expected_proof, &blob, &expected_commitment, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = compute_cells_and_kzg_proofs(expected_cells, expected_cell_proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    diff = memcmp(&commitment, &expected_commitment, sizeof(KZGCommitment));
+    ASSERT_EQUALS(diff, 0);
+    diff = memcmp(&proof, &expected_proof, sizeof(KZGProof));
+    ASSERT_EQUALS(diff, 0);
+    diff = memcmp(cells, expected_cells, sizeof(cells));
+    ASSERT_EQUALS(diff, 0);
+    diff = memcmp(cell_proofs, expected_cell_proofs, sizeof(cell_proofs));
+    ASSERT_EQUALS(diff, 0);
+}
+
+static void test_compute_blob_sidecar__succeeds_without_cells(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    KZGCommitment commitment, expected_commitment;
+    KZGProof proof, expected_proof;
+    int diff;
+
+    get_rand_blob(&blob);
+
+    ret = compute_blob_sidecar(&commitment, &proof, NULL, NULL, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    ret = blob_to_kzg_commitment(&expected_commitment, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = compute_blob_kzg_proof(&expected_proof, &blob, &expected_commitment, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    diff = memcmp(&commitment, &expected_commitment, sizeof(KZGCommitment));
+    ASSERT_EQUALS(diff, 0);
+    diff = memcmp(&proof, &expected_proof, sizeof(KZGProof));
+    ASSERT_EQUALS(diff, 0);
+}
+
+static void test_compute_blob_sidecar__fails_invalid_blob(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    KZGCommitment commitment;
+    KZGProof proof;
+
+    /* The first field element is larger than the modulus */
+    get_rand_blob(&blob);
+    memset(blob.bytes, 0xff, BYTES_PER_FIELD_ELEMENT);
+
+    ret = compute_blob_sidecar(&commitment, &proof, NULL, NULL, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_BADARGS);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests for recover_cells_and_kzg_proofs
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1928,6 +2386,100 @@ static void test_recover_cells_and_kzg_proofs__succeeds_random_blob(void) {
     }
 }
 
+static void test_recover_cells_and_kzg_proofs__succeeds_complete_half(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    uint64_t cell_indices[CELLS_PER_EXT_BLOB];
+    Cell cells[CELLS_PER_EXT_BLOB];
+    Cell partial_cells[CELLS_PER_EXT_BLOB];
+    Cell recovered_cells[CELLS_PER_EXT_BLOB];
+    KZGProof proofs[CELLS_PER_EXT_BLOB];
+    KZGProof recovered_proofs[CELLS_PER_EXT_BLOB];
+    int diff;
+
+    get_rand_blob(&blob);
+
+    ret = compute_cells_and_kzg_proofs(cells, proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Keep only the parity half, then the data half plus a few parity cells */
+    const size_t firsts[] = {CELLS_PER_BLOB, 0};
+    const size_t counts[] = {CELLS_PER_BLOB, CELLS_PER_BLOB + 5};
+    for (size_t n = 0; n < 2; n++) {
+        for (size_t i = 0; i < counts[n]; i++) {
+            cell_indices[i] = firsts[n] + i;
+            memcpy(&partial_cells[i], &cells[cell_indices[i]], sizeof(Cell));
+        }
+
+        ret = recover_cells_and_kzg_proofs(
+            recovered_cells, recovered_proofs, cell_indices, partial_cells, counts[n], &s
+        );
+        ASSERT_EQUALS(ret, C_KZG_OK);
+
+        for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+            diff = memcmp(&cells[i], &recovered_cells[i], sizeof(Cell));
+            ASSERT_EQUALS(diff, 0);
+            diff = memcmp(&proofs[i], &recovered_proofs[i], sizeof(KZGProof));
+            ASSERT_EQUALS(diff, 0);
+        }
+    }
+}
+
+static void test_recover_cells_and_kzg_proofs_for_indices__succeeds_random_blob(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    const size_t num_partial_cells = CELLS_PER_EXT_BLOB / 2;
+    uint64_t cell_indices[CELLS_PER_EXT_BLOB];
+    uint64_t wanted_cell_indices[CELLS_PER_EXT_BLOB];
+    Cell cells[CELLS_PER_EXT_BLOB];
+    Cell partial_cells[num_partial_cells];
+    Cell recovered_cells[CELLS_PER_EXT_BLOB];
+    KZGProof proofs[CELLS_PER_EXT_BLOB];
+    KZGProof recovered_proofs[CELLS_PER_EXT_BLOB];
+    int diff;
+
+    get_rand_blob(&blob);
+
+    ret = compute_cells_and_kzg_proofs(cells, proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Keep the even cells */
+    for (size_t i = 0; i < num_partial_cells; i++) {
+        cell_indices[i] = i * 2;
+        memcpy(&partial_cells[i], &cells[cell_indices[i]], sizeof(Cell));
+    }
+
+    /* Ask for a few of the odd cells, and then for many of them */
+    const size_t wanted_counts[] = {3, 40};
+    for (size_t n = 0; n < 2; n++) {
+        size_t num_wanted = wanted_counts[n];
+        for (size_t i = 0; i < num_wanted; i++) {
+            wanted_cell_indices[i] = (i * 6 + 1) % CELLS_PER_EXT_BLOB;
+        }
+
+        ret = recover_cells_and_kzg_proofs_for_indices(
+            recovered_cells,
+            recovered_proofs,
+            wanted_cell_indices,
+            num_wanted,
+            cell_indices,
+            partial_cells,
+            num_partial_cells,
+            &s
+        );
+        ASSERT_EQUALS(ret, C_KZG_OK);
+
+        for (size_t i = 0; i < num_wanted; i++) {
+            diff = memcmp(&recovered_cells[i], &cells[wanted_cell_indices[i]], sizeof(Cell));
+            ASSERT_EQUALS(diff, 0);
+            diff = memcmp(
+                &recovered_proofs[i], &proofs[wanted_cell_indices[i]], sizeof(KZGProof)
+            );
+            ASSERT_EQUALS(diff, 0);
+        }
+    }
+}
+
 static void test_compute_vanishing_polynomial_from_roots(void) {
     /*
      * Test case: (x - 2)(x - 3)
@@ -2066,6 +2618,341 @@ static void test_verify_cell_kzg_proof_batch__succeeds_random_blob(void) {
     ASSERT_EQUALS(ret, C_KZG_OK);
 }
 
+static void test_verify_cell_kzg_proof_batch_with_report__finds_invalid_proofs(void) {
+    C_KZG_RET ret;
+    bool ok;
+    const size_t n = 16;
+    Blob blob;
+    KZGCommitment commitment;
+    Bytes48 commitments[CELLS_PER_EXT_BLOB];
+    uint64_t cell_indices[CELLS_PER_EXT_BLOB];
+    Cell cells[CELLS_PER_EXT_BLOB];
+    KZGProof proofs[CELLS_PER_EXT_BLOB];
+    bool valid[CELLS_PER_EXT_BLOB];
+
+    /* Get a random blob */
+    get_rand_blob(&blob);
+
+    /* Get the commitment to the blob */
+    ret = blob_to_kzg_commitment(&commitment, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Compute cells and proofs */
+    ret = compute_cells_and_kzg_proofs(cells, proofs, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Initialize list of commitments & cell indices */
+    for (size_t i = 0; i < CELLS_PER_EXT_BLOB; i++) {
+        memcpy(commitments[i].bytes, &commitment, BYTES_PER_COMMITMENT);
+        cell_indices[i] = i;
+    }
+
+    /* Everything is valid at first */
+    ret = verify_cell_kzg_proof_batch_with_report(
+        &ok, valid, commitments, cell_indices, cells, proofs, n, &s
+    );
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQUALS(valid[i], true);
+    }
+
+    /* Break two proofs, and give a third cell an out-of-range index */
+    proofs[3] = proofs[2];
+    proofs[11] = proofs[12];
+    cell_indices[7] = CELLS_PER_EXT_BLOB;
+
+    ret = verify_cell_kzg_proof_batch_with_report(
+        &ok, valid, commitments, cell_indices, cells, proofs, n, &s
+    );
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, false);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQUALS(valid[i], i != 3 && i != 7 && i != 11);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for kzg_verifier
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* Add a blob proof, a kzg proof, and a batch of cell proofs from three random blobs */
+static void add_rand_proofs_to_verifier(KZGVerifier *v, bool corrupt_cell_proof) {
+    C_KZG_RET ret;
+    const size_t n = 3;
+    Blob blobs[n];
+    KZGCommitment commitments[n];
+    KZGProof blob_proof, kzg_proof;
+    Bytes32 z, y;
+    Bytes48 cell_commitments[CELLS_PER_EXT_BLOB];
+    uint64_t cell_indices[CELLS_PER_EXT_BLOB];
+    Cell cells[CELLS_PER_EXT_BLOB];
+    KZGProof cell_proofs[CELLS_PER_EXT_BLOB];
+
+    for (size_t i = 0; i < n; i++) {
+        get_rand_blob(&blobs[i]);
+        ret = blob_to_kzg_commitment(&commitments[i], &blobs[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+    }
+
+    /* A blob proof for the first blob */
+    ret = compute_blob_kzg_proof(&blob_proof, &blobs[0], &commitments[0], &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_add_blob_kzg_proof(v, &blobs[0], &commitments[0], &blob_proof);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* A kzg proof for the second blob */
+    get_rand_field_element(&z);
+    ret = compute_kzg_proof(&kzg_proof, &y, &blobs[1], &z, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_add_kzg_proof(v, &commitments[1], &z, &y, &kzg_proof);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Every other cell proof for the third blob */
+    ret = compute_cells_and_kzg_proofs(cells, cell_proofs, &blobs[2], &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    for (size_t i = 0; i < CELLS_PER_EXT_BLOB / 2; i++) {
+        cell_commitments[i] = commitments[2];
+        cell_indices[i] = i * 2;
+        memcpy(&cells[i], &cells[i * 2], sizeof(Cell));
+        cell_proofs[i] = cell_proofs[i * 2];
+    }
+    if (corrupt_cell_proof) cell_proofs[1] = cell_proofs[0];
+    ret = kzg_verifier_add_cell_kzg_proof_batch(
+        v, cell_commitments, cell_indices, cells, cell_proofs, CELLS_PER_EXT_BLOB / 2
+    );
+    ASSERT_EQUALS(ret, C_KZG_OK);
+}
+
+static void test_kzg_verifier__succeeds_no_proofs(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    bool ok;
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_finish(&ok, &v);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+}
+
+static void test_kzg_verifier__succeeds_mixed_proofs(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    bool ok;
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    add_rand_proofs_to_verifier(&v, false);
+    add_rand_proofs_to_verifier(&v, false);
+    ASSERT_EQUALS(v.num_openings, 4);
+    ASSERT_EQUALS(v.num_cell_equations, 2);
+
+    ret = kzg_verifier_finish(&ok, &v);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+    ASSERT_EQUALS(v.openings, NULL);
+}
+
+static void test_kzg_verifier__succeeds_blob_batch(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    const size_t n = 4;
+    Blob blobs[n];
+    KZGCommitment commitments[n];
+    KZGProof proofs[n];
+    bool ok;
+
+    for (size_t i = 0; i < n; i++) {
+        get_rand_blob(&blobs[i]);
+        ret = blob_to_kzg_commitment(&commitments[i], &blobs[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+        ret = compute_blob_kzg_proof(&proofs[i], &blobs[i], &commitments[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+    }
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_add_blob_kzg_proof_batch(&v, blobs, commitments, proofs, n);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_finish(&ok, &v);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+}
+
+static void test_kzg_verifier__fails_incorrect_blob_proof(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    Blob blob;
+    KZGCommitment commitment;
+    KZGProof proof;
+    bool ok;
+
+    get_rand_blob(&blob);
+    ret = blob_to_kzg_commitment(&commitment, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+
+    /* Use the commitment as the proof, which is wrong */
+    proof = commitment;
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    add_rand_proofs_to_verifier(&v, false);
+    ret = kzg_verifier_add_blob_kzg_proof(&v, &blob, &commitment, &proof);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_finish(&ok, &v);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, false);
+}
+
+static void test_kzg_verifier__fails_incorrect_cell_proof(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    bool ok;
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    add_rand_proofs_to_verifier(&v, true);
+    ret = kzg_verifier_finish(&ok, &v);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, false);
+}
+
+static void test_kzg_verifier__fails_proof_not_in_g1(void) {
+    C_KZG_RET ret;
+    KZGVerifier v;
+    Bytes32 z, y;
+    Bytes48 commitment, proof;
+
+    get_rand_g1_bytes(&commitment);
+    get_rand_field_element(&z);
+    get_rand_field_element(&y);
+    bytes48_from_hex(
+        &proof,
+        "8123456789abcdef0123456789abcdef0123456789abcdef"
+        "0123456789abcdef0123456789abcdef0123456789abcdef"
+    );
+
+    ret = kzg_verifier_begin(&v, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ret = kzg_verifier_add_kzg_proof(&v, &commitment, &z, &y, &proof);
+    ASSERT_EQUALS(ret, C_KZG_BADARGS);
+    ASSERT_EQUALS(v.num_openings, 0);
+    kzg_verifier_free(&v);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for c_kzg_get_stats
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_c_kzg_get_stats__counts_blob_to_kzg_commitment(void) {
+    C_KZG_RET ret;
+    Blob blob;
+    KZGCommitment c;
+    KZGStats stats;
+
+    get_rand_blob(&blob);
+    c_kzg_reset_stats();
+    ret = blob_to_kzg_commitment(&c, &blob, &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    c_kzg_get_stats(&stats);
+
+#ifdef C_KZG_STATS
+    ASSERT("decoded the blob", stats.calls[C_KZG_PHASE_DECODE] == 1);
+    ASSERT("did an msm", stats.calls[C_KZG_PHASE_MSM] >= 1);
+    ASSERT("did not do a pairing", stats.calls[C_KZG_PHASE_PAIRING] == 0);
+    ASSERT("allocated memory", stats.bytes_allocated > 0);
+
+    /* Resetting clears everything */
+    c_kzg_reset_stats();
+    c_kzg_get_stats(&stats);
+    ASSERT_EQUALS(stats.calls[C_KZG_PHASE_MSM], 0);
+    ASSERT_EQUALS(stats.allocations, 0);
+#else
+    /* Without instrumentation, every value is zero */
+    for (size_t i = 0; i < C_KZG_NUM_PHASES; i++) {
+        ASSERT_EQUALS(stats.calls[i], 0);
+        ASSERT_EQUALS(stats.nanoseconds[i], 0);
+    }
+    ASSERT_EQUALS(stats.allocations, 0);
+    ASSERT_EQUALS(stats.bytes_allocated, 0);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tests for set_kzg_executor
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A serial executor which runs the tasks backwards and counts how many it was given. */
+static void reverse_parallel_for(void *executor_ctx, kzg_task_fn task, void *task_ctx, uint64_t n) {
+    uint64_t *num_tasks = (uint64_t *)executor_ctx;
+    for (uint64_t i = n; i > 0; i--) {
+        task(task_ctx, i - 1);
+    }
+    *num_tasks += n;
+}
+
+static void test_set_kzg_executor__succeeds_same_results(void) {
+    C_KZG_RET ret;
+    Blob blobs[2];
+    Bytes48 commitments[2];
+    Bytes48 proofs[2];
+    Bytes48 swapped_proofs[2];
+    Cell cells[CELLS_PER_EXT_BLOB];
+    KZGProof cell_proofs[CELLS_PER_EXT_BLOB];
+    KZGProof cell_proofs_executor[CELLS_PER_EXT_BLOB];
+    Bytes48 cell_commitments[4];
+    uint64_t cell_indices[4];
+    uint64_t num_tasks = 0;
+    bool ok;
+
+    /*
+     * A shallow copy shares the setup's arrays but has its own executor, so the global settings
+     * never point at this stack frame, even if an assert fails.
+     */
+    KZGSettings s_executor = s;
+
+    for (size_t i = 0; i < 2; i++) {
+        get_rand_blob(&blobs[i]);
+        ret = blob_to_kzg_commitment(&commitments[i], &blobs[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+        ret = compute_blob_kzg_proof(&proofs[i], &blobs[i], &commitments[i], &s);
+        ASSERT_EQUALS(ret, C_KZG_OK);
+    }
+    ret = compute_cells_and_kzg_proofs(cells, cell_proofs, &blobs[0], &s);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    swapped_proofs[0] = proofs[1];
+    swapped_proofs[1] = proofs[0];
+
+    set_kzg_executor(&s_executor, reverse_parallel_for, &num_tasks);
+
+    /* The proofs do not depend on the order the columns are done in */
+    ret = compute_cells_and_kzg_proofs(NULL, cell_proofs_executor, &blobs[0], &s_executor);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT("same proofs", memcmp(cell_proofs, cell_proofs_executor, sizeof(cell_proofs)) == 0);
+
+    /* Both a valid and an invalid batch are still detected */
+    ret = verify_blob_kzg_proof_batch(&ok, blobs, commitments, proofs, 2, &s_executor);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+    ret = verify_blob_kzg_proof_batch(&ok, blobs, commitments, swapped_proofs, 2, &s_executor);
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, false);
+
+    /* The same goes for cells */
+    for (size_t i = 0; i < 4; i++) {
+        cell_commitments[i] = commitments[0];
+        cell_indices[i] = i;
+    }
+    ret = verify_cell_kzg_proof_batch(
+        &ok, cell_commitments, cell_indices, cells, cell_proofs, 4, &s_executor
+    );
+    ASSERT_EQUALS(ret, C_KZG_OK);
+    ASSERT_EQUALS(ok, true);
+
+    ASSERT("used the executor", num_tasks > 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Profiling Functions
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2291,6 +3178,13 @@ int main(void) {
     RUN(test_g1_mul__test_different_bit_lengths);
     RUN(test_pairings_verify__good_pairing);
     RUN(test_pairings_verify__bad_pairing);
+    RUN(test_bytes_to_bls_field_array__succeeds_matches_single);
+    RUN(test_bytes_to_bls_field_array__succeeds_lower_limb_greater_than_modulus);
+    RUN(test_bytes_to_bls_field_array__fails_reports_first_invalid);
+    RUN(test_sha256__succeeds_expected_digest);
+    RUN(test_sha256__succeeds_matches_one_shot);
+    RUN(test_sha256_update_many__succeeds_matches_single);
+    RUN(test_sha256__succeeds_every_compressor);
     RUN(test_blob_to_kzg_commitment__succeeds_x_less_than_modulus);
     RUN(test_blob_to_kzg_commitment__fails_x_equal_to_modulus);
     RUN(test_blob_to_kzg_commitment__fails_x_greater_than_modulus);
@@ -2322,6 +3216,8 @@ int main(void) {
     RUN(test_bit_reversal_permutation__fails_n_is_one);
     RUN(test_compute_powers__succeeds_expected_powers);
     RUN(test_g1_lincomb__verify_consistent);
+    RUN(test_g1_lincomb__affine_consistent);
+    RUN(test_g1_lincomb__sparse_small_scalars);
     RUN(test_evaluate_polynomial_in_evaluation_form__constant_polynomial);
     RUN(test_evaluate_polynomial_in_evaluation_form__constant_polynomial_in_range);
     RUN(test_evaluate_polynomial_in_evaluation_form__random_polynomial);
@@ -2347,22 +3243,42 @@ int main(void) {
     RUN(test_verify_kzg_proof_batch__fails_proof_not_in_g1);
     RUN(test_verify_kzg_proof_batch__fails_commitment_not_in_g1);
     RUN(test_verify_kzg_proof_batch__fails_invalid_blob);
+    RUN(test_verify_blob_kzg_proof_batch_with_report__succeeds_all_valid);
+    RUN(test_verify_blob_kzg_proof_batch_with_report__finds_invalid_proofs);
     RUN(test_expand_root_of_unity__global_matches_expected);
     RUN(test_expand_root_of_unity__succeeds_with_root);
     RUN(test_expand_root_of_unity__fails_not_root_of_unity);
     RUN(test_expand_root_of_unity__fails_wrong_root_of_unity);
     RUN(test_fft);
     RUN(test_coset_fft);
+    RUN(test_coset_ifft_shorter_lengths);
     RUN(test_deduplicate_commitments__one_duplicate);
     RUN(test_deduplicate_commitments__no_duplicates);
     RUN(test_deduplicate_commitments__all_duplicates);
     RUN(test_deduplicate_commitments__no_commitments);
     RUN(test_deduplicate_commitments__one_commitment);
+    RUN(test_compute_cells_and_kzg_proofs_for_indices__succeeds_few_cells);
+    RUN(test_compute_cells_and_kzg_proofs_for_indices__succeeds_many_cells);
+    RUN(test_compute_cells_and_kzg_proofs_for_indices__fails_invalid_index);
+    RUN(test_compute_blob_sidecar__succeeds_matches_separate_calls);
+    RUN(test_compute_blob_sidecar__succeeds_without_cells);
+    RUN(test_compute_blob_sidecar__fails_invalid_blob);
     RUN(test_recover_cells_and_kzg_proofs__succeeds_random_blob);
+    RUN(test_recover_cells_and_kzg_proofs__succeeds_complete_half);
+    RUN(test_recover_cells_and_kzg_proofs_for_indices__succeeds_random_blob);
     RUN(test_shift_factors__succeeds);
     RUN(test_compute_vanishing_polynomial_from_roots);
     RUN(test_vanishing_polynomial_for_missing_cells);
     RUN(test_verify_cell_kzg_proof_batch__succeeds_random_blob);
+    RUN(test_verify_cell_kzg_proof_batch_with_report__finds_invalid_proofs);
+    RUN(test_kzg_verifier__succeeds_no_proofs);
+    RUN(test_kzg_verifier__succeeds_mixed_proofs);
+    RUN(test_kzg_verifier__succeeds_blob_batch);
+    RUN(test_kzg_verifier__fails_incorrect_blob_proof);
+    RUN(test_kzg_verifier__fails_incorrect_cell_proof);
+    RUN(test_kzg_verifier__fails_proof_not_in_g1);
+    RUN(test_c_kzg_get_stats__counts_blob_to_kzg_commitment);
+    RUN(test_set_kzg_executor__succeeds_same_results);
 
     /*
      * These functions are only executed if we're profiling. To me, it makes sense to put these in
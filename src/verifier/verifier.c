@@ -0,0 +1,534 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "verifier/verifier.h"
+#include "common/alloc.h"
+#include "common/bytes.h"
+#include "common/ec.h"
+#include "common/fr.h"
+#include "common/lincomb.h"
+#include "common/stats.h"
+#include "common/utils.h"
+#include "eip4844/eip4844.h"
+#include "eip7594/eip7594.h"
+
+#include <assert.h> /* For assert */
+#include <string.h> /* For memcpy & strlen */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Length of the domain string. */
+#define DOMAIN_STR_LENGTH 16
+
+/** The number of bytes hashed into the transcript for each opening. */
+#define OPENING_INPUT_SIZE (BYTES_PER_COMMITMENT + 2 * BYTES_PER_FIELD_ELEMENT + BYTES_PER_PROOF)
+
+/** The number of bytes hashed into the transcript for each cell equation. */
+#define CELL_EQUATION_INPUT_SIZE (2 * BYTES_PER_PROOF)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** The domain separator for kzg_verifier_finish's random challenge. */
+static const char *RANDOM_CHALLENGE_DOMAIN_KZG_VERIFIER = "RCKZGVERIFIERV1_";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A pending claim that the polynomial committed to by `commitment` evaluates to `y` at `z`. */
+struct KZGOpening {
+    g1_t commitment;
+    fr_t z;
+    fr_t y;
+    g1_t proof;
+};
+
+/** A pending pairing equation `e(lhs, [1]) == e(rhs, [s^n])` from a batch of cell proofs. */
+struct KZGCellEquation {
+    g1_t lhs;
+    g1_t rhs;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Make sure that an array has space for at least `needed` elements.
+ *
+ * The capacity is doubled as necessary, so that adding elements one by one takes amortized
+ * constant time.
+ *
+ * @param[in,out]   array       The array to grow
+ * @param[in,out]   capacity    The number of elements there is space for
+ * @param[in]       count       The number of elements in use
+ * @param[in]       needed      The number of elements there must be space for
+ * @param[in]       size        The size of each element
+ */
+static C_KZG_RET reserve_array(
+    void **array, size_t *capacity, size_t count, size_t needed, size_t size
+) {
+    C_KZG_RET ret;
+    void *grown = NULL;
+    size_t new_capacity = *capacity == 0 ? 8 : *capacity;
+
+    if (needed <= *capacity) return C_KZG_OK;
+
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    ret = c_kzg_calloc(&grown, new_capacity, size);
+    if (ret != C_KZG_OK) return ret;
+    if (count > 0) memcpy(grown, *array, count * size);
+
+    c_kzg_free(*array);
+    *array = grown;
+    *capacity = new_capacity;
+    return C_KZG_OK;
+}
+
+/**
+ * Absorb the serialized form of a check into the verifier's transcript.
+ *
+ * The transcript becomes `sha256(transcript || bytes)`.
+ *
+ * @param[in,out]   v       The verifier
+ * @param[in]       bytes   The serialized check
+ * @param[in]       size    The number of bytes
+ *
+ * @remark `size` must be at most `OPENING_INPUT_SIZE`.
+ */
+static void absorb_into_transcript(KZGVerifier *v, const uint8_t *bytes, size_t size) {
+    uint8_t input[sizeof(Bytes32) + OPENING_INPUT_SIZE];
+    STATS_TIMER_START(timer);
+
+    assert(size <= OPENING_INPUT_SIZE);
+
+    memcpy(input, v->transcript.bytes, sizeof(Bytes32));
+    memcpy(input + sizeof(Bytes32), bytes, size);
+    blst_sha256(v->transcript.bytes, input, sizeof(Bytes32) + size);
+    STATS_TIMER_STOP(timer, C_KZG_PHASE_CHALLENGE);
+}
+
+/**
+ * Queue a KZG opening that has already been decoded.
+ *
+ * @param[in,out]   v                   The verifier
+ * @param[in]       commitment_bytes    The commitment as given by the caller
+ * @param[in]       proof_bytes         The proof as given by the caller
+ * @param[in]       opening             The decoded opening
+ */
+static C_KZG_RET push_opening(
+    KZGVerifier *v,
+    const Bytes48 *commitment_bytes,
+    const Bytes48 *proof_bytes,
+    const KZGOpening *opening
+) {
+    C_KZG_RET ret;
+    uint8_t bytes[OPENING_INPUT_SIZE];
+    uint8_t *offset = bytes;
+
+    ret = reserve_array(
+        (void **)&v->openings,
+        &v->openings_capacity,
+        v->num_openings,
+        v->num_openings + 1,
+        sizeof(KZGOpening)
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    /* The caller's bytes are canonical once decoded, so there is no need to recompress */
+    memcpy(offset, commitment_bytes, BYTES_PER_COMMITMENT);
+    offset += BYTES_PER_COMMITMENT;
+    bytes_from_bls_field((Bytes32 *)offset, &opening->z);
+    offset += BYTES_PER_FIELD_ELEMENT;
+    bytes_from_bls_field((Bytes32 *)offset, &opening->y);
+    offset += BYTES_PER_FIELD_ELEMENT;
+    memcpy(offset, proof_bytes, BYTES_PER_PROOF);
+    offset += BYTES_PER_PROOF;
+    assert(offset == bytes + OPENING_INPUT_SIZE);
+
+    absorb_into_transcript(v, bytes, OPENING_INPUT_SIZE);
+    v->openings[v->num_openings++] = *opening;
+    return C_KZG_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Accumulating Verifier
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Start accumulating checks.
+ *
+ * @param[out]  v   The verifier to initialize
+ * @param[in]   s   The trusted setup
+ *
+ * @remark Every verifier that is started must end with kzg_verifier_finish() or
+ * kzg_verifier_free().
+ */
+C_KZG_RET kzg_verifier_begin(KZGVerifier *v, const KZGSettings *s) {
+    v->s = s;
+    v->openings = NULL;
+    v->num_openings = 0;
+    v->openings_capacity = 0;
+    v->cell_equations = NULL;
+    v->num_cell_equations = 0;
+    v->cell_equations_capacity = 0;
+    memset(v->transcript.bytes, 0, sizeof(Bytes32));
+    return C_KZG_OK;
+}
+
+/**
+ * Add a KZG proof claiming that `p(z) == y`. See verify_kzg_proof().
+ *
+ * @param[in,out]   v                   The verifier
+ * @param[in]       commitment_bytes    The KZG commitment corresponding to poly p(x)
+ * @param[in]       z_bytes             The evaluation point
+ * @param[in]       y_bytes             The claimed evaluation result
+ * @param[in]       proof_bytes         The KZG proof
+ *
+ * @remark If this fails, the verifier is left unchanged.
+ */
+C_KZG_RET kzg_verifier_add_kzg_proof(
+    KZGVerifier *v,
+    const Bytes48 *commitment_bytes,
+    const Bytes32 *z_bytes,
+    const Bytes32 *y_bytes,
+    const Bytes48 *proof_bytes
+) {
+    C_KZG_RET ret;
+    KZGOpening opening;
+
+    /* Convert untrusted inputs to trusted inputs */
+    ret = bytes_to_kzg_commitment(&opening.commitment, commitment_bytes);
+    if (ret != C_KZG_OK) return ret;
+    ret = bytes_to_bls_field(&opening.z, z_bytes);
+    if (ret != C_KZG_OK) return ret;
+    ret = bytes_to_bls_field(&opening.y, y_bytes);
+    if (ret != C_KZG_OK) return ret;
+    ret = bytes_to_kzg_proof(&opening.proof, proof_bytes);
+    if (ret != C_KZG_OK) return ret;
+
+    return push_opening(v, commitment_bytes, proof_bytes, &opening);
+}
+
+/**
+ * Add a blob proof. See verify_blob_kzg_proof().
+ *
+ * @param[in,out]   v                   The verifier
+ * @param[in]       blob                Blob to verify
+ * @param[in]       commitment_bytes    Commitment to verify
+ * @param[in]       proof_bytes         Proof used for verification
+ *
+ * @remark If this fails, the verifier is left unchanged.
+ */
+C_KZG_RET kzg_verifier_add_blob_kzg_proof(
+    KZGVerifier *v, const Blob *blob, const Bytes48 *commitment_bytes, const Bytes48 *proof_bytes
+) {
+    C_KZG_RET ret;
+    KZGOpening opening;
+
+    ret = blob_kzg_proof_to_opening(
+        &opening.commitment,
+        &opening.z,
+        &opening.y,
+        &opening.proof,
+        blob,
+        commitment_bytes,
+        proof_bytes,
+        v->s
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    return push_opening(v, commitment_bytes, proof_bytes, &opening);
+}
+
+/**
+ * Add a list of blob proofs. See verify_blob_kzg_proof_batch().
+ *
+ * @param[in,out]   v                   The verifier
+ * @param[in]       blobs               Array of blobs to verify
+ * @param[in]       commitments_bytes   Array of commitments to verify
+ * @param[in]       proofs_bytes        Array of proofs used for verification
+ * @param[in]       n                   The number of blobs/commitments/proofs
+ *
+ * @remark If this fails, the blobs before the failing one stay in the verifier.
+ */
+C_KZG_RET kzg_verifier_add_blob_kzg_proof_batch(
+    KZGVerifier *v,
+    const Blob *blobs,
+    const Bytes48 *commitments_bytes,
+    const Bytes48 *proofs_bytes,
+    uint64_t n
+) {
+    C_KZG_RET ret;
+
+    /* Reserve space up front so that we do not grow the array for every blob */
+    ret = reserve_array(
+        (void **)&v->openings,
+        &v->openings_capacity,
+        v->num_openings,
+        v->num_openings + n,
+        sizeof(KZGOpening)
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    for (size_t i = 0; i < n; i++) {
+        ret = kzg_verifier_add_blob_kzg_proof(
+            v, &blobs[i], &commitments_bytes[i], &proofs_bytes[i]
+        );
+        if (ret != C_KZG_OK) return ret;
+    }
+
+    return C_KZG_OK;
+}
+
+/**
+ * Add a batch of cell proofs. See verify_cell_kzg_proof_batch().
+ *
+ * The batch is first reduced to a single pairing equation with its own random challenge, exactly
+ * as verify_cell_kzg_proof_batch() would, and only that equation is kept.
+ *
+ * @param[in,out]   v                   The verifier
+ * @param[in]       commitments_bytes   The commitments for the cells, length `num_cells`
+ * @param[in]       cell_indices        The indices for the cells, length `num_cells`
+ * @param[in]       cells               The cells to check, length `num_cells`
+ * @param[in]       proofs_bytes        The proofs for the cells, length `num_cells`
+ * @param[in]       num_cells           The number of cells provided
+ *
+ * @remark If this fails, the verifier is left unchanged.
+ */
+C_KZG_RET kzg_verifier_add_cell_kzg_proof_batch(
+    KZGVerifier *v,
+    const Bytes48 *commitments_bytes,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells
+) {
+    C_KZG_RET ret;
+    KZGCellEquation equation;
+    uint8_t bytes[CELL_EQUATION_INPUT_SIZE];
+
+    /* There is nothing to check for zero cells */
+    if (num_cells == 0) return C_KZG_OK;
+
+    ret = compute_cell_kzg_proof_batch_equation(
+        &equation.lhs,
+        &equation.rhs,
+        commitments_bytes,
+        cell_indices,
+        cells,
+        proofs_bytes,
+        num_cells,
+        v->s
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    ret = reserve_array(
+        (void **)&v->cell_equations,
+        &v->cell_equations_capacity,
+        v->num_cell_equations,
+        v->num_cell_equations + 1,
+        sizeof(KZGCellEquation)
+    );
+    if (ret != C_KZG_OK) return ret;
+
+    bytes_from_g1((Bytes48 *)bytes, &equation.lhs);
+    bytes_from_g1((Bytes48 *)(bytes + BYTES_PER_PROOF), &equation.rhs);
+    absorb_into_transcript(v, bytes, CELL_EQUATION_INPUT_SIZE);
+
+    v->cell_equations[v->num_cell_equations++] = equation;
+    return C_KZG_OK;
+}
+
+/**
+ * Check every accumulated proof at once and release the verifier.
+ *
+ * With `n` openings and `m` cell equations, the checks are weighted by the powers of a random
+ * challenge `r` derived from the transcript, and the verifier tests:
+ *
+ *   e(\sum r^i (C_i - [y_i] + z_i * Proof_i) + \sum r^{n+j} Lhs_j, [1])
+ *     == e(\sum r^i Proof_i, [s]) * e(\sum r^{n+j} Rhs_j, [s^n])
+ *
+ * @param[out]      ok  True if every accumulated proof is valid, otherwise false
+ * @param[in,out]   v   The verifier, which is freed
+ *
+ * @remark This function accepts if no proofs were added.
+ */
+C_KZG_RET kzg_verifier_finish(bool *ok, KZGVerifier *v) {
+    C_KZG_RET ret;
+    uint8_t input[DOMAIN_STR_LENGTH + sizeof(Bytes32) + 2 * sizeof(uint64_t)];
+    uint8_t *offset = input;
+    Bytes32 r_bytes;
+    fr_t r, sum_of_r_times_y = FR_ZERO;
+    g1_t g1s[3];
+    g2_t g2s[3];
+    size_t num_pairings = 0;
+    fr_t *r_powers = NULL;
+    g1_t *points = NULL;
+    fr_t *scalars = NULL;
+    g1_t *commitments, *proofs, *lhs, *rhs;
+    fr_t *r_times_z, *cell_r_powers;
+    size_t n = v->num_openings;
+    size_t m = v->num_cell_equations;
+
+    *ok = false;
+
+    /* Exit early if there is nothing to check */
+    if (n == 0 && m == 0) {
+        *ok = true;
+        ret = C_KZG_OK;
+        goto out;
+    }
+
+    ret = new_fr_array(&r_powers, n + m);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_g1_array(&points, 2 * n + 1 + 2 * m);
+    if (ret != C_KZG_OK) goto out;
+    ret = new_fr_array(&scalars, 2 * n + 1 + m);
+    if (ret != C_KZG_OK) goto out;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Compute the random challenge from the transcript
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /* Ensure that the domain string is the correct length */
+    assert(strlen(RANDOM_CHALLENGE_DOMAIN_KZG_VERIFIER) == DOMAIN_STR_LENGTH);
+
+    STATS_TIMER_START(challenge_timer);
+    memcpy(offset, RANDOM_CHALLENGE_DOMAIN_KZG_VERIFIER, DOMAIN_STR_LENGTH);
+    offset += DOMAIN_STR_LENGTH;
+    memcpy(offset, v->transcript.bytes, sizeof(Bytes32));
+    offset += sizeof(Bytes32);
+    bytes_from_uint64(offset, n);
+    offset += sizeof(uint64_t);
+    bytes_from_uint64(offset, m);
+    offset += sizeof(uint64_t);
+    assert(offset == input + sizeof(input));
+
+    blst_sha256(r_bytes.bytes, input, sizeof(input));
+    hash_to_bls_field(&r, &r_bytes);
+    compute_powers(r_powers, &r, n + m);
+    STATS_TIMER_STOP(challenge_timer, C_KZG_PHASE_CHALLENGE);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Fold everything into at most three pairings
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    /*
+     * Lay out every term so that each side of the equation is a single multi-scalar
+     * multiplication. With `n` openings and `m` cell equations, the points are:
+     *
+     *   [C_0..C_{n-1}, Proof_0..Proof_{n-1}, [1], Lhs_0..Lhs_{m-1}, Rhs_0..Rhs_{m-1}]
+     *
+     * and the scalars for the generator side are:
+     *
+     *   [r^0..r^{n-1}, r^0 z_0..r^{n-1} z_{n-1}, -\sum r^i y_i, r^n..r^{n+m-1}]
+     *
+     * The other two sides reuse slices of these arrays.
+     */
+    commitments = points;
+    proofs = points + n;
+    lhs = points + 2 * n + 1;
+    rhs = lhs + m;
+    r_times_z = scalars + n;
+    cell_r_powers = scalars + 2 * n + 1;
+
+    for (size_t i = 0; i < n; i++) {
+        const KZGOpening *opening = &v->openings[i];
+        fr_t r_times_y;
+
+        commitments[i] = opening->commitment;
+        proofs[i] = opening->proof;
+        scalars[i] = r_powers[i];
+        blst_fr_mul(&r_times_z[i], &r_powers[i], &opening->z);
+
+        /* Accumulate \sum r^i y_i, so that [y] is a single term */
+        blst_fr_mul(&r_times_y, &r_powers[i], &opening->y);
+        blst_fr_add(&sum_of_r_times_y, &sum_of_r_times_y, &r_times_y);
+    }
+
+    /* Subtract [\sum r^i y_i]; with no openings this term is zero and gets filtered out */
+    points[2 * n] = *blst_p1_generator();
+    blst_fr_cneg(&scalars[2 * n], &sum_of_r_times_y, true);
+
+    for (size_t j = 0; j < m; j++) {
+        lhs[j] = v->cell_equations[j].lhs;
+        rhs[j] = v->cell_equations[j].rhs;
+        cell_r_powers[j] = r_powers[n + j];
+    }
+
+    /* Get \sum r^i (C_i - [y_i] + z_i * Proof_i) + \sum r^{n+j} Lhs_j */
+    ret = g1_lincomb_fast(&g1s[0], points, scalars, 2 * n + 1 + m);
+    if (ret != C_KZG_OK) goto out;
+    g2s[0] = *blst_p2_generator();
+    num_pairings++;
+
+    if (n > 0) {
+        /* Get \sum r^i Proof_i */
+        ret = g1_lincomb_fast(&g1s[num_pairings], proofs, scalars, n);
+        if (ret != C_KZG_OK) goto out;
+        g2s[num_pairings] = v->s->g2_values_monomial[1];
+        num_pairings++;
+    }
+
+    if (m > 0) {
+        /* Get \sum r^{n+j} Rhs_j */
+        ret = g1_lincomb_fast(&g1s[num_pairings], rhs, cell_r_powers, m);
+        if (ret != C_KZG_OK) goto out;
+        g2s[num_pairings] = v->s->g2_values_monomial[FIELD_ELEMENTS_PER_CELL];
+        num_pairings++;
+    }
+
+    /* Move the generator pairing to the other side of the equation */
+    blst_p1_cneg(&g1s[0], true);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    // Do the final pairing check
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ret = pairings_product_is_one(ok, g1s, g2s, num_pairings);
+
+out:
+    c_kzg_free(r_powers);
+    c_kzg_free(points);
+    c_kzg_free(scalars);
+    kzg_verifier_free(v);
+    return ret;
+}
+
+/**
+ * Release a verifier without checking it.
+ *
+ * @param[in,out]   v   The verifier to free
+ *
+ * @remark This can be called on a verifier that has already been finished.
+ */
+void kzg_verifier_free(KZGVerifier *v) {
+    if (v == NULL) return;
+    c_kzg_free(v->openings);
+    c_kzg_free(v->cell_equations);
+    v->num_openings = 0;
+    v->openings_capacity = 0;
+    v->num_cell_equations = 0;
+    v->cell_equations_capacity = 0;
+}
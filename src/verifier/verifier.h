@@ -0,0 +1,109 @@
+/*
+ * Copyright 2024 Benjamin Edgington
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/bytes.h"
+#include "common/ret.h"
+#include "eip4844/blob.h"
+#include "eip7594/cell.h"
+#include "setup/settings.h"
+
+#include <stdbool.h> /* For bool */
+#include <stddef.h>  /* For size_t */
+#include <stdint.h>  /* For uint64_t */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A pending KZG opening. The layout is private to verifier.c. */
+typedef struct KZGOpening KZGOpening;
+
+/** A pending pairing equation from a batch of cell proofs. The layout is private to verifier.c. */
+typedef struct KZGCellEquation KZGCellEquation;
+
+/**
+ * Accumulates pairing checks so that they can be verified all at once.
+ *
+ * Pending checks are randomized with Fiat-Shamir challenges and folded into a single product of
+ * three pairings, which is evaluated with one multi-Miller loop and one final exponentiation.
+ */
+typedef struct {
+    /** The trusted setup used for every check. */
+    const KZGSettings *s;
+    /** Pending KZG openings, from single proofs and blob proofs. */
+    KZGOpening *openings;
+    /** The number of pending KZG openings. */
+    size_t num_openings;
+    /** The number of KZG openings there is space for. */
+    size_t openings_capacity;
+    /** Pending pairing equations, one per batch of cell proofs. */
+    KZGCellEquation *cell_equations;
+    /** The number of pending cell equations. */
+    size_t num_cell_equations;
+    /** The number of cell equations there is space for. */
+    size_t cell_equations_capacity;
+    /** A running hash of every check that has been added. */
+    Bytes32 transcript;
+} KZGVerifier;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+C_KZG_RET kzg_verifier_begin(KZGVerifier *v, const KZGSettings *s);
+
+C_KZG_RET kzg_verifier_add_kzg_proof(
+    KZGVerifier *v,
+    const Bytes48 *commitment_bytes,
+    const Bytes32 *z_bytes,
+    const Bytes32 *y_bytes,
+    const Bytes48 *proof_bytes
+);
+
+C_KZG_RET kzg_verifier_add_blob_kzg_proof(
+    KZGVerifier *v, const Blob *blob, const Bytes48 *commitment_bytes, const Bytes48 *proof_bytes
+);
+
+C_KZG_RET kzg_verifier_add_blob_kzg_proof_batch(
+    KZGVerifier *v,
+    const Blob *blobs,
+    const Bytes48 *commitments_bytes,
+    const Bytes48 *proofs_bytes,
+    uint64_t n
+);
+
+C_KZG_RET kzg_verifier_add_cell_kzg_proof_batch(
+    KZGVerifier *v,
+    const Bytes48 *commitments_bytes,
+    const uint64_t *cell_indices,
+    const Cell *cells,
+    const Bytes48 *proofs_bytes,
+    uint64_t num_cells
+);
+
+C_KZG_RET kzg_verifier_finish(bool *ok, KZGVerifier *v);
+
+void kzg_verifier_free(KZGVerifier *v);
+
+#ifdef __cplusplus
+}
+#endif